@@ -6,25 +6,23 @@
 # Frequency of request rate
 # ZipfMandelbrot  S and Q (popularity)
 # Size of cache (max size)
+#
+# Each sweep runs independent simulations in parallel on all local cores (use JOBS to limit),
+# each run in its own directory under simulations/<sweep>/run-NNNN, see simulations/<sweep>/manifest.txt
+# (runs start inside their directories, so input files are passed with absolute paths)
 
+JOBS=${JOBS:-0}
+PROTOCOLS='Betweeness,Probcache,CEE'
+TRACE_DIRS='simulations/agg,simulations/delay,simulations/cs'
+TOPOLOGY="$PWD/src/ndnSIM/examples/topologies/tree_topology.txt"
 
-for protocol in 'Betweeness' 'Probcache' 'CEE'
-do
-  for s in '0.5' '1.2'
-  do
-    for freq in '20' '40' '60' '80' '100'
-    do
-      ./waf --run "scratch/probcache --frequency=$freq --mandelbrot=$s --protocol=$protocol"
-    done
+./waf build || exit 1
 
-    for cachesize in '5' '10' '15' '20' '25'
-    do
-      ./waf --run "scratch/probcache --cachesize=$cachesize --mandelbrot=$s --protocol=$protocol"
-    done
+sweep ()
+{
+  ./waf --run "ndn-sweep --program=build/scratch/probcache --jobs=$JOBS --subdirs=$TRACE_DIRS --output=simulations/$1 --args=--topology=$TOPOLOGY --grid=$2"
+}
 
-    for contents in '50 100 150 200 250'
-    do
-      ./waf --run "scratch/probcache --contents=$contents --mandelbrot=$s --protocol=$protocol"
-    done
-  done
-done
\ No newline at end of file
+sweep frequency "protocol=$PROTOCOLS;mandelbrot=0.5,1.2;frequency=20,40,60,80,100"
+sweep cachesize "protocol=$PROTOCOLS;mandelbrot=0.5,1.2;cachesize=5,10,15,20,25"
+sweep contents  "protocol=$PROTOCOLS;mandelbrot=0.5,1.2;contents=50,100,150,200,250"
@@ -54,6 +54,7 @@ main (int argc, char *argv[])
 	std::string protocol = "Betweeness";
 	std::string mandelbrot = "0.5";
 	std::string contents = "100";
+	std::string topology = "src/ndnSIM/examples/topologies/tree_topology.txt";
 
 	// setting default parameters for PointToPoint links and channels
 	Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("1Mbps"));
@@ -67,6 +68,7 @@ main (int argc, char *argv[])
 	cmd.AddValue("protocol", "Sets the forwarding strategy", protocol);
 	cmd.AddValue("mandelbrot", "Sets the s value for the zipf mandelbrooooo", mandelbrot);
 	cmd.AddValue("contents", "Sets number of contents available at producer", contents);
+	cmd.AddValue("topology", "Path to the topology file", topology);
 	cmd.Parse (argc, argv);
 
 	std::cout << "Running with frequency: " << frequency << std::endl;
@@ -78,7 +80,7 @@ main (int argc, char *argv[])
 
 	// Use topology builder to build tree network topology
     AnnotatedTopologyReader topologyReader ("", 10);
-	topologyReader.SetFileName ("src/ndnSIM/examples/topologies/tree_topology.txt");
+	topologyReader.SetFileName (topology);
 	topologyReader.Read ();
 
 	NodeContainer consumerNodes = topologyReader.GetConsumerNodes();
@@ -27,6 +27,7 @@
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
 #include <math.h>
+#include <algorithm>
 
 
 NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerZipfMandelbrot");
@@ -58,6 +59,13 @@ ConsumerZipfMandelbrot::GetTypeId (void)
                    StringValue ("0.7"),
                    MakeDoubleAccessor (&ConsumerZipfMandelbrot::SetS, &ConsumerZipfMandelbrot::GetS),
                    MakeDoubleChecker<double> ())
+
+    .AddAttribute ("Sampler", "Method to draw content index: Linear (linear scan), BinarySearch, or Alias (alias table)",
+                   EnumValue (SAMPLER_BINARY_SEARCH),
+                   MakeEnumAccessor (&ConsumerZipfMandelbrot::m_sampler),
+                   MakeEnumChecker (SAMPLER_LINEAR, "Linear",
+                                    SAMPLER_BINARY_SEARCH, "BinarySearch",
+                                    SAMPLER_ALIAS, "Alias"))
     ;
 
   return tid;
@@ -68,6 +76,9 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot()
   : m_N (100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q (0.7)
   , m_s (0.7)
+  , m_sampler (SAMPLER_BINARY_SEARCH)
+  , m_samplerReady (false)
+  , m_builtSampler (SAMPLER_BINARY_SEARCH)
   , m_SeqRng (0.0, 1.0)
 {
   // SetNumberOfContents is called by NS-3 object system during the initialization
@@ -81,7 +92,12 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
 {
   m_N = numOfContents;
+  m_samplerReady = false; // tables will be rebuilt on the next draw
+}
 
+void
+ConsumerZipfMandelbrot::BuildSampler ()
+{
   NS_LOG_DEBUG (m_q << " and " << m_s << " and " << m_N);
 
   m_Pcum = std::vector<double> (m_N + 1);
@@ -92,11 +108,62 @@ ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
       m_Pcum[i] = m_Pcum[i-1] + 1.0 / std::pow(i+m_q, m_s);
     }
 
-  for (uint32_t i=1; i<=m_N; i++)
+  if (m_sampler == SAMPLER_ALIAS)
     {
-      m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-      NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+      // Vose's variant of the alias method: column i keeps content i+1 with probability
+      // m_aliasProb[i], otherwise content m_alias[i]+1 is chosen
+      m_aliasProb = std::vector<double> (m_N);
+      m_alias = std::vector<uint32_t> (m_N);
+
+      std::vector<uint32_t> small, large;
+      for (uint32_t i=0; i<m_N; i++)
+        {
+          m_aliasProb[i] = (m_Pcum[i+1] - m_Pcum[i]) / m_Pcum[m_N] * m_N;
+          m_alias[i] = i;
+          if (m_aliasProb[i] < 1.0)
+            small.push_back (i);
+          else
+            large.push_back (i);
+        }
+
+      while (!small.empty () && !large.empty ())
+        {
+          uint32_t less = small.back ();
+          small.pop_back ();
+          uint32_t more = large.back ();
+
+          m_alias[less] = more;
+          m_aliasProb[more] -= 1.0 - m_aliasProb[less];
+          if (m_aliasProb[more] < 1.0)
+            {
+              large.pop_back ();
+              small.push_back (more);
+            }
+        }
+
+      // leftovers are (up to rounding errors) full columns
+      for (std::vector<uint32_t>::iterator i = small.begin (); i != small.end (); i++)
+        m_aliasProb[*i] = 1.0;
+      for (std::vector<uint32_t>::iterator i = large.begin (); i != large.end (); i++)
+        m_aliasProb[*i] = 1.0;
+
+      // cumulative distribution is not needed for the alias sampler
+      std::vector<double> ().swap (m_Pcum);
+    }
+  else
+    {
+      for (uint32_t i=1; i<=m_N; i++)
+        {
+          m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
+          NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+        }
+
+      std::vector<double> ().swap (m_aliasProb);
+      std::vector<uint32_t> ().swap (m_alias);
+    }
+
+  m_builtSampler = m_sampler;
+  m_samplerReady = true;
 }
 
 uint32_t
@@ -109,7 +176,7 @@ void
 ConsumerZipfMandelbrot::SetQ (double q)
 {
   m_q = q;
-  SetNumberOfContents (m_N);
+  m_samplerReady = false;
 }
 
 double
@@ -122,7 +189,7 @@ void
 ConsumerZipfMandelbrot::SetS (double s)
 {
   m_s = s;
-  SetNumberOfContents (m_N);
+  m_samplerReady = false;
 }
 
 double
@@ -134,6 +201,7 @@ ConsumerZipfMandelbrot::GetS () const
 void
 ConsumerZipfMandelbrot::SendPacket() {
   if (!m_active) return;
+  if (!RunDueRetxCheck (true)) return;
 
   NS_LOG_FUNCTION_NOARGS ();
 
@@ -141,21 +209,14 @@ ConsumerZipfMandelbrot::SendPacket() {
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s max -> " << m_seqMax << "\n";
 
-  while (m_retxSeqs.size ())
+  // the same content can be requested again before the previous request is satisfied, so
+  // requests are tracked individually (by request id), not by the sequence number
+  uint32_t request = m_requests.GetRetxFront ();
+  if (request != RequestTable::NONE)
     {
-      seq = *m_retxSeqs.begin ();
-      m_retxSeqs.erase (m_retxSeqs.begin ());
-
-      // NS_ASSERT (m_seqLifetimes.find (seq) != m_seqLifetimes.end ());
-      // if (m_seqLifetimes.find (seq)->time <= Simulator::Now ())
-      //   {
-
-      //     NS_LOG_DEBUG ("Expire " << seq);
-      //     m_seqLifetimes.erase (seq); // lifetime expired. Trying to find another unexpired sequence number
-      //     continue;
-      //   }
-      NS_LOG_DEBUG("=interest seq "<<seq<<" from m_retxSeqs");
-      break;
+      m_requests.Unqueue (request);
+      seq = m_requests.Get (request).seq;
+      NS_LOG_DEBUG("=interest seq "<<seq<<" from retransmission queue");
     }
 
   if (seq == std::numeric_limits<uint32_t>::max ()) //no retransmission
@@ -170,6 +231,7 @@ ConsumerZipfMandelbrot::SendPacket() {
 
       seq = ConsumerZipfMandelbrot::GetNextSeq();
       m_seq ++;
+      request = m_requests.Insert (seq);
     }
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
@@ -185,17 +247,12 @@ ConsumerZipfMandelbrot::SendPacket() {
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO ("> Interest for " << seq<<", Total: "<<m_seq<<", face: "<<m_face->GetId());
-  NS_LOG_DEBUG ("Trying to add " << seq << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
+  NS_LOG_DEBUG ("Trying to add " << seq << " with " << Simulator::Now () << ". already " << m_requests.GetSize () << " items");
 
-  m_seqTimeouts.insert (SeqTimeout (seq, Simulator::Now ()));
-  m_seqFullDelay.insert (SeqTimeout (seq, Simulator::Now ()));
-
-  m_seqLastDelay.erase (seq);
-  m_seqLastDelay.insert (SeqTimeout (seq, Simulator::Now ()));
-
-  m_seqRetxCounts[seq] ++;
+  m_requests.Sent (request, Simulator::Now ());
 
   m_rtt->SentSeq (SequenceNumber32 (seq), 1);
+  UpdateRetxTimer ();
 
   FwHopCountTag hopCountTag;
   interest->GetPayload ()->AddPacketTag (hopCountTag);
@@ -210,6 +267,11 @@ ConsumerZipfMandelbrot::SendPacket() {
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
+  if (!m_samplerReady || m_builtSampler != m_sampler)
+    {
+      BuildSampler ();
+    }
+
   uint32_t content_index = 1; //[1, m_N]
   double p_sum = 0;
 
@@ -220,15 +282,42 @@ ConsumerZipfMandelbrot::GetNextSeq()
     }
   //if (p_random == 0)
   NS_LOG_LOGIC("p_random="<<p_random);
-  for (uint32_t i=1; i<=m_N; i++)
+
+  switch (m_sampler)
     {
-      p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
-      if (p_random <= p_sum)
+    case SAMPLER_LINEAR:
+      for (uint32_t i=1; i<=m_N; i++)
         {
-          content_index = i;
+          p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
+          if (p_random <= p_sum)
+            {
+              content_index = i;
+              break;
+            } //if
+        } //for
+      break;
+
+    case SAMPLER_BINARY_SEARCH:
+      {
+        // first i in [1, m_N] with p_random <= m_Pcum[i] (same result as the linear scan)
+        std::vector<double>::const_iterator item = std::lower_bound (m_Pcum.begin () + 1, m_Pcum.end (), p_random);
+        if (item != m_Pcum.end ())
+          content_index = item - m_Pcum.begin ();
+        break;
+      }
+
+    case SAMPLER_ALIAS:
+      {
+        if (m_N == 0)
           break;
-        } //if
-    } //for
+
+        double column = p_random * m_N;
+        uint32_t i = std::min (static_cast<uint32_t> (column), m_N - 1);
+        content_index = (column - i < m_aliasProb[i]) ? i + 1 : m_alias[i] + 1;
+        break;
+      }
+    }
+
   //content_index = 1;
   NS_LOG_DEBUG("RandomNumber="<<content_index);
   return content_index;
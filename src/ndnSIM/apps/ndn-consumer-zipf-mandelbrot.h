@@ -31,6 +31,7 @@
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ndn-consumer-cbr.h"
 #include "ns3/random-variable.h"
 
@@ -43,6 +44,13 @@ namespace ndn {
  *
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution: http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * Content index is drawn using one of the samplers, selected by the "Sampler" attribute:
+ * - "BinarySearch" (default): O(log N) binary search over the cumulative distribution
+ * - "Alias": O(1) draws using Walker's alias table (draws differ from the other samplers)
+ * - "Linear": O(N) linear scan over the cumulative distribution (same draws as "BinarySearch")
+ *
+ * Sampler tables are built once, on the first draw after any of the parameters changed.
  */
 class ConsumerZipfMandelbrot: public ConsumerCbr
 {
@@ -57,6 +65,16 @@ public:
   ConsumerZipfMandelbrot ();
   virtual ~ConsumerZipfMandelbrot ();
 
+  /**
+   * @brief Types of Zipf-Mandelbrot samplers
+   */
+  enum SamplerType
+    {
+      SAMPLER_LINEAR,
+      SAMPLER_BINARY_SEARCH,
+      SAMPLER_ALIAS
+    };
+
   virtual void SendPacket();
   uint32_t GetNextSeq();
 
@@ -83,12 +101,24 @@ private:
   double
   GetS () const;
 
+  /**
+   * @brief Build tables for the configured sampler
+   */
+  void
+  BuildSampler ();
+
 private:
   uint32_t m_N;  //number of the contents
   double m_q;  //q in (k+q)^s
   double m_s;  //s in (k+q)^s
   std::vector<double> m_Pcum;  //cumulative probability
 
+  SamplerType m_sampler;
+  bool m_samplerReady; // tables are built for the current parameters and m_builtSampler
+  SamplerType m_builtSampler;
+  std::vector<double> m_aliasProb;  // probability to keep column i in the alias table
+  std::vector<uint32_t> m_alias;    // alias of column i
+
   UniformVariable m_SeqRng; //RNG
 };
 
@@ -29,6 +29,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
 
 #include "ns3/ndn-app-face.h"
 #include "ns3/ndn-interest.h"
@@ -73,6 +74,14 @@ Consumer::GetTypeId (void)
                    MakeTimeAccessor (&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                    MakeTimeChecker ())
 
+    .AddAttribute ("RetxCheck",
+                   "How retransmission timeouts are checked: Polling (every RetxTimer) or OnDemand "
+                   "(same checks as Polling, but only when the earliest outstanding Interest can time out)",
+                   EnumValue (RETX_CHECK_POLLING),
+                   MakeEnumAccessor (&Consumer::GetRetxCheck, &Consumer::SetRetxCheck),
+                   MakeEnumChecker (RETX_CHECK_POLLING, "Polling",
+                                    RETX_CHECK_ON_DEMAND, "OnDemand"))
+
     .AddTraceSource ("LastRetransmittedInterestDataDelay", "Delay between last retransmitted Interest and received Data",
                      MakeTraceSourceAccessor (&Consumer::m_lastRetransmittedInterestDataDelay))
 
@@ -87,6 +96,7 @@ Consumer::Consumer ()
   : m_rand (0, std::numeric_limits<uint32_t>::max ())
   , m_seq (0)
   , m_seqMax (0) // don't request anything
+  , m_retxCheck (RETX_CHECK_POLLING)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
@@ -97,12 +107,19 @@ void
 Consumer::SetRetxTimer (Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_retxTimerStart = Simulator::Now ();
   if (m_retxEvent.IsRunning ())
     {
       // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
       Simulator::Remove (m_retxEvent); // slower, but better for memory
     }
 
+  if (m_retxCheck == RETX_CHECK_ON_DEMAND)
+    {
+      UpdateRetxTimer ();
+      return;
+    }
+
   // schedule even with new timeout
   m_retxEvent = Simulator::Schedule (m_retxTimer,
                                      &Consumer::CheckRetxTimeout, this);
@@ -114,6 +131,83 @@ Consumer::GetRetxTimer () const
   return m_retxTimer;
 }
 
+void
+Consumer::SetRetxCheck (RetxCheckType retxCheck)
+{
+  m_retxCheck = retxCheck;
+  SetRetxTimer (m_retxTimer);
+}
+
+Consumer::RetxCheckType
+Consumer::GetRetxCheck () const
+{
+  return m_retxCheck;
+}
+
+void
+Consumer::UpdateRetxTimer ()
+{
+  if (m_retxCheck != RETX_CHECK_ON_DEMAND)
+    return;
+
+  uint32_t request = m_requests.GetTimeoutFront ();
+  if (request == RequestTable::NONE)
+    {
+      Simulator::Remove (m_retxEvent);
+      return;
+    }
+
+  // Deadline of the earliest outstanding Interest, rounded up to the first periodic check
+  // (m_retxTimerStart + k * m_retxTimer) that has not run yet, i.e., when polling would detect the timeout
+  Time now = Simulator::Now ();
+  Time timeout = std::max (m_requests.Get (request).lastSent + m_rtt->RetransmitTimeout (), now + TimeStep (1));
+  int64_t period = m_retxTimer.GetTimeStep ();
+  int64_t check = timeout.GetTimeStep ();
+  if (period > 0)
+    {
+      int64_t periods = std::max<int64_t> ((check - m_retxTimerStart.GetTimeStep () + period - 1) / period, 1);
+      check = m_retxTimerStart.GetTimeStep () + periods * period;
+    }
+
+  if (m_retxEvent.IsRunning () && m_retxEvent.GetTs () <= static_cast<uint64_t> (check))
+    return; // an earlier check finds no timeouts, as the periodic one would, and moves the timer when it runs
+
+  Simulator::Remove (m_retxEvent);
+  m_retxEvent = Simulator::Schedule (TimeStep (check) - now,
+                                     &Consumer::CheckRetxTimeout, this);
+}
+
+bool
+Consumer::RunDueRetxCheck (bool sending/* = false*/)
+{
+  if (!m_retxEvent.IsRunning () ||
+      m_retxEvent.GetTs () != static_cast<uint64_t> (Simulator::Now ().GetTimeStep ()))
+    return true;
+
+  Simulator::Remove (m_retxEvent);
+  if (!sending)
+    {
+      CheckRetxTimeout ();
+      return true;
+    }
+
+  // Had the check run first, sending would still be pending and timeouts could reschedule it
+  // (ScheduleNextPacket).  Keep a pending placeholder in m_sendEvent while the check runs
+  EventId placeholder = Simulator::ScheduleNow (&Consumer::SendPlaceholder);
+  m_sendEvent = placeholder;
+
+  CheckRetxTimeout ();
+
+  bool pending = m_sendEvent.GetUid () == placeholder.GetUid () && m_sendEvent.IsRunning ();
+  Simulator::Remove (placeholder);
+  return pending; // otherwise, sending was rescheduled or cancelled
+}
+
+void
+Consumer::SendPlaceholder ()
+{
+}
+
 void
 Consumer::CheckRetxTimeout ()
 {
@@ -122,20 +216,24 @@ Consumer::CheckRetxTimeout ()
   Time rto = m_rtt->RetransmitTimeout ();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty ())
+  while (m_requests.GetTimeoutFront () != RequestTable::NONE)
     {
-      SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-        m_seqTimeouts.get<i_timestamp> ().begin ();
-      if (entry->time + rto <= now) // timeout expired?
+      uint32_t request = m_requests.GetTimeoutFront ();
+      if (m_requests.Get (request).lastSent + rto <= now) // timeout expired?
         {
-          uint32_t seqNo = entry->seq;
-          m_seqTimeouts.get<i_timestamp> ().erase (entry);
-          OnTimeout (seqNo);
+          m_requests.ScheduleRetx (request);
+          OnTimeout (m_requests.Get (request).seq);
         }
       else
         break; // nothing else to do. All later packets need not be retransmitted
     }
 
+  if (m_retxCheck == RETX_CHECK_ON_DEMAND)
+    {
+      UpdateRetxTimer ();
+      return;
+    }
+
   m_retxEvent = Simulator::Schedule (m_retxTimer,
                                      &Consumer::CheckRetxTimeout, this);
 }
@@ -168,16 +266,17 @@ void
 Consumer::SendPacket ()
 {
   if (!m_active) return;
+  if (!RunDueRetxCheck (true)) return;
 
   NS_LOG_FUNCTION_NOARGS ();
 
   uint32_t seq=std::numeric_limits<uint32_t>::max (); //invalid
 
-  while (m_retxSeqs.size ())
+  uint32_t request = m_requests.GetRetxFront ();
+  if (request != RequestTable::NONE)
     {
-      seq = *m_retxSeqs.begin ();
-      m_retxSeqs.erase (m_retxSeqs.begin ());
-      break;
+      m_requests.Unqueue (request);
+      seq = m_requests.Get (request).seq;
     }
 
   if (seq == std::numeric_limits<uint32_t>::max ())
@@ -226,6 +325,7 @@ void
 Consumer::OnData (Ptr<const Data> data)
 {
   if (!m_active) return;
+  RunDueRetxCheck ();
 
   App::OnData (data); // tracing inside
 
@@ -238,37 +338,41 @@ Consumer::OnData (Ptr<const Data> data)
 
   int hopCount = -1;
   FwHopCountTag hopCountTag;
-  if (data->GetPayload ()->PeekPacketTag (hopCountTag))
+  if (data->PeekHopCountTag (hopCountTag))
     {
+      // Data from the local content store (tags of the cached payload belong to earlier transmissions)
       hopCount = hopCountTag.Get ();
     }
-
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find (seq);
-  if (entry != m_seqLastDelay.end ())
+  else if (!data->IsOverlay () && data->GetPayload ()->PeekPacketTag (hopCountTag))
     {
-      m_lastRetransmittedInterestDataDelay (this, seq, Simulator::Now () - entry->time, hopCount);
+      hopCount = hopCountTag.Get ();
     }
 
-  entry = m_seqFullDelay.find (seq);
-  if (entry != m_seqFullDelay.end ())
+  // Data satisfies all outstanding requests for the sequence number
+  uint32_t request = m_requests.Find (seq);
+  while (request != RequestTable::NONE)
     {
-      m_firstInterestDataDelay (this, seq, Simulator::Now () - entry->time, m_seqRetxCounts[seq], hopCount);
-    }
-
-  m_seqRetxCounts.erase (seq);
-  m_seqFullDelay.erase (seq);
-  m_seqLastDelay.erase (seq);
+      const RequestTable::Request &record = m_requests.Get (request);
+      if (record.sendCount > 0)
+        {
+          m_lastRetransmittedInterestDataDelay (this, seq, Simulator::Now () - record.lastSent, hopCount);
+          m_firstInterestDataDelay (this, seq, Simulator::Now () - record.firstSent, record.sendCount, hopCount);
+        }
 
-  m_seqTimeouts.erase (seq);
-  m_retxSeqs.erase (seq);
+      uint32_t next = record.nextSameSeq;
+      m_requests.Erase (request);
+      request = next;
+    }
 
   m_rtt->AckSeq (SequenceNumber32 (seq));
+  UpdateRetxTimer ();
 }
 
 void
 Consumer::OnNack (Ptr<const Interest> interest)
 {
   if (!m_active) return;
+  RunDueRetxCheck ();
 
   App::OnNack (interest); // tracing inside
 
@@ -281,14 +385,22 @@ Consumer::OnNack (Ptr<const Interest> interest)
   NS_LOG_INFO ("< NACK for " << seq);
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << "NACK for " << seq << "\n";
 
-  // put in the queue of interests to be retransmitted
-  // NS_LOG_INFO ("Before: " << m_retxSeqs.size ());
-  m_retxSeqs.insert (seq);
-  // NS_LOG_INFO ("After: " << m_retxSeqs.size ());
-
-  m_seqTimeouts.erase (seq);
+  // put in the queue of interests to be retransmitted (the oldest request that waits for Data)
+  uint32_t request = m_requests.Find (seq);
+  while (request != RequestTable::NONE && m_requests.GetQueue (request) != RequestTable::QUEUE_TIMEOUT)
+    {
+      request = m_requests.Get (request).nextSameSeq;
+    }
+  if (request == RequestTable::NONE)
+    {
+      request = m_requests.Find (seq);
+      if (request == RequestTable::NONE)
+        request = m_requests.Insert (seq);
+    }
+  m_requests.ScheduleRetx (request);
 
   m_rtt->IncreaseMultiplier ();             // Double the next RTO ??
+  UpdateRetxTimer ();
   ScheduleNextPacket ();
 }
 
@@ -300,24 +412,21 @@ Consumer::OnTimeout (uint32_t sequenceNumber)
 
   m_rtt->IncreaseMultiplier ();             // Double the next RTO
   m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1); // make sure to disable RTT calculation for this sample
-  m_retxSeqs.insert (sequenceNumber);
   ScheduleNextPacket ();
 }
 
 void
 Consumer::WillSendOutInterest (uint32_t sequenceNumber)
 {
-  NS_LOG_DEBUG ("Trying to add " << sequenceNumber << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
-
-  m_seqTimeouts.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
-  m_seqFullDelay.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
-
-  m_seqLastDelay.erase (sequenceNumber);
-  m_seqLastDelay.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
+  NS_LOG_DEBUG ("Trying to add " << sequenceNumber << " with " << Simulator::Now () << ". already " << m_requests.GetSize () << " items");
 
-  m_seqRetxCounts[sequenceNumber] ++;
+  uint32_t request = m_requests.Find (sequenceNumber);
+  if (request == RequestTable::NONE)
+    request = m_requests.Insert (sequenceNumber);
+  m_requests.Sent (request, Simulator::Now ());
 
   m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1);
+  UpdateRetxTimer ();
 }
 
 
@@ -28,14 +28,7 @@
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
 #include "ns3/ndn-rtt-estimator.h"
-
-#include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include "ns3/ndn-request-table.h"
 
 namespace ns3 {
 namespace ndn {
@@ -49,6 +42,15 @@ class Consumer: public App
 public:
   static TypeId GetTypeId ();
 
+  /**
+   * @brief How retransmission timeouts are checked
+   */
+  enum RetxCheckType
+    {
+      RETX_CHECK_POLLING,  ///< @brief check every RetxTimer
+      RETX_CHECK_ON_DEMAND ///< @brief check only when the earliest outstanding Interest can time out
+    };
+
   /**
    * \brief Default constructor
    * Sets up randomizer function and packet sequence number
@@ -69,6 +71,8 @@ public:
   /**
    * @brief Timeout event
    * @param sequenceNumber time outed sequence number
+   *
+   * When the event is fired, the request is already placed in the retransmission queue
    */
   virtual void
   OnTimeout (uint32_t sequenceNumber);
@@ -123,6 +127,51 @@ protected:
   Time
   GetRetxTimer () const;
 
+  /**
+   * \brief Select how retransmission timeouts are checked
+   *
+   * With RETX_CHECK_ON_DEMAND, a single check is scheduled for the deadline of the earliest
+   * outstanding Interest (with the current RTO), rounded up to the time of the periodic check
+   * (every RetxTimer) that would detect the timeout.  It is moved earlier when the earliest Interest
+   * or RTO changes; if the deadline moves later, the check runs as scheduled (finding nothing, as the
+   * periodic one would) and moves itself.  No check is scheduled while there are no outstanding
+   * Interests.  Retransmissions are the same as with RETX_CHECK_POLLING (see RunDueRetxCheck).
+   */
+  void
+  SetRetxCheck (RetxCheckType retxCheck);
+
+  /**
+   * \brief Get how retransmission timeouts are checked
+   */
+  RetxCheckType
+  GetRetxCheck () const;
+
+  /**
+   * \brief Reschedule on-demand retransmission check after the earliest outstanding Interest or RTO changed
+   *
+   * Does nothing with periodic checks
+   */
+  void
+  UpdateRetxTimer ();
+
+  /**
+   * \brief Run retransmission check scheduled for the current time, if it has not run yet
+   *
+   * Consumer calls it before sending and before processing Data or NACK, so the check for a given time
+   * happens before everything else the consumer does at that time, independent of the order in which
+   * the events were scheduled.  This way periodic and on-demand checks detect the same timeouts.
+   *
+   * \param sending true if called from SendPacket.  In that case, timeouts processed by the check can
+   *                reschedule sending (ScheduleNextPacket) as if the check ran before SendPacket
+   * \returns false if SendPacket should return, because sending was rescheduled or cancelled
+   */
+  bool
+  RunDueRetxCheck (bool sending = false);
+
+private:
+  static void
+  SendPlaceholder ();
+
 protected:
   UniformVariable m_rand; ///< @brief nonce generator
 
@@ -131,6 +180,8 @@ protected:
   EventId         m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time            m_retxTimer; ///< @brief Currently estimated retransmission timer
   EventId         m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  RetxCheckType   m_retxCheck; ///< @brief How retransmission timeouts are checked
+  Time            m_retxTimerStart; ///< @brief Time when periodic retransmission checks started
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
 
@@ -138,57 +189,9 @@ protected:
   Name     m_interestName;        ///< \brief NDN Name of the Interest (use Name)
   Time               m_interestLifeTime;    ///< \brief LifeTime for interest packet
 
-/// @cond include_hidden
-  /**
-   * \struct This struct contains sequence numbers of packets to be retransmitted
-   */
-  struct RetxSeqsContainer :
-    public std::set<uint32_t> { };
-
-  RetxSeqsContainer m_retxSeqs;             ///< \brief ordered set of sequence numbers to be retransmitted
-
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout
-  {
-    SeqTimeout (uint32_t _seq, Time _time) : seq (_seq), time (_time) { }
-
-    uint32_t seq;
-    Time time;
-  };
-/// @endcond
-
-/// @cond include_hidden
-  class i_seq { };
-  class i_timestamp { };
-/// @endcond
+  RequestTable m_requests; ///< @brief outstanding requests (timeouts, pending retransmissions, and delays)
 
 /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer :
-    public boost::multi_index::multi_index_container<
-    SeqTimeout,
-    boost::multi_index::indexed_by<
-      boost::multi_index::ordered_unique<
-        boost::multi_index::tag<i_seq>,
-        boost::multi_index::member<SeqTimeout, uint32_t, &SeqTimeout::seq>
-        >,
-      boost::multi_index::ordered_non_unique<
-        boost::multi_index::tag<i_timestamp>,
-        boost::multi_index::member<SeqTimeout, Time, &SeqTimeout::time>
-        >
-      >
-    > { } ;
-
-  SeqTimeoutsContainer m_seqTimeouts;       ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
-
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */,
                  Time /* delay */, int32_t /*hop count*/> m_lastRetransmittedInterestDataDelay;
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */,
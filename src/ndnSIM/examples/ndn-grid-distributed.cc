@@ -0,0 +1,147 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+// ndn-grid-distributed.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+using namespace ns3;
+
+/**
+ * This scenario simulates the same grid topology as ndn-grid.cc, but using the distributed
+ * (MPI) simulator.  Columns of the grid are split between the ranks (logical processes):
+ *
+ *   rank 0      rank 1      rank 2
+ *
+ * (consumer) -- ( ) ----- ( )
+ *     |          |         |
+ *    ( ) ------ ( ) ----- ( )
+ *     |          |         |
+ *    ( ) ------ ( ) -- (producer)
+ *
+ * All links are 1Mbps with propagation 10ms delay.  Links between nodes on different ranks
+ * carry NDN packets between the processes.
+ *
+ * FIB is populated using NdnGlobalRoutingHelper on every rank.
+ *
+ * Consumer requests data from producer with frequency 100 interests per second
+ * (interests contain constantly increasing sequence number).
+ *
+ * For every received interest, producer replies with a data packet, containing
+ * 1024 bytes of virtual payload.
+ *
+ * Every rank writes rates of its nodes into a separate file (rate-trace-rank<N>.txt)
+ *
+ * To run scenario on 3 ranks, use the following command (ns-3 should be configured with --enable-mpi):
+ *
+ *     mpirun -np 3 ./waf --run=ndn-grid-distributed
+ */
+
+int
+main (int argc, char *argv[])
+{
+#ifdef NS3_MPI
+  // Setting default parameters for PointToPoint links and channels
+  Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("1Mbps"));
+  Config::SetDefault ("ns3::PointToPointChannel::Delay", StringValue ("10ms"));
+  Config::SetDefault ("ns3::DropTailQueue::MaxPackets", StringValue ("10"));
+
+  CommandLine cmd;
+  cmd.Parse (argc, argv);
+
+  // Distributed simulation setup
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+  MpiInterface::Enable (&argc, &argv);
+
+  const uint32_t size = 3;
+  uint32_t systemCount = MpiInterface::GetSize ();
+
+  // Creating 3x3 topology (the same on every rank)
+  std::vector<NodeContainer> grid (size);
+  for (uint32_t row = 0; row < size; row++)
+    {
+      for (uint32_t column = 0; column < size; column++)
+        {
+          grid[row].Add (CreateObject<Node> (column * systemCount / size));
+        }
+    }
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < size; row++)
+    {
+      for (uint32_t column = 0; column < size; column++)
+        {
+          if (column + 1 < size)
+            p2p.Install (grid[row].Get (column), grid[row].Get (column + 1));
+          if (row + 1 < size)
+            p2p.Install (grid[row].Get (column), grid[row + 1].Get (column));
+        }
+    }
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  ndnHelper.InstallAll ();
+
+  // Installing global routing interface on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+
+  // Getting containers for the consumer/producer
+  Ptr<Node> producer = grid[size - 1].Get (size - 1);
+  Ptr<Node> consumer = grid[0].Get (0);
+
+  // Install NDN applications (only on the rank that simulates the node)
+  std::string prefix = "/prefix";
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix (prefix);
+  consumerHelper.SetAttribute ("Frequency", StringValue ("100")); // 100 interests a second
+  consumerHelper.Install (consumer);
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix (prefix);
+  producerHelper.SetAttribute ("PayloadSize", StringValue("1024"));
+  producerHelper.Install (producer);
+
+  // Add /prefix origins to ndn::GlobalRouter
+  ndnGlobalRoutingHelper.AddOrigins (prefix, producer);
+
+  // Calculate and install FIBs
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+
+  ndn::L3RateTracer::InstallAll ("rate-trace.txt", Seconds (1.0));
+
+  Simulator::Stop (Seconds (20.0));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  MpiInterface::Disable ();
+  return 0;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
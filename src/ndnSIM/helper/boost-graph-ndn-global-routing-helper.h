@@ -27,6 +27,8 @@
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/properties.hpp>
 #include <boost/ref.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "ns3/ndn-face.h"
 #include "ns3/ndn-limits.h"
@@ -35,6 +37,7 @@
 #include "../model/ndn-global-router.h"
 #include <list>
 #include <map>
+#include <algorithm>
 
 namespace boost {
 
@@ -60,6 +63,20 @@ public:
 	if (gr != 0)
 	  m_vertices.push_back (gr);
       }
+
+    // GlobalRouter::GetId () is unique within the process, but dense vertex indices are required
+    // (e.g., for color and heap index maps of dijkstra_shortest_paths)
+    uint32_t index = 0;
+    for (std::list< Vertice >::const_iterator vertex = m_vertices.begin (); vertex != m_vertices.end (); vertex++)
+      {
+        m_indices[ns3::PeekPointer (*vertex)] = index++;
+      }
+  }
+
+  uint32_t
+  GetIndex (const Vertice &vertex) const
+  {
+    return m_indices.find (ns3::PeekPointer (vertex))->second;
   }
 
   const std::list< Vertice > &
@@ -70,9 +87,22 @@ public:
   
 public:
   std::list< Vertice > m_vertices;
+  boost::unordered_map< ns3::ndn::GlobalRouter*, uint32_t > m_indices;
 };
 
 
+/**
+ * @brief Predicate to skip edges, which faces are down (e.g., failed using LinkControlHelper)
+ */
+struct IncidencyIsUp
+{
+  bool
+  operator () (const ns3::ndn::GlobalRouter::Incidency &edge) const
+  {
+    return edge.get<1> () == 0 || edge.get<1> ()->IsUp ();
+  }
+};
+
 class ndn_global_router_graph_category :
     public virtual vertex_list_graph_tag,
     public virtual incidence_graph_tag
@@ -95,7 +125,7 @@ struct graph_traits< NdnGlobalRouterGraph >
   typedef size_t vertices_size_type;
 
   // AdjacencyGraph concept
-  typedef ns3::ndn::GlobalRouter::IncidencyList::iterator out_edge_iterator;
+  typedef filter_iterator< IncidencyIsUp, ns3::ndn::GlobalRouter::IncidencyList::iterator > out_edge_iterator;
   typedef size_t degree_size_type;
 
   // typedef size_t edges_size_type;
@@ -147,8 +177,9 @@ out_edges(
 	  graph_traits< NdnGlobalRouterGraph >::vertex_descriptor u, 
 	  const NdnGlobalRouterGraph& g)
 {
-  return std::make_pair(u->GetIncidencies ().begin (),
-			u->GetIncidencies ().end ());
+  typedef graph_traits< NdnGlobalRouterGraph >::out_edge_iterator iterator;
+  return std::make_pair(iterator (IncidencyIsUp (), u->GetIncidencies ().begin (), u->GetIncidencies ().end ()),
+			iterator (IncidencyIsUp (), u->GetIncidencies ().end (), u->GetIncidencies ().end ()));
 }
 
 inline
@@ -157,7 +188,7 @@ out_degree(
 	  graph_traits< NdnGlobalRouterGraph >::vertex_descriptor u, 
 	  const NdnGlobalRouterGraph& g)
 {
-  return u->GetIncidencies ().size ();
+  return std::count_if (u->GetIncidencies ().begin (), u->GetIncidencies ().end (), IncidencyIsUp ());
 }
 
 
@@ -183,6 +214,12 @@ struct VertexIds
   { 
   }
 
+  uint32_t
+  GetIndex (const ns3::Ptr<ns3::ndn::GlobalRouter> &gr) const
+  {
+    return m_graph.GetIndex (gr);
+  }
+
 private:
   const NdnGlobalRouterGraph &m_graph;
 };
@@ -303,9 +340,9 @@ put (reference_wrapper< M > mapp,
 // put (cref< std::map< ns3::Ptr<ns3::ndn::GlobalRouter>, ns3::Ptr<ns3::ndn::GlobalRouter> > > map,
 
 inline uint32_t
-get (const boost::VertexIds&, ns3::Ptr<ns3::ndn::GlobalRouter> &gr)
+get (const boost::VertexIds &ids, ns3::Ptr<ns3::ndn::GlobalRouter> &gr)
 {
-  return gr->GetId ();
+  return ids.GetIndex (gr);
 }
 
 inline property_traits< EdgeWeights >::reference
@@ -341,8 +378,19 @@ struct property_traits< reference_wrapper<PredecessorsMap> >
 };
 
 
+// Order routers by their ids (creation order), which is the same in every run and on every MPI rank
+struct GlobalRouterIdCompare
+{
+  bool
+  operator () (const ns3::Ptr< ns3::ndn::GlobalRouter > &a, const ns3::Ptr< ns3::ndn::GlobalRouter > &b) const
+  {
+    return a->GetId () < b->GetId ();
+  }
+};
+
 struct DistancesMap :
-  public std::map< ns3::Ptr< ns3::ndn::GlobalRouter >, tuple< ns3::Ptr<ns3::ndn::Face>, uint32_t, double > >
+  public std::map< ns3::Ptr< ns3::ndn::GlobalRouter >, tuple< ns3::Ptr<ns3::ndn::Face>, uint32_t, double >,
+                   GlobalRouterIdCompare >
 {
 };
 
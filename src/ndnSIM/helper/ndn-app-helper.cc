@@ -23,10 +23,7 @@
 #include "ns3/string.h"
 #include "ns3/names.h"
 #include "ns3/ndn-app.h"
-
-#ifdef NS3_MPI
-#include "ns3/mpi-interface.h"
-#endif
+#include "ns3/ndn-mpi-partition.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.AppHelper");
 
@@ -85,14 +82,11 @@ AppHelper::Install (NodeContainer c)
 Ptr<Application>
 AppHelper::InstallPriv (Ptr<Node> node)
 {
-#ifdef NS3_MPI
-  if (MpiInterface::IsEnabled () &&
-      node->GetSystemId () != MpiInterface::GetSystemId ())
+  if (!MpiPartition::IsLocal (node))
     {
       // don't create an app if MPI is enabled and node is not in the correct partition
       return 0;
     }
-#endif
   
   Ptr<Application> app = m_factory.Create<Application> ();        
   node->AddApplication (app);
@@ -29,8 +29,11 @@
 #include "ns3/ndn-l3-protocol.h"
 #include "../model/ndn-net-device-face.h"
 #include "../model/ndn-global-router.h"
+#include "ndn-global-routing-trees.h"
+#include "ndn-global-routing-snapshot.h"
 #include "ns3/ndn-name.h"
 #include "ns3/ndn-fib.h"
+#include "ns3/ndn-mpi-partition.h"
 
 #include "ns3/node.h"
 #include "ns3/node-container.h"
@@ -42,9 +45,12 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/concept/assert.hpp>
 // #include <boost/graph/graph_concepts.hpp>
 // #include <boost/graph/adjacency_list.hpp>
@@ -53,6 +59,7 @@
 #include "boost-graph-ndn-global-routing-helper.h"
 
 #include <math.h>
+#include <limits>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingHelper");
 
@@ -62,10 +69,104 @@ using namespace boost;
 namespace ns3 {
 namespace ndn {
 
+/// @cond include_hidden
+namespace {
+
+// shortest path trees kept by GlobalRoutingHelper::UpdateRoutes
+boost::shared_ptr<GlobalRoutingTrees> g_trees;
+
+void
+DiscardTrees ()
+{
+  g_trees.reset ();
+}
+
+// Install routes from the shortest paths calculated on the snapshot, in the same order and in the
+// same way as done by CalculateRoutes and CalculateAllPossibleRoutes using DistancesMap
+void
+InstallRoutes (const GlobalRoutingSnapshot &snapshot, const GlobalRoutingSnapshot::Task &task,
+               const GlobalRoutingSnapshot::Distances &distances, Ptr<Fib> fib)
+{
+  BOOST_FOREACH (uint32_t id, snapshot.GetOrderedVertices ())
+    {
+      if (id == task.m_source)
+        continue;
+
+      const GlobalRoutingSnapshot::Distance &distance = distances[id];
+      if (distance.get<0> () < 0)
+        continue; // unreachable
+
+      Ptr<Face> face = snapshot.GetFace (distance.get<0> ());
+      if (task.m_restricted &&
+          (distance.get<0> () != task.m_enabledFace ||
+           face->GetMetric () == std::numeric_limits<uint16_t>::max ()-1))
+        continue; // path via disabled face
+
+      BOOST_FOREACH (const Ptr<const Name> &prefix, snapshot.GetVertex (id)->GetLocalPrefixes ())
+        {
+          NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *face
+                        << " with distance " << distance.get<1> ()
+                        << " with delay " << distance.get<2> ());
+
+          Ptr<fib::Entry> entry = fib->Add (prefix, face, distance.get<1> ());
+          entry->SetRealDelayToProducer (face, Seconds (distance.get<2> ()));
+
+          Ptr<Limits> faceLimits = face->GetObject<Limits> ();
+
+          Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+          if (fibLimits != 0)
+            {
+              // if it was created by the forwarding strategy via DidAddFibEntry event
+              fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * distance.get<2> () /*exact RTT*/);
+            }
+        }
+    }
+}
+
+// Calculate shortest paths for the tasks in batches (limiting memory needed for the results),
+// installing routes in the order of tasks after each batch
+void
+CalculateInParallel (const GlobalRoutingSnapshot &snapshot,
+                     const std::vector<GlobalRoutingSnapshot::Task> &tasks,
+                     bool invalidatedRoutes, uint32_t nThreads)
+{
+  const uint32_t batchSize = 8 * nThreads;
+  for (uint32_t start = 0; start < tasks.size (); start += batchSize)
+    {
+      std::vector<GlobalRoutingSnapshot::Task> batch (tasks.begin () + start,
+                                                      tasks.begin () + std::min<size_t> (start + batchSize, tasks.size ()));
+      std::vector<GlobalRoutingSnapshot::Distances> results;
+      snapshot.Calculate (batch, results, nThreads);
+
+      for (uint32_t i = 0; i < batch.size (); i++)
+        {
+          Ptr<GlobalRouter> source = snapshot.GetVertex (batch[i].m_source);
+          Ptr<Fib> fib = source->GetObject<Fib> ();
+          NS_ASSERT (fib != 0);
+
+          bool firstTask = (start + i == 0 || tasks[start + i - 1].m_source != batch[i].m_source);
+          if (firstTask)
+            {
+              if (invalidatedRoutes)
+                {
+                  fib->InvalidateAll ();
+                }
+              NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
+            }
+
+          InstallRoutes (snapshot, batch[i], results[i], fib);
+        }
+    }
+}
+
+}
+/// @endcond
+
 void
 GlobalRoutingHelper::Install (Ptr<Node> node)
 {
   NS_LOG_LOGIC ("Node: " << node->GetId ());
+  DiscardTrees ();
 
   Ptr<L3Protocol> ndn = node->GetObject<L3Protocol> ();
   NS_ASSERT_MSG (ndn != 0, "Cannot install GlobalRoutingHelper before Ndn is installed on a node");
@@ -196,6 +297,7 @@ GlobalRoutingHelper::AddOrigin (const std::string &prefix, Ptr<Node> node)
 
   Ptr<Name> name = Create<Name> (boost::lexical_cast<Name> (prefix));
   gr->AddLocalPrefix (name);
+  DiscardTrees ();
 }
 
 void
@@ -236,6 +338,30 @@ GlobalRoutingHelper::AddOriginsForAll ()
 void
 GlobalRoutingHelper::CalculateRoutes (bool invalidatedRoutes/* = true*/)
 {
+  DiscardTrees ();
+
+  uint32_t nThreads = GlobalRoutingSnapshot::GetNThreads ();
+  if (nThreads > 1)
+    {
+      GlobalRoutingSnapshot snapshot;
+      std::vector<GlobalRoutingSnapshot::Task> tasks;
+      for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+        {
+          Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
+          if (source == 0)
+            continue;
+
+          if (!MpiPartition::IsLocal (*node))
+            continue; // routes are needed only on the rank that simulates the node
+
+          GlobalRoutingSnapshot::Task task = { snapshot.GetVertexId (source), false, -1 };
+          tasks.push_back (task);
+        }
+
+      CalculateInParallel (snapshot, tasks, invalidatedRoutes, nThreads);
+      return;
+    }
+
   /**
    * Implementation of route calculation is heavily based on Boost Graph Library
    * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
@@ -259,6 +385,9 @@ GlobalRoutingHelper::CalculateRoutes (bool invalidatedRoutes/* = true*/)
 	  continue;
 	}
 
+      if (!MpiPartition::IsLocal (*node))
+        continue; // routes are needed only on the rank that simulates the node
+
       DistancesMap    distances;
 
       dijkstra_shortest_paths (graph, source,
@@ -329,6 +458,47 @@ GlobalRoutingHelper::CalculateRoutes (bool invalidatedRoutes/* = true*/)
 void
 GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true*/)
 {
+  DiscardTrees ();
+
+  uint32_t nThreads = GlobalRoutingSnapshot::GetNThreads ();
+  if (nThreads > 1)
+    {
+      GlobalRoutingSnapshot snapshot;
+      std::vector<GlobalRoutingSnapshot::Task> tasks;
+      for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+        {
+          Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
+          if (source == 0)
+            continue;
+
+          if (!MpiPartition::IsLocal (*node))
+            continue; // routes are needed only on the rank that simulates the node
+
+          Ptr<L3Protocol> l3 = source->GetObject<L3Protocol> ();
+          NS_ASSERT (l3 != 0);
+
+          bool hasTasks = false;
+          for (uint32_t enabledFaceId = 0; enabledFaceId < l3->GetNFaces (); enabledFaceId++)
+            {
+              if (DynamicCast<ndn::NetDeviceFace> (l3->GetFace (enabledFaceId)) == 0)
+                continue;
+
+              GlobalRoutingSnapshot::Task task = { snapshot.GetVertexId (source), true,
+                                                   snapshot.GetFaceId (l3->GetFace (enabledFaceId)) };
+              tasks.push_back (task);
+              hasTasks = true;
+            }
+
+          if (!hasTasks && invalidatedRoutes)
+            {
+              source->GetObject<Fib> ()->InvalidateAll ();
+            }
+        }
+
+      CalculateInParallel (snapshot, tasks, invalidatedRoutes, nThreads);
+      return;
+    }
+
   /**
    * Implementation of route calculation is heavily based on Boost Graph Library
    * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
@@ -352,6 +522,9 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true
 	  continue;
 	}
 
+      if (!MpiPartition::IsLocal (*node))
+        continue; // routes are needed only on the rank that simulates the node
+
       Ptr<Fib>  fib  = source->GetObject<Fib> ();
       if (invalidatedRoutes)
         {
@@ -455,6 +628,23 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true
     }
 }
 
+void
+GlobalRoutingHelper::UpdateRoutes ()
+{
+  if (g_trees == 0)
+    {
+      NS_LOG_DEBUG ("Calculating shortest path trees for all nodes");
+
+      g_trees = boost::make_shared<GlobalRoutingTrees> ();
+      g_trees->CalculateAll (true);
+
+      Simulator::ScheduleDestroy (&DiscardTrees);
+      return;
+    }
+
+  uint32_t changes = g_trees->Update ();
+  NS_LOG_DEBUG ("Routes updated after " << changes << " edge changes");
+}
 
 } // namespace ndn
 } // namespace ns3
@@ -98,6 +98,9 @@ public:
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
    *
+   * If ndn::GlobalRoutingThreads global variable is not 1, shortest path trees are calculated in
+   * parallel, while routes are installed in the same order as in the serial calculation
+   *
    * @param invalidatedRoutes flag indicating whether existing routes should be invalidated or keps as is
    */
   static void
@@ -111,10 +114,32 @@ public:
    * Refer to the implementation for more details.
    *
    * Note that this method is highly experimental and should be used with caution (very time consuming).
+   * Similar to CalculateRoutes, shortest paths are calculated in parallel if ndn::GlobalRoutingThreads
+   * global variable is not 1.
    */
   static void
   CalculateAllPossibleRoutes (bool invalidatedRoutes = true);
 
+  /**
+   * @brief Incrementally update routes after links went down or up (e.g., using LinkControlHelper)
+   *
+   * The first call calculates shortest path trees for every node and installs routes to all prefix
+   * origins (same as CalculateRoutes).  The trees are kept, and every subsequent call updates only
+   * the parts of the trees and only the FIB entries that are affected by the faces that changed their
+   * status (up or down), routing metric, or link delay since the previous call.  For example:
+   *
+   *     ndn::GlobalRoutingHelper::UpdateRoutes (); // instead of CalculateRoutes
+   *     ...
+   *     Simulator::Schedule (Seconds (10.0), ndn::LinkControlHelper::FailLink, node1, node2);
+   *     Simulator::Schedule (Seconds (10.0), ndn::GlobalRoutingHelper::UpdateRoutes);
+   *
+   * Kept trees require memory proportional to the squared number of nodes.  They are discarded
+   * when topology or prefix origins change, by CalculateRoutes, CalculateAllPossibleRoutes, and at
+   * the end of the simulation.  In these cases, the next call calculates the trees from scratch.
+   */
+  static void
+  UpdateRoutes ();
+
 private:
   void
   Install (Ptr<Channel> channel);
@@ -0,0 +1,357 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-global-routing-snapshot.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-limits.h"
+#include "../model/ndn-global-router.h"
+
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/assert.h"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <algorithm>
+#include <limits>
+#include <unistd.h>
+
+namespace ns3 {
+namespace ndn {
+
+/// @cond include_hidden
+static
+GlobalValue g_globalRoutingThreads ("ndn::GlobalRoutingThreads",
+                                    "Number of threads used by GlobalRoutingHelper to calculate shortest paths "
+                                    "(1: serial calculation, 0: one thread per processor)",
+                                    UintegerValue (1),
+                                    MakeUintegerChecker<uint32_t> ());
+
+namespace {
+
+typedef GlobalRoutingSnapshot::Distance Distance;
+typedef boost::tuple<int32_t, uint16_t, double> Weight;
+
+// The same as boost::WeightZero and boost::WeightInf
+const Distance DistanceZero (-1, 0, 0.0);
+const Distance DistanceInf (-1, std::numeric_limits<uint16_t>::max (), 0.0);
+
+// The same as boost::WeightCompare
+struct DistanceCompare
+{
+  bool
+  operator () (const Distance &a, const Distance &b) const
+  {
+    return a.get<1> () < b.get<1> ();
+  }
+};
+
+// The same as boost::WeightCombine
+struct DistanceCombine
+{
+  Distance
+  operator () (const Distance &a, const Weight &b) const
+  {
+    if (a.get<0> () < 0)
+      return Distance (b.get<0> (), a.get<1> () + b.get<1> (), a.get<2> () + b.get<2> ());
+    else
+      return Distance (a.get<0> (), a.get<1> () + b.get<1> (), a.get<2> () + b.get<2> ());
+  }
+};
+
+// The same as boost::EdgeWeights, with faces of the source optionally disabled as in
+// GlobalRoutingHelper::CalculateAllPossibleRoutes
+struct Weights
+{
+  typedef GlobalRoutingSnapshot::Graph Graph;
+  typedef boost::graph_traits<Graph>::edge_descriptor key_type;
+  typedef Weight value_type;
+  typedef Weight reference;
+  typedef boost::readable_property_map_tag category;
+
+  Weights (const Graph &graph, const GlobalRoutingSnapshot::Task &task)
+    : m_graph (graph)
+    , m_task (task)
+  {
+  }
+
+  const Graph &m_graph;
+  const GlobalRoutingSnapshot::Task &m_task;
+};
+
+inline Weight
+get (const Weights &weights, const Weights::key_type &edge)
+{
+  const GlobalRoutingSnapshot::Edge &e = weights.m_graph[edge];
+  if (e.m_face < 0)
+    return Weight (-1, 0, 0.0);
+
+  uint16_t metric = e.m_metric;
+  if (weights.m_task.m_restricted &&
+      boost::source (edge, weights.m_graph) == weights.m_task.m_source &&
+      e.m_face != weights.m_task.m_enabledFace)
+    {
+      metric = std::numeric_limits<uint16_t>::max () - 1;
+    }
+  return Weight (e.m_face, metric, e.m_delay);
+}
+
+struct OrderByRouterId
+{
+  OrderByRouterId (const std::vector< Ptr<GlobalRouter> > &vertices)
+    : m_vertices (vertices)
+  {
+  }
+
+  bool
+  operator () (uint32_t a, uint32_t b) const
+  {
+    return m_vertices[a]->GetId () < m_vertices[b]->GetId ();
+  }
+
+  const std::vector< Ptr<GlobalRouter> > &m_vertices;
+};
+
+class Worker
+{
+public:
+  Worker (const GlobalRoutingSnapshot &snapshot,
+          const std::vector<GlobalRoutingSnapshot::Task> &tasks,
+          std::vector<GlobalRoutingSnapshot::Distances> &results,
+          void (GlobalRoutingSnapshot::*calculate) (const GlobalRoutingSnapshot::Task &,
+                                                    GlobalRoutingSnapshot::Distances &) const)
+    : m_snapshot (snapshot)
+    , m_tasks (tasks)
+    , m_results (results)
+    , m_calculate (calculate)
+    , m_next (0)
+  {
+  }
+
+  void
+  Run ()
+  {
+    while (true)
+      {
+        uint32_t task;
+        {
+          CriticalSection lock (m_mutex);
+          task = m_next++;
+        }
+        if (task >= m_tasks.size ())
+          return;
+
+        (m_snapshot.*m_calculate) (m_tasks[task], m_results[task]);
+      }
+  }
+
+private:
+  const GlobalRoutingSnapshot &m_snapshot;
+  const std::vector<GlobalRoutingSnapshot::Task> &m_tasks;
+  std::vector<GlobalRoutingSnapshot::Distances> &m_results;
+  void (GlobalRoutingSnapshot::*m_calculate) (const GlobalRoutingSnapshot::Task &,
+                                              GlobalRoutingSnapshot::Distances &) const;
+
+  SystemMutex m_mutex;
+  uint32_t m_next;
+};
+
+}
+/// @endcond
+
+GlobalRoutingSnapshot::GlobalRoutingSnapshot ()
+{
+  // the same order of vertices as in NdnGlobalRouterGraph: nodes first, then channels
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        m_vertices.push_back (gr);
+    }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin (); channel != ChannelList::End (); channel++)
+    {
+      Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        m_vertices.push_back (gr);
+    }
+
+  for (uint32_t id = 0; id < m_vertices.size (); id++)
+    {
+      m_vertexIds[PeekPointer (m_vertices[id])] = id;
+      m_orderedVertices.push_back (id);
+    }
+  std::sort (m_orderedVertices.begin (), m_orderedVertices.end (), OrderByRouterId (m_vertices));
+
+  m_graph = Graph (m_vertices.size ());
+  for (uint32_t id = 0; id < m_vertices.size (); id++)
+    {
+      // the same order of edges as in NdnGlobalRouterGraph (edges with faces that are down are skipped)
+      BOOST_FOREACH (const GlobalRouter::Incidency &incidency, m_vertices[id]->GetIncidencies ())
+        {
+          Ptr<Face> face = incidency.get<1> ();
+
+          Edge edge;
+          edge.m_face = -1;
+          edge.m_metric = 0;
+          edge.m_delay = 0.0;
+          if (face != 0)
+            {
+              if (!face->IsUp ())
+                continue;
+
+              std::map<Face*, int32_t>::iterator faceId = m_faceIds.find (PeekPointer (face));
+              if (faceId == m_faceIds.end ())
+                {
+                  faceId = m_faceIds.insert (std::make_pair (PeekPointer (face), m_faces.size ())).first;
+                  m_faces.push_back (face);
+                }
+
+              edge.m_face = faceId->second;
+              edge.m_metric = face->GetMetric ();
+
+              Ptr<Limits> limits = face->GetObject<Limits> ();
+              if (limits != 0) // valid limits object
+                {
+                  edge.m_delay = limits->GetLinkDelay ();
+                }
+            }
+
+          boost::add_edge (id, GetVertexId (incidency.get<2> ()), edge, m_graph);
+        }
+    }
+}
+
+uint32_t
+GlobalRoutingSnapshot::GetNVertices () const
+{
+  return m_vertices.size ();
+}
+
+Ptr<GlobalRouter>
+GlobalRoutingSnapshot::GetVertex (uint32_t id) const
+{
+  return m_vertices[id];
+}
+
+uint32_t
+GlobalRoutingSnapshot::GetVertexId (Ptr<GlobalRouter> router) const
+{
+  std::map<GlobalRouter*, uint32_t>::const_iterator id = m_vertexIds.find (PeekPointer (router));
+  NS_ASSERT (id != m_vertexIds.end ());
+  return id->second;
+}
+
+const std::vector<uint32_t> &
+GlobalRoutingSnapshot::GetOrderedVertices () const
+{
+  return m_orderedVertices;
+}
+
+Ptr<Face>
+GlobalRoutingSnapshot::GetFace (int32_t id) const
+{
+  if (id < 0)
+    return 0;
+  else
+    return m_faces[id];
+}
+
+int32_t
+GlobalRoutingSnapshot::GetFaceId (Ptr<Face> face) const
+{
+  std::map<Face*, int32_t>::const_iterator id = m_faceIds.find (PeekPointer (face));
+  if (id == m_faceIds.end ())
+    return -1;
+  else
+    return id->second;
+}
+
+void
+GlobalRoutingSnapshot::Calculate (const Task &task, Distances &distances) const
+{
+  distances.resize (m_vertices.size ());
+
+  boost::dijkstra_shortest_paths (m_graph, task.m_source,
+                                  boost::weight_map (Weights (m_graph, task))
+                                  .
+                                  distance_map (boost::make_iterator_property_map (distances.begin (),
+                                                                                   boost::get (boost::vertex_index, m_graph)))
+                                  .
+                                  distance_inf (DistanceInf)
+                                  .
+                                  distance_zero (DistanceZero)
+                                  .
+                                  distance_compare (DistanceCompare ())
+                                  .
+                                  distance_combine (DistanceCombine ())
+                                  );
+}
+
+void
+GlobalRoutingSnapshot::Calculate (const std::vector<Task> &tasks, std::vector<Distances> &results, uint32_t nThreads) const
+{
+  results.resize (tasks.size ());
+
+  Worker worker (*this, tasks, results, &GlobalRoutingSnapshot::Calculate);
+  if (nThreads <= 1)
+    {
+      worker.Run ();
+      return;
+    }
+
+  std::vector< Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < nThreads; i++)
+    {
+      threads.push_back (Create<SystemThread> (MakeCallback (&Worker::Run, &worker)));
+      threads.back ()->Start ();
+    }
+
+  for (uint32_t i = 0; i < nThreads; i++)
+    {
+      threads[i]->Join ();
+    }
+}
+
+uint32_t
+GlobalRoutingSnapshot::GetNThreads ()
+{
+  UintegerValue value;
+  g_globalRoutingThreads.GetValue (value);
+
+  uint32_t nThreads = value.Get ();
+  if (nThreads == 0)
+    {
+      long processors = sysconf (_SC_NPROCESSORS_ONLN);
+      nThreads = (processors > 0) ? processors : 1;
+    }
+  return nThreads;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_GLOBAL_ROUTING_SNAPSHOT_H
+#define NDN_GLOBAL_ROUTING_SNAPSHOT_H
+
+/// @cond include_hidden
+
+#include "ns3/ptr.h"
+
+#include <vector>
+#include <map>
+#include <boost/tuple/tuple.hpp>
+#include <boost/graph/adjacency_list.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+class Face;
+
+/**
+ * @brief Immutable snapshot of the global routing graph for parallel shortest path calculations
+ *
+ * The snapshot contains the same vertices and edges (in the same order, without edges over faces
+ * that are down) as NdnGlobalRouterGraph, but refers to faces by indices, so shortest paths can be
+ * calculated in several threads without touching any ns-3 objects (e.g., reference counters of
+ * faces and routers).  Shortest paths are calculated by the same boost::dijkstra_shortest_paths
+ * algorithm with the same weights, so results (including selection between equal-cost paths) are
+ * exactly the same as with NdnGlobalRouterGraph.
+ */
+class GlobalRoutingSnapshot
+{
+public:
+  /**
+   * @brief Path to a vertex: (index of the first-hop face or -1 if unreachable, distance, delay)
+   */
+  typedef boost::tuple<int32_t, uint32_t, double> Distance;
+  typedef std::vector<Distance> Distances;
+
+  /**
+   * @brief Shortest path calculation task
+   */
+  struct Task
+  {
+    uint32_t m_source;     ///< @brief index of the source vertex
+    bool m_restricted;     ///< @brief if true, all faces of the source except m_enabledFace have max metric
+    int32_t m_enabledFace; ///< @brief index of the only enabled face (-1 if the face is not in the graph)
+  };
+
+  /**
+   * @brief Create snapshot of the nodes and channels with GlobalRouter interface
+   */
+  GlobalRoutingSnapshot ();
+
+  /**
+   * @brief Get number of vertices
+   */
+  uint32_t
+  GetNVertices () const;
+
+  /**
+   * @brief Get router of the vertex
+   */
+  Ptr<GlobalRouter>
+  GetVertex (uint32_t id) const;
+
+  /**
+   * @brief Get index of the vertex, which router is aggregated to the node
+   */
+  uint32_t
+  GetVertexId (Ptr<GlobalRouter> router) const;
+
+  /**
+   * @brief Get indices of all vertices, ordered in the same way as keys of DistancesMap
+   *        (by router ids)
+   */
+  const std::vector<uint32_t> &
+  GetOrderedVertices () const;
+
+  /**
+   * @brief Get face by its index in the snapshot
+   */
+  Ptr<Face>
+  GetFace (int32_t id) const;
+
+  /**
+   * @brief Get index of the face in the snapshot (-1 if face is not part of the graph)
+   */
+  int32_t
+  GetFaceId (Ptr<Face> face) const;
+
+  /**
+   * @brief Calculate shortest paths for all tasks using nThreads threads
+   * @param results Shortest paths to every vertex, one entry for each task
+   */
+  void
+  Calculate (const std::vector<Task> &tasks, std::vector<Distances> &results, uint32_t nThreads) const;
+
+  /**
+   * @brief Get value of ndn::GlobalRoutingThreads global variable (0 is converted to the number of
+   *        processors)
+   */
+  static uint32_t
+  GetNThreads ();
+
+private:
+  void
+  Calculate (const Task &task, Distances &distances) const;
+
+public:
+  /// @brief Edge of the snapshot graph
+  struct Edge
+  {
+    int32_t m_face;
+    uint16_t m_metric;
+    double m_delay;
+  };
+
+  typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property, Edge> Graph;
+
+private:
+  Graph m_graph;
+  std::vector< Ptr<GlobalRouter> > m_vertices;
+  std::vector<uint32_t> m_orderedVertices;
+  std::map<GlobalRouter*, uint32_t> m_vertexIds;
+
+  std::vector< Ptr<Face> > m_faces;
+  std::map<Face*, int32_t> m_faceIds;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+/// @endcond
+
+#endif // NDN_GLOBAL_ROUTING_SNAPSHOT_H
@@ -0,0 +1,395 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-global-routing-trees.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-limits.h"
+#include "ns3/ndn-mpi-partition.h"
+#include "../model/ndn-global-router.h"
+
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <boost/foreach.hpp>
+#include <boost/unordered_map.hpp>
+#include <limits>
+#include <set>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingTrees");
+
+namespace ns3 {
+namespace ndn {
+
+/// @cond include_hidden
+static const uint32_t INF = std::numeric_limits<uint32_t>::max ();
+static const uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max ();
+/// @endcond
+
+GlobalRoutingTrees::GlobalRoutingTrees ()
+{
+  // the same order of vertices as in NdnGlobalRouterGraph: nodes first, then channels
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr == 0)
+        continue;
+
+      Ptr<Fib> fib = gr->GetObject<Fib> ();
+      NS_ASSERT (fib != 0);
+
+      // shortest path trees are needed only for nodes simulated by the current rank
+      if (MpiPartition::IsLocal (*node))
+        {
+          Tree tree;
+          tree.m_source = m_vertices.size ();
+          m_trees.push_back (tree);
+        }
+      m_vertices.push_back (gr);
+    }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin (); channel != ChannelList::End (); channel++)
+    {
+      Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        m_vertices.push_back (gr);
+    }
+
+  boost::unordered_map<GlobalRouter*, uint32_t> ids;
+  for (uint32_t id = 0; id < m_vertices.size (); id++)
+    {
+      ids[PeekPointer (m_vertices[id])] = id;
+    }
+
+  m_out.resize (m_vertices.size ());
+  m_in.resize (m_vertices.size ());
+  m_prefixes.resize (m_vertices.size ());
+  for (uint32_t id = 0; id < m_vertices.size (); id++)
+    {
+      BOOST_FOREACH (const GlobalRouter::Incidency &incidency, m_vertices[id]->GetIncidencies ())
+        {
+          Edge edge;
+          edge.m_from = id;
+          edge.m_to = ids[PeekPointer (incidency.get<2> ())];
+          edge.m_face = incidency.get<1> ();
+          ReadWeight (edge, edge.m_up, edge.m_metric, edge.m_delay);
+
+          m_out[edge.m_from].push_back (m_edges.size ());
+          m_in[edge.m_to].push_back (m_edges.size ());
+          m_edges.push_back (edge);
+        }
+
+      BOOST_FOREACH (const Ptr<Name> &prefix, m_vertices[id]->GetLocalPrefixes ())
+        {
+          m_prefixes[id].push_back (prefix);
+          m_origins[*prefix].push_back (std::make_pair (id, prefix));
+        }
+    }
+}
+
+void
+GlobalRoutingTrees::ReadWeight (const Edge &edge, bool &up, uint16_t &metric, double &delay)
+{
+  // the same weights as used by NdnGlobalRouterGraph
+  if (edge.m_face == 0)
+    {
+      up = true;
+      metric = 0;
+      delay = 0.0;
+    }
+  else
+    {
+      up = edge.m_face->IsUp ();
+      metric = edge.m_face->GetMetric ();
+
+      Ptr<Limits> limits = edge.m_face->GetObject<Limits> ();
+      delay = (limits != 0) ? limits->GetLinkDelay () : 0.0;
+    }
+}
+
+Ptr<Face>
+GlobalRoutingTrees::GetFace (uint32_t edgeId) const
+{
+  if (edgeId == NO_EDGE)
+    return 0;
+  else
+    return m_edges[edgeId].m_face;
+}
+
+void
+GlobalRoutingTrees::Relax (Tree &tree, uint32_t edgeId, Queue &queue, OldRoutes *old)
+{
+  const Edge &edge = m_edges[edgeId];
+  if (!edge.m_up || tree.m_distance[edge.m_from] == INF)
+    return;
+
+  uint32_t distance = tree.m_distance[edge.m_from] + edge.m_metric;
+  if (distance >= tree.m_distance[edge.m_to])
+    return;
+
+  if (old != 0)
+    {
+      Route route = { tree.m_distance[edge.m_to], tree.m_delay[edge.m_to], tree.m_firstHop[edge.m_to] };
+      old->insert (std::make_pair (edge.m_to, route)); // only the first (original) value is recorded
+    }
+
+  tree.m_distance[edge.m_to] = distance;
+  tree.m_delay[edge.m_to] = tree.m_delay[edge.m_from] + edge.m_delay;
+  tree.m_parent[edge.m_to] = edgeId;
+  tree.m_firstHop[edge.m_to] = (edge.m_from == tree.m_source) ? edgeId : tree.m_firstHop[edge.m_from];
+
+  queue.push (QueueItem (distance, edge.m_to));
+}
+
+void
+GlobalRoutingTrees::Propagate (Tree &tree, Queue &queue, OldRoutes *old)
+{
+  while (!queue.empty ())
+    {
+      QueueItem item = queue.top ();
+      queue.pop ();
+
+      if (item.first != tree.m_distance[item.second])
+        continue; // vertex has been reached via a shorter path after the item was queued
+
+      BOOST_FOREACH (uint32_t edgeId, m_out[item.second])
+        {
+          Relax (tree, edgeId, queue, old);
+        }
+    }
+}
+
+void
+GlobalRoutingTrees::RemoveEdge (Tree &tree, uint32_t edgeId, OldRoutes &old)
+{
+  uint32_t root = m_edges[edgeId].m_to;
+  if (tree.m_parent[root] != edgeId)
+    return; // shortest paths do not use the edge
+
+  // find all vertices, which shortest paths go through the edge
+  enum { UNKNOWN = 0, INSIDE, OUTSIDE };
+  std::vector<uint8_t> mark (m_vertices.size (), UNKNOWN);
+  mark[root] = INSIDE;
+  mark[tree.m_source] = OUTSIDE;
+
+  std::vector<uint32_t> path;
+  std::vector<uint32_t> subtree;
+  for (uint32_t id = 0; id < m_vertices.size (); id++)
+    {
+      uint32_t vertex = id;
+      path.clear ();
+      while (mark[vertex] == UNKNOWN)
+        {
+          path.push_back (vertex);
+          if (tree.m_parent[vertex] == NO_EDGE)
+            mark[vertex] = OUTSIDE; // unreachable
+          else
+            vertex = m_edges[tree.m_parent[vertex]].m_from;
+        }
+
+      BOOST_FOREACH (uint32_t v, path)
+        {
+          mark[v] = mark[vertex];
+        }
+
+      if (mark[id] == INSIDE)
+        subtree.push_back (id);
+    }
+
+  NS_LOG_DEBUG ("Recalculating " << subtree.size () << " paths from vertex " << tree.m_source);
+
+  BOOST_FOREACH (uint32_t v, subtree)
+    {
+      Route route = { tree.m_distance[v], tree.m_delay[v], tree.m_firstHop[v] };
+      old.insert (std::make_pair (v, route));
+
+      tree.m_distance[v] = INF;
+      tree.m_delay[v] = 0.0;
+      tree.m_parent[v] = NO_EDGE;
+      tree.m_firstHop[v] = NO_EDGE;
+    }
+
+  // paths to the rest of the vertices are not affected, start from the best edges into the subtree
+  Queue queue;
+  BOOST_FOREACH (uint32_t v, subtree)
+    {
+      BOOST_FOREACH (uint32_t in, m_in[v])
+        {
+          if (mark[m_edges[in].m_from] == OUTSIDE)
+            Relax (tree, in, queue, &old);
+        }
+    }
+  Propagate (tree, queue, &old);
+}
+
+void
+GlobalRoutingTrees::AddEdge (Tree &tree, uint32_t edgeId, OldRoutes &old)
+{
+  Queue queue;
+  Relax (tree, edgeId, queue, &old);
+  Propagate (tree, queue, &old);
+}
+
+void
+GlobalRoutingTrees::InstallRoutes (const Tree &tree, const Name &prefix)
+{
+  Ptr<Fib> fib = m_vertices[tree.m_source]->GetObject<Fib> ();
+
+  typedef std::pair<uint32_t, Ptr<const Name> > Origin;
+  BOOST_FOREACH (const Origin &origin, m_origins[prefix])
+    {
+      uint32_t id = origin.first;
+      if (id == tree.m_source || tree.m_distance[id] == INF)
+        continue;
+
+      Ptr<Face> face = GetFace (tree.m_firstHop[id]);
+      NS_LOG_DEBUG (" prefix " << *origin.second << " reachable via face " << *face
+                    << " with distance " << tree.m_distance[id]
+                    << " with delay " << tree.m_delay[id]);
+
+      Ptr<fib::Entry> entry = fib->Add (origin.second, face, tree.m_distance[id]);
+      entry->SetRealDelayToProducer (face, Seconds (tree.m_delay[id]));
+
+      Ptr<Limits> faceLimits = face->GetObject<Limits> ();
+
+      Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+      if (fibLimits != 0)
+        {
+          // if it was created by the forwarding strategy via DidAddFibEntry event
+          fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * tree.m_delay[id] /*exact RTT*/);
+        }
+    }
+}
+
+void
+GlobalRoutingTrees::CalculateAll (bool invalidatedRoutes)
+{
+  for (std::vector<Tree>::iterator tree = m_trees.begin (); tree != m_trees.end (); tree++)
+    {
+      tree->m_distance.assign (m_vertices.size (), INF);
+      tree->m_delay.assign (m_vertices.size (), 0.0);
+      tree->m_parent.assign (m_vertices.size (), NO_EDGE);
+      tree->m_firstHop.assign (m_vertices.size (), NO_EDGE);
+
+      tree->m_distance[tree->m_source] = 0;
+      Queue queue;
+      queue.push (QueueItem (0, tree->m_source));
+      Propagate (*tree, queue, 0);
+
+      if (invalidatedRoutes)
+        {
+          m_vertices[tree->m_source]->GetObject<Fib> ()->InvalidateAll ();
+        }
+
+      NS_LOG_DEBUG ("Reachability from Node: " << m_vertices[tree->m_source]->GetObject<Node> ()->GetId ());
+      for (Origins::const_iterator origin = m_origins.begin (); origin != m_origins.end (); origin++)
+        {
+          InstallRoutes (*tree, origin->first);
+        }
+    }
+}
+
+uint32_t
+GlobalRoutingTrees::Update ()
+{
+  std::vector<OldRoutes> old (m_trees.size ());
+
+  uint32_t changes = 0;
+  for (uint32_t edgeId = 0; edgeId < m_edges.size (); edgeId++)
+    {
+      Edge &edge = m_edges[edgeId];
+
+      bool up;
+      uint16_t metric;
+      double delay;
+      ReadWeight (edge, up, metric, delay);
+      if (up == edge.m_up && metric == edge.m_metric && delay == edge.m_delay)
+        continue;
+
+      NS_LOG_DEBUG ("Edge " << edge.m_from << " -> " << edge.m_to << " changed: "
+                    << edge.m_up << "/" << edge.m_metric << " => " << up << "/" << metric);
+      changes++;
+
+      // any change is handled as removal of the old edge, followed by addition of the new one
+      if (edge.m_up)
+        {
+          edge.m_up = false;
+          for (uint32_t i = 0; i < m_trees.size (); i++)
+            RemoveEdge (m_trees[i], edgeId, old[i]);
+        }
+
+      edge.m_up = up;
+      edge.m_metric = metric;
+      edge.m_delay = delay;
+      if (edge.m_up)
+        {
+          for (uint32_t i = 0; i < m_trees.size (); i++)
+            AddEdge (m_trees[i], edgeId, old[i]);
+        }
+    }
+
+  for (uint32_t i = 0; i < m_trees.size (); i++)
+    {
+      const Tree &tree = m_trees[i];
+
+      std::set<Name> prefixes;
+      for (OldRoutes::const_iterator route = old[i].begin (); route != old[i].end (); route++)
+        {
+          uint32_t id = route->first;
+          if (route->second.m_distance == tree.m_distance[id] &&
+              route->second.m_delay == tree.m_delay[id] &&
+              GetFace (route->second.m_firstHop) == GetFace (tree.m_firstHop[id]))
+            continue;
+
+          BOOST_FOREACH (const Ptr<const Name> &prefix, m_prefixes[id])
+            {
+              prefixes.insert (*prefix);
+            }
+        }
+
+      if (prefixes.empty ())
+        continue;
+
+      NS_LOG_DEBUG ("Updating " << prefixes.size () << " FIB entries on Node: "
+                    << m_vertices[tree.m_source]->GetObject<Node> ()->GetId ());
+
+      Ptr<Fib> fib = m_vertices[tree.m_source]->GetObject<Fib> ();
+      BOOST_FOREACH (const Name &prefix, prefixes)
+        {
+          Ptr<fib::Entry> entry = fib->Find (prefix);
+          if (entry != 0)
+            {
+              entry->Invalidate ();
+            }
+
+          InstallRoutes (tree, prefix);
+        }
+    }
+
+  return changes;
+}
+
+} // namespace ndn
+} // namespace ns3
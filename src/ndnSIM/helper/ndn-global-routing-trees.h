@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_GLOBAL_ROUTING_TREES_H
+#define NDN_GLOBAL_ROUTING_TREES_H
+
+/// @cond include_hidden
+
+#include "ns3/ptr.h"
+#include "ns3/ndn-name.h"
+
+#include <vector>
+#include <map>
+#include <queue>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+class Face;
+
+/**
+ * @brief Shortest path trees from every node, which can be updated after changes of link status
+ *
+ * When MPI is enabled, trees are built only from nodes simulated by the current rank (see
+ * MpiPartition).
+ *
+ * The graph is the same as used by GlobalRoutingHelper::CalculateRoutes (nodes and channels with
+ * GlobalRouter interface, edges with routing metric and link delay of the face).  Edges with faces
+ * that are down are excluded from the graph.
+ *
+ * Update () compares current status, metric, and delay of every edge with the values used to build
+ * the trees.  For each changed edge, trees are repaired using dynamic shortest path updates:
+ * - if the edge went down (or got worse) and was part of a tree, only the subtree below the edge
+ *   is recalculated, starting from the best edges into the subtree;
+ * - if the edge went up (or got better), only nodes that get strictly shorter paths over the edge
+ *   are updated.
+ *
+ * FIB entries are updated only for prefixes originated by nodes, which path (distance, first-hop
+ * face, or delay) has changed.  Each such FIB entry is recalculated in the same way as
+ * CalculateRoutes does it.  When there are several shortest paths, the selected one can be
+ * different from the one selected by a full recalculation.
+ */
+class GlobalRoutingTrees
+{
+public:
+  /**
+   * @brief Create graph from the current set of nodes and channels with GlobalRouter interface
+   */
+  GlobalRoutingTrees ();
+
+  /**
+   * @brief Calculate shortest path trees from every node and install routes to all prefix origins
+   * @param invalidatedRoutes flag indicating whether existing routes should be invalidated or kept as is
+   */
+  void
+  CalculateAll (bool invalidatedRoutes);
+
+  /**
+   * @brief Update trees and FIB entries affected by the changed edges
+   * @returns number of changed edges
+   */
+  uint32_t
+  Update ();
+
+private:
+  struct Edge
+  {
+    uint32_t m_from;
+    uint32_t m_to;
+    Ptr<Face> m_face;
+
+    bool m_up;
+    uint16_t m_metric;
+    double m_delay;
+  };
+
+  struct Tree
+  {
+    uint32_t m_source;
+    std::vector<uint32_t> m_distance;
+    std::vector<double> m_delay;
+    std::vector<uint32_t> m_parent;   ///< @brief last edge on the shortest path
+    std::vector<uint32_t> m_firstHop; ///< @brief first edge on the shortest path
+  };
+
+  struct Route
+  {
+    uint32_t m_distance;
+    double m_delay;
+    uint32_t m_firstHop;
+  };
+
+  typedef std::map<uint32_t, Route> OldRoutes;
+  typedef std::pair<uint32_t, uint32_t> QueueItem; ///< @brief (distance, vertex)
+  typedef std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > Queue;
+  typedef std::map<Name, std::vector< std::pair<uint32_t, Ptr<const Name> > > > Origins;
+
+  static void
+  ReadWeight (const Edge &edge, bool &up, uint16_t &metric, double &delay);
+
+  void
+  Relax (Tree &tree, uint32_t edgeId, Queue &queue, OldRoutes *old);
+
+  void
+  Propagate (Tree &tree, Queue &queue, OldRoutes *old);
+
+  void
+  RemoveEdge (Tree &tree, uint32_t edgeId, OldRoutes &old);
+
+  void
+  AddEdge (Tree &tree, uint32_t edgeId, OldRoutes &old);
+
+  void
+  InstallRoutes (const Tree &tree, const Name &prefix);
+
+  Ptr<Face>
+  GetFace (uint32_t edgeId) const;
+
+private:
+  std::vector< Ptr<GlobalRouter> > m_vertices;
+  std::vector<Edge> m_edges;
+  std::vector< std::vector<uint32_t> > m_out;
+  std::vector< std::vector<uint32_t> > m_in;
+
+  std::vector< std::vector< Ptr<const Name> > > m_prefixes; ///< @brief prefixes originated by each vertex
+  Origins m_origins;
+
+  std::vector<Tree> m_trees;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+/// @endcond
+
+#endif // NDN_GLOBAL_ROUTING_TREES_H
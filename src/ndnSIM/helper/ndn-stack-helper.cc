@@ -169,6 +169,14 @@ StackHelper::SetFib (const std::string &fibClass,
       m_fibFactory.Set (attr4, StringValue (value4));
 }
 
+void
+StackHelper::SetNameTable (const std::string &pitPolicy, const std::string &contentStorePolicy)
+{
+  m_fibFactory.SetTypeId ("ns3::ndn::fib::NameTable");
+  m_pitFactory.SetTypeId ("ns3::ndn::pit::NameTable::" + pitPolicy);
+  m_contentStoreFactory.SetTypeId ("ns3::ndn::cs::NameTable::" + contentStorePolicy);
+}
+
 void
 StackHelper::SetDefaultRoutes (bool needSet)
 {
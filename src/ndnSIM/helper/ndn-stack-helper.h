@@ -130,6 +130,20 @@ public:
           const std::string &attr3 = "", const std::string &value3 = "",
           const std::string &attr4 = "", const std::string &value4 = "");
 
+  /**
+   * @brief Use FIB, PIT, and content store realizations that share one name table (ndn::NameTable)
+   * @param pitPolicy replacement policy of PIT (Persistent, Random, or Lru)
+   * @param contentStorePolicy replacement policy of the content store (Lru, Random, Fifo, or Lfu)
+   *
+   * Replaces classes previously set with SetFib, SetPit, and SetContentStore.  To set
+   * attributes of the tables, call SetPit or SetContentStore with the corresponding class
+   * afterwards, e.g., SetContentStore ("ns3::ndn::cs::NameTable::Lru", "MaxSize", "1000").
+   * Forwarding strategies do not need any modifications.
+   */
+  void
+  SetNameTable (const std::string &pitPolicy = "Persistent",
+                const std::string &contentStorePolicy = "Lru");
+
   typedef Callback< Ptr<NetDeviceFace>, Ptr<Node>, Ptr<L3Protocol>, Ptr<NetDevice> > NetDeviceFaceCreateCallback;
 
   /**
@@ -26,6 +26,8 @@
 #include "../../utils/trie/lfu-policy.h"
 #include "../../utils/trie/multi-policy.h"
 #include "../../utils/trie/aggregate-stats-policy.h"
+#include "../../utils/trie/tiny-lfu-admission-policy.h"
+#include "../../utils/trie/w-tiny-lfu-policy.h"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
   static struct X ## type ## templ ## RegistrationClass \
@@ -69,6 +71,30 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
 
+/**
+ * @brief ContentStore with W-TinyLFU cache replacement policy
+ **/
+template class ContentStoreImpl<w_tiny_lfu_policy_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, w_tiny_lfu_policy_traits);
+
+typedef multi_policy_traits< boost::mpl::vector2< lru_policy_traits,
+                                                  tiny_lfu_admission_policy_traits > > LruWithTinyLfuTraits;
+typedef multi_policy_traits< boost::mpl::vector2< lfu_policy_traits,
+                                                  tiny_lfu_admission_policy_traits > > LfuWithTinyLfuTraits;
+
+/**
+ * @brief ContentStore with LRU cache replacement policy and TinyLFU admission filter
+ **/
+template class ContentStoreImpl<LruWithTinyLfuTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LruWithTinyLfuTraits);
+
+/**
+ * @brief ContentStore with LFU cache replacement policy and TinyLFU admission filter
+ **/
+template class ContentStoreImpl<LfuWithTinyLfuTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithTinyLfuTraits);
+
 
 typedef multi_policy_traits< boost::mpl::vector2< lru_policy_traits,
                                                   aggregate_stats_policy_traits > > LruWithCountsTraits;
@@ -111,6 +137,11 @@ class Random : public ContentStoreImpl<random_policy_traits> { };
  * \brief Content Store implementing Least Frequently Used cache replacement policy
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> { };
+
+/**
+ * \brief Content Store implementing W-TinyLFU cache replacement policy
+ */
+class WTinyLfu : public ContentStoreImpl<w_tiny_lfu_policy_traits> { };
 #endif
 
 
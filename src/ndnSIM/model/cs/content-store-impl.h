@@ -123,6 +123,13 @@ public:
 
   typename super::policy_container &
   GetPolicy () { return super::getPolicy (); }
+
+protected:
+  /**
+   * @brief Find cache entry that satisfies the interest (without firing hit/miss traces)
+   */
+  virtual typename super::iterator
+  FindMatch (const Interest &interest);
   
 private:
   void
@@ -188,29 +195,34 @@ private:
 };
 
 template<class Policy>
-Ptr<Data>
-ContentStoreImpl<Policy>::Lookup (Ptr<const Interest> interest)
+typename ContentStoreImpl<Policy>::super::iterator
+ContentStoreImpl<Policy>::FindMatch (const Interest &interest)
 {
-  NS_LOG_FUNCTION (this << interest->GetName ());
-
-  typename super::const_iterator node;
-  if (interest->GetExclude () == 0)
+  if (interest.GetExclude () == 0)
     {
-      node = this->deepest_prefix_match (interest->GetName ());
+      return this->deepest_prefix_match (interest.GetName ());
     }
   else
     {
-      node = this->deepest_prefix_match_if_next_level (interest->GetName (),
-                                                       isNotExcluded (*interest->GetExclude ()));
+      return this->deepest_prefix_match_if_next_level (interest.GetName (),
+                                                       isNotExcluded (*interest.GetExclude ()));
     }
+}
+
+template<class Policy>
+Ptr<Data>
+ContentStoreImpl<Policy>::Lookup (Ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION (this << interest->GetName ());
+
+  typename super::const_iterator node = FindMatch (*interest);
 
   if (node != this->end ())
     {
       this->m_cacheHitsTrace (interest, node->payload ()->GetData ());
 
-      Ptr<Data> copy = Create<Data> (*node->payload ()->GetData ());
-      ConstCast<Packet> (copy->GetPayload ())->RemoveAllPacketTags ();
-      return copy;
+      // cached Data is shared, only per-transmission state is allocated
+      return node->payload ()->GetData ()->CreateOverlay ();
     }
   else
     {
@@ -0,0 +1,398 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_CONTENT_STORE_NAME_TABLE_H_
+#define NDN_CONTENT_STORE_NAME_TABLE_H_
+
+#include "content-store-impl.h"
+
+#include "../ndn-name-table.h"
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Cache entry implementation that is linked into the replacement policy of
+ * ContentStoreNameTable, with a reference to the node of the name table
+ */
+template<class Policy>
+class NameTableEntryImpl : public Entry
+{
+public:
+  typedef Entry base_type;
+
+  // to make sure policies work
+  typedef NameTableEntryImpl *iterator;
+  typedef const NameTableEntryImpl *const_iterator;
+
+public:
+  NameTableEntryImpl (Ptr<ContentStore> cs, Ptr<const Data> data)
+    : Entry (cs, data)
+    , node_ (0)
+  {
+  }
+
+  void
+  SetNode (NameTable::iterator node) { node_ = node; }
+
+  NameTable::iterator GetNode () { return node_; }
+  NameTable::const_iterator GetNode () const { return node_; }
+
+public:
+  typename Policy::policy_hook_type policy_hook_;
+
+private:
+  NameTable::iterator node_;
+};
+
+/// @cond include_hidden
+struct HasContentStoreEntry
+{
+  inline bool
+  operator () (const name_table::Entry &entry) const
+  {
+    return entry.m_csEntry != 0;
+  }
+};
+/// @endcond
+
+/**
+ * @ingroup ndn-cs
+ * @brief ContentStore realization that keeps its entries in the name table shared with
+ * FIB and PIT (see ndn::NameTable)
+ *
+ * Entries are linked into the replacement policy (any of the policies available for
+ * ns3::ndn::cs::ContentStoreImpl) directly, instead of through the trie nodes.
+ */
+template<class Policy>
+class ContentStoreNameTable : public ContentStore
+{
+public:
+  typedef NameTableEntryImpl< Policy > entry;
+
+  typedef typename Policy::template policy<
+    ContentStoreNameTable< Policy >,
+    entry,
+    typename Policy::template container_hook< entry >::type >::type policy_container;
+
+  static TypeId
+  GetTypeId ();
+
+  ContentStoreNameTable ();
+  virtual ~ContentStoreNameTable () { };
+
+  // from ContentStore
+
+  virtual Ptr<Data>
+  Lookup (Ptr<const Interest> interest);
+
+  virtual bool
+  Add (Ptr<const Data> data);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<Entry>
+  Begin ();
+
+  virtual Ptr<Entry>
+  End ();
+
+  virtual Ptr<Entry>
+  Next (Ptr<Entry>);
+
+  const policy_container &
+  GetPolicy () const { return m_policy; }
+
+  policy_container &
+  GetPolicy () { return m_policy; }
+
+  /**
+   * @brief Remove entry from the cache (used by replacement policies)
+   */
+  void
+  erase (entry *item);
+
+protected:
+  /**
+   * @brief Find cache entry that satisfies the interest (without firing hit/miss traces)
+   */
+  entry *
+  FindMatch (const Interest &interest);
+
+  // inherited from Object class
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  Ptr<NameTable>
+  GetNameTable ();
+
+  void
+  SetMaxSize (uint32_t maxSize);
+
+  uint32_t
+  GetMaxSize () const;
+
+  Ptr<Entry>
+  FindNext (NameTable::trie::recursive_iterator item);
+
+private:
+  static LogComponent g_log; ///< @brief Logging variable
+
+  Ptr<NameTable> m_nameTable;
+  policy_container m_policy;
+
+  /// @brief trace of for entry additions (fired every time entry is successfully added to the cache): first parameter is pointer to the CS entry
+  TracedCallback< Ptr<const Entry> > m_didAddEntry;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+
+template<class Policy>
+LogComponent ContentStoreNameTable< Policy >::g_log = LogComponent (("ndn.cs.NameTable." + Policy::GetName ()).c_str ());
+
+
+template<class Policy>
+TypeId
+ContentStoreNameTable< Policy >::GetTypeId ()
+{
+  static TypeId tid = TypeId (("ns3::ndn::cs::NameTable::"+Policy::GetName ()).c_str ())
+    .SetGroupName ("Ndn")
+    .SetParent<ContentStore> ()
+    .AddConstructor< ContentStoreNameTable< Policy > > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&ContentStoreNameTable< Policy >::GetMaxSize,
+                                         &ContentStoreNameTable< Policy >::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddTraceSource ("DidAddEntry", "Trace fired every time entry is successfully added to the cache",
+                     MakeTraceSourceAccessor (&ContentStoreNameTable< Policy >::m_didAddEntry))
+    ;
+
+  return tid;
+}
+
+template<class Policy>
+ContentStoreNameTable<Policy>::ContentStoreNameTable ()
+  : m_policy (*this)
+{
+}
+
+template<class Policy>
+Ptr<NameTable>
+ContentStoreNameTable<Policy>::GetNameTable ()
+{
+  if (m_nameTable == 0)
+    {
+      m_nameTable = NameTable::GetNameTable (this);
+    }
+  return m_nameTable;
+}
+
+template<class Policy>
+void
+ContentStoreNameTable<Policy>::DoDispose ()
+{
+  while (m_policy.size () > 0)
+    {
+      erase (&(*m_policy.begin ()));
+    }
+  m_nameTable = 0;
+
+  ContentStore::DoDispose ();
+}
+
+template<class Policy>
+void
+ContentStoreNameTable<Policy>::erase (entry *item)
+{
+  NameTable::iterator node = item->GetNode ();
+  m_policy.erase (item);
+  item->SetNode (0);
+
+  node->payload ().m_csEntry = 0; // may destroy the entry
+  m_nameTable->Prune (node);
+}
+
+template<class Policy>
+typename ContentStoreNameTable<Policy>::entry *
+ContentStoreNameTable<Policy>::FindMatch (const Interest &interest)
+{
+  const std::vector<NameTable::iterator> &path = GetNameTable ()->Walk (interest.GetName ());
+  if (path.size () != interest.GetName ().size () + 1)
+    return 0; // no entries with names that have interest name as a prefix
+
+  NameTable::iterator node;
+  if (interest.GetExclude () == 0)
+    {
+      node = path.back ()->find_if (HasContentStoreEntry ());
+    }
+  else
+    {
+      node = path.back ()->find_if_next_level (isNotExcluded (*interest.GetExclude ()),
+                                               HasContentStoreEntry ());
+    }
+
+  if (node == 0)
+    return 0;
+  else
+    return static_cast<entry*> (PeekPointer (node->payload ().m_csEntry));
+}
+
+template<class Policy>
+Ptr<Data>
+ContentStoreNameTable<Policy>::Lookup (Ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION (this << interest->GetName ());
+
+  entry *item = FindMatch (*interest);
+
+  if (item != 0)
+    {
+      m_policy.lookup (item);
+      this->m_cacheHitsTrace (interest, item->GetData ());
+
+      // cached Data is shared, only per-transmission state is allocated
+      return item->GetData ()->CreateOverlay ();
+    }
+  else
+    {
+      this->m_cacheMissesTrace (interest);
+      return 0;
+    }
+}
+
+template<class Policy>
+bool
+ContentStoreNameTable<Policy>::Add (Ptr<const Data> data)
+{
+  NS_LOG_FUNCTION (this << data->GetName ());
+
+  const std::vector<NameTable::iterator> &path = GetNameTable ()->Walk (data->GetName ());
+  if (path.size () == data->GetName ().size () + 1 && path.back ()->payload ().m_csEntry != 0)
+    {
+      // should we do anything?
+      // update payload? add new payload?
+      return false;
+    }
+
+  Ptr< entry > newEntry = Create< entry > (this, data);
+  if (!m_policy.insert (PeekPointer (newEntry)))
+    return false; // cannot insert entry
+
+  // policy could have removed other entries, so the node is looked up only now
+  NameTable::iterator node = m_nameTable->Insert (data->GetName ());
+  newEntry->SetNode (node);
+  node->payload ().m_csEntry = newEntry;
+
+  m_didAddEntry (newEntry);
+  return true;
+}
+
+template<class Policy>
+void
+ContentStoreNameTable<Policy>::Print (std::ostream &os) const
+{
+  for (typename policy_container::const_iterator item = m_policy.begin ();
+       item != m_policy.end ();
+       item++)
+    {
+      os << item->GetName () << std::endl;
+    }
+}
+
+template<class Policy>
+void
+ContentStoreNameTable<Policy>::SetMaxSize (uint32_t maxSize)
+{
+  m_policy.set_max_size (maxSize);
+}
+
+template<class Policy>
+uint32_t
+ContentStoreNameTable<Policy>::GetMaxSize () const
+{
+  return m_policy.get_max_size ();
+}
+
+template<class Policy>
+uint32_t
+ContentStoreNameTable<Policy>::GetSize () const
+{
+  return m_policy.size ();
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreNameTable<Policy>::FindNext (NameTable::trie::recursive_iterator item)
+{
+  NameTable::trie::recursive_iterator end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload ().m_csEntry != 0)
+        return item->payload ().m_csEntry;
+    }
+
+  return End ();
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreNameTable<Policy>::Begin ()
+{
+  if (m_nameTable == 0)
+    return End ();
+
+  return FindNext (NameTable::trie::recursive_iterator (m_nameTable->GetTrie ()));
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreNameTable<Policy>::End ()
+{
+  return 0;
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreNameTable<Policy>::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  NameTable::trie::recursive_iterator item (StaticCast< entry > (from)->GetNode ());
+  item++;
+  return FindNext (item);
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_NAME_TABLE_H_
@@ -0,0 +1,94 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "content-store-with-prefix-hash.h"
+
+#include "../../utils/trie/random-policy.h"
+#include "../../utils/trie/lru-policy.h"
+#include "../../utils/trie/fifo-policy.h"
+#include "../../utils/trie/lfu-policy.h"
+
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
+  static struct X ## type ## templ ## RegistrationClass \
+  {                                                     \
+    X ## type ## templ ## RegistrationClass () {        \
+      ns3::TypeId tid = type<templ>::GetTypeId ();      \
+      tid.GetParent ();                                 \
+    }                                                   \
+  } x_ ## type ## templ ## RegistrationVariable
+
+namespace ns3 {
+namespace ndn {
+
+using namespace ndnSIM;
+
+namespace cs {
+
+// explicit instantiation and registering
+/**
+ * @brief ContentStore with flat prefix-hash index and LRU cache replacement policy
+ **/
+template class ContentStoreWithPrefixHash<lru_policy_traits>;
+
+/**
+ * @brief ContentStore with flat prefix-hash index and random cache replacement policy
+ **/
+template class ContentStoreWithPrefixHash<random_policy_traits>;
+
+/**
+ * @brief ContentStore with flat prefix-hash index and FIFO cache replacement policy
+ **/
+template class ContentStoreWithPrefixHash<fifo_policy_traits>;
+
+/**
+ * @brief ContentStore with flat prefix-hash index and Least Frequently Used (LFU) cache replacement policy
+ **/
+template class ContentStoreWithPrefixHash<lfu_policy_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithPrefixHash, lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithPrefixHash, random_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithPrefixHash, fifo_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithPrefixHash, lfu_policy_traits);
+
+#ifdef DOXYGEN
+/**
+ * \brief Content Store with flat prefix-hash index implementing LRU cache replacement policy
+ */
+class PrefixHash::Lru : public ContentStoreWithPrefixHash<lru_policy_traits> { };
+
+/**
+ * \brief Content Store with flat prefix-hash index implementing FIFO cache replacement policy
+ */
+class PrefixHash::Fifo : public ContentStoreWithPrefixHash<fifo_policy_traits> { };
+
+/**
+ * \brief Content Store with flat prefix-hash index implementing Random cache replacement policy
+ */
+class PrefixHash::Random : public ContentStoreWithPrefixHash<random_policy_traits> { };
+
+/**
+ * \brief Content Store with flat prefix-hash index implementing Least Frequently Used cache replacement policy
+ */
+class PrefixHash::Lfu : public ContentStoreWithPrefixHash<lfu_policy_traits> { };
+#endif
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,98 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_CONTENT_STORE_WITH_PREFIX_HASH_H_
+#define NDN_CONTENT_STORE_WITH_PREFIX_HASH_H_
+
+#include "content-store-impl.h"
+
+#include "../../utils/trie/multi-policy.h"
+#include "../../utils/trie/prefix-hash-policy.h"
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Special content store realization that resolves lookups using flat index of
+ * full-prefix hashes (ndnSIM::prefix_hash_policy_traits)
+ *
+ * Exact-name hits and misses are resolved with a single hash probe.  Lookups that
+ * need to enumerate deeper entries (or use exclude filters) fall back to the trie.
+ */
+template<class Policy>
+class ContentStoreWithPrefixHash :
+    public ContentStoreImpl< ndnSIM::multi_policy_traits< boost::mpl::vector2< Policy, ndnSIM::prefix_hash_policy_traits > > >
+{
+public:
+  typedef ContentStoreImpl< ndnSIM::multi_policy_traits< boost::mpl::vector2< Policy, ndnSIM::prefix_hash_policy_traits > > > super;
+
+  typedef typename super::policy_container::template index<1>::type prefix_hash_policy_container;
+
+  static TypeId
+  GetTypeId ();
+
+protected:
+  virtual typename super::super::iterator
+  FindMatch (const Interest &interest);
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+TypeId
+ContentStoreWithPrefixHash< Policy >::GetTypeId ()
+{
+  static TypeId tid = TypeId (("ns3::ndn::cs::PrefixHash::"+Policy::GetName ()).c_str ())
+    .SetGroupName ("Ndn")
+    .SetParent<super> ()
+    .template AddConstructor< ContentStoreWithPrefixHash< Policy > > ()
+    ;
+
+  return tid;
+}
+
+template<class Policy>
+typename ContentStoreWithPrefixHash< Policy >::super::super::iterator
+ContentStoreWithPrefixHash< Policy >::FindMatch (const Interest &interest)
+{
+  prefix_hash_policy_container &index = this->GetPolicy ().template get<prefix_hash_policy_container> ();
+
+  if (interest.GetExclude () == 0)
+    {
+      return index.deepest_prefix_match (interest.GetName ());
+    }
+  else
+    {
+      if (!index.may_contain_prefix (interest.GetName ()))
+        return 0;
+
+      return super::FindMatch (interest);
+    }
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_WITH_PREFIX_HASH_H_
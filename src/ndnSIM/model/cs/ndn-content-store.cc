@@ -66,6 +66,10 @@ Entry::Entry (Ptr<ContentStore> cs, Ptr<const Data> data)
 {
 }
 
+Entry::~Entry ()
+{
+}
+
 const Name&
 Entry::GetName () const
 {
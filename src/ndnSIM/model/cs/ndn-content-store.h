@@ -68,6 +68,12 @@ public:
    */
   Entry (Ptr<ContentStore> cs, Ptr<const Data> data);
 
+  /**
+   * \brief Virtual destructor (entries of some implementations are referenced only through the base class)
+   */
+  virtual
+  ~Entry ();
+
   /**
    * \brief Get prefix of the stored entry
    * \returns prefix of the stored entry
@@ -127,6 +133,9 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * Returned Data can be an overlay of the cached object (\see Data::CreateOverlay),
+   * so only its per-transmission state should be modified
    */
   virtual Ptr<Data>
   Lookup (Ptr<const Interest> interest) = 0;
@@ -50,6 +50,22 @@ struct FaceMetricByFace
   type;
 };
 
+/**
+ * @brief Move record in random access index to the same position as in by metric index
+ *
+ * Other records should already be in the same order in both indexes
+ */
+static void
+RelocateNth (FaceMetricContainer::type &faces, FaceMetricByFace::type::iterator record)
+{
+  FaceMetricContainer::type::index<i_metric>::type::iterator next = faces.project<i_metric> (record);
+  next++;
+
+  FaceMetricContainer::type::index<i_nth>::type &nth = faces.get<i_nth> ();
+  nth.relocate (next == faces.get<i_metric> ().end () ? nth.end () : faces.project<i_nth> (next),
+                faces.project<i_nth> (record));
+}
+
 
 void
 FaceMetric::UpdateRtt (const Time &rttSample)
@@ -83,11 +99,9 @@ Entry::UpdateFaceRtt (Ptr<Face> face, const Time &sample)
       return;
     }
 
-  m_faces.modify (record,
-                  ll::bind (&FaceMetric::UpdateRtt, ll::_1, sample));
-
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+  // RTT is not a part of any index key, so the record can be updated in place and face ranking
+  // does not change
+  const_cast<FaceMetric &> (*record).UpdateRtt (sample);
 }
 
 void
@@ -101,11 +115,15 @@ Entry::UpdateStatus (Ptr<Face> face, FaceMetric::Status status)
       return;
     }
 
+  if (record->GetStatus () == status)
+    {
+      return; // most of the updates (e.g., on each Data packet) do not change the ranking
+    }
+
   m_faces.modify (record,
                   ll::bind (&FaceMetric::SetStatus, ll::_1, status));
 
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+  RelocateNth (m_faces, record);
 }
 
 void
@@ -117,7 +135,7 @@ Entry::AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric)
   FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
   if (record == m_faces.get<i_face> ().end ())
     {
-      m_faces.insert (FaceMetric (face, metric));
+      record = m_faces.insert (FaceMetric (face, metric)).first;
     }
   else
   {
@@ -130,10 +148,13 @@ Entry::AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric)
         m_faces.modify (record,
                         ll::bind (&FaceMetric::SetStatus, ll::_1, FaceMetric::NDN_FIB_YELLOW));
       }
+    else
+      {
+        return;
+      }
   }
 
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+  RelocateNth (m_faces, record);
 }
 
 void
@@ -164,6 +185,9 @@ Entry::Invalidate ()
       m_faces.modify (face,
                       ll::bind (&FaceMetric::SetStatus, ll::_1, FaceMetric::NDN_FIB_RED));
     }
+
+  // reordering random access index same way as by metric index
+  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
 }
 
 const FaceMetric &
@@ -0,0 +1,286 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-fib-name-table.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-forwarding-strategy.h"
+
+#include "ns3/node.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <boost/ref.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.fib.FibNameTable");
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+NS_OBJECT_ENSURE_REGISTERED (FibNameTable);
+
+TypeId
+FibNameTable::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fib::NameTable") // cheating ns3 object system
+    .SetParent<Fib> ()
+    .SetGroupName ("Ndn")
+    .AddConstructor<FibNameTable> ()
+  ;
+  return tid;
+}
+
+FibNameTable::FibNameTable ()
+  : m_size (0)
+{
+}
+
+void
+FibNameTable::DoDispose (void)
+{
+  if (m_nameTable != 0)
+    {
+      Ptr<Entry> entry = Begin ();
+      while (entry != End ())
+        {
+          Ptr<Entry> nextEntry = Next (entry);
+          Erase (entry);
+          entry = nextEntry;
+        }
+    }
+  m_nameTable = 0;
+
+  Object::DoDispose ();
+}
+
+Ptr<NameTable>
+FibNameTable::GetNameTable ()
+{
+  if (m_nameTable == 0)
+    {
+      m_nameTable = NameTable::GetNameTable (this);
+    }
+  return m_nameTable;
+}
+
+Ptr<Entry>
+FibNameTable::LongestPrefixMatch (const Interest &interest)
+{
+  // @todo use predicate to search with exclude filters
+  const std::vector<NameTable::iterator> &path = GetNameTable ()->Walk (interest.GetName ());
+  for (size_t i = path.size (); i > 0; i--)
+    {
+      const Ptr<Entry> &entry = path[i-1]->payload ().m_fibEntry;
+      if (entry != 0)
+        return entry;
+    }
+
+  return 0;
+}
+
+Ptr<fib::Entry>
+FibNameTable::Find (const Name &prefix)
+{
+  const std::vector<NameTable::iterator> &path = GetNameTable ()->Walk (prefix);
+  if (path.size () != prefix.size () + 1)
+    return 0;
+  else
+    return path.back ()->payload ().m_fibEntry;
+}
+
+Ptr<Entry>
+FibNameTable::Add (const Name &prefix, Ptr<Face> face, int32_t metric)
+{
+  return Add (Create<Name> (prefix), face, metric);
+}
+
+Ptr<Entry>
+FibNameTable::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix) << boost::cref(*face) << metric);
+
+  // will add entry if doesn't exists, or just return the existing entry
+  NameTable::iterator node = GetNameTable ()->Insert (*prefix);
+  bool isNew = (node->payload ().m_fibEntry == 0);
+  if (isNew)
+    {
+      Ptr<NameTableEntryImpl> newEntry = Create<NameTableEntryImpl> (this, prefix);
+      newEntry->SetNode (node);
+      node->payload ().m_fibEntry = newEntry;
+      m_size ++;
+    }
+
+  Ptr<Entry> entry = node->payload ().m_fibEntry;
+  entry->AddOrUpdateRoutingMetric (face, metric);
+
+  if (isNew)
+    {
+      // notify forwarding strategy about new FIB entry
+      NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+      this->GetObject<ForwardingStrategy> ()->DidAddFibEntry (entry);
+    }
+
+  return entry;
+}
+
+void
+FibNameTable::Remove (const Ptr<const Name> &prefix)
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix));
+
+  Ptr<Entry> entry = Find (*prefix);
+  if (entry != 0)
+    {
+      // notify forwarding strategy about soon be removed FIB entry
+      NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+      this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (entry);
+
+      Erase (entry);
+    }
+  // else do nothing
+}
+
+void
+FibNameTable::Erase (Ptr<Entry> entry)
+{
+  NameTable::iterator node = StaticCast<NameTableEntryImpl> (entry)->GetNode ();
+  StaticCast<NameTableEntryImpl> (entry)->SetNode (0);
+
+  node->payload ().m_fibEntry = 0;
+  m_size --;
+
+  m_nameTable->Prune (node);
+}
+
+void
+FibNameTable::InvalidateAll ()
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId ());
+
+  for (Ptr<Entry> entry = Begin (); entry != End (); entry = Next (entry))
+    {
+      entry->Invalidate ();
+    }
+}
+
+void
+FibNameTable::RemoveFromAll (Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<Entry> entry = Begin ();
+  while (entry != End ())
+    {
+      entry->RemoveFace (face);
+      if (entry->m_faces.size () == 0)
+        {
+          Ptr<Entry> nextEntry = Next (entry);
+
+          // notify forwarding strategy about soon be removed FIB entry
+          NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+          this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (entry);
+
+          Erase (entry);
+          entry = nextEntry;
+        }
+      else
+        {
+          entry = Next (entry);
+        }
+    }
+}
+
+void
+FibNameTable::Print (std::ostream &os) const
+{
+  // !!! unordered_set imposes "random" order of item in the same level !!!
+  for (Ptr<const Entry> entry = Begin (); entry != End (); entry = Next (entry))
+    {
+      os << entry->GetPrefix () << "\t" << *entry << "\n";
+    }
+}
+
+uint32_t
+FibNameTable::GetSize () const
+{
+  return m_size;
+}
+
+Ptr<Entry>
+FibNameTable::FindNext (NameTable::trie::recursive_iterator item)
+{
+  NameTable::trie::recursive_iterator end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload ().m_fibEntry != 0)
+        return item->payload ().m_fibEntry;
+    }
+
+  return End ();
+}
+
+Ptr<const Entry>
+FibNameTable::Begin () const
+{
+  return const_cast<FibNameTable*> (this)->Begin ();
+}
+
+Ptr<const Entry>
+FibNameTable::End () const
+{
+  return 0;
+}
+
+Ptr<const Entry>
+FibNameTable::Next (Ptr<const Entry> from) const
+{
+  return const_cast<FibNameTable*> (this)->Next (ConstCast<Entry> (from));
+}
+
+Ptr<Entry>
+FibNameTable::Begin ()
+{
+  if (m_nameTable == 0)
+    return End ();
+
+  return FindNext (NameTable::trie::recursive_iterator (m_nameTable->GetTrie ()));
+}
+
+Ptr<Entry>
+FibNameTable::End ()
+{
+  return 0;
+}
+
+Ptr<Entry>
+FibNameTable::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  NameTable::trie::recursive_iterator item (StaticCast<NameTableEntryImpl> (from)->GetNode ());
+  item++;
+  return FindNext (item);
+}
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
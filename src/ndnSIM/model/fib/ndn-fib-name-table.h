@@ -0,0 +1,150 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_FIB_NAME_TABLE_H_
+#define _NDN_FIB_NAME_TABLE_H_
+
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-name.h"
+
+#include "../ndn-name-table.h"
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+/**
+ * @ingroup ndn-fib
+ * @brief FIB entry implementation with a reference to the node of the name table
+ */
+class NameTableEntryImpl : public Entry
+{
+public:
+  NameTableEntryImpl (Ptr<Fib> fib, const Ptr<const Name> &prefix)
+    : Entry (fib, prefix)
+    , node_ (0)
+  {
+  }
+
+  void
+  SetNode (NameTable::iterator node) { node_ = node; }
+
+  NameTable::iterator GetNode () { return node_; }
+  NameTable::const_iterator GetNode () const { return node_; }
+
+private:
+  NameTable::iterator node_;
+};
+
+/**
+ * @ingroup ndn-fib
+ * @brief FIB realization that keeps its entries in the name table shared with PIT and
+ * ContentStore (see ndn::NameTable)
+ */
+class FibNameTable : public Fib
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Constructor
+   */
+  FibNameTable ();
+
+  virtual Ptr<Entry>
+  LongestPrefixMatch (const Interest &interest);
+
+  virtual Ptr<fib::Entry>
+  Find (const Name &prefix);
+
+  virtual Ptr<Entry>
+  Add (const Name &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual Ptr<Entry>
+  Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual void
+  Remove (const Ptr<const Name> &prefix);
+
+  virtual void
+  InvalidateAll ();
+
+  virtual void
+  RemoveFromAll (Ptr<Face> face);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<const Entry>
+  Begin () const;
+
+  virtual Ptr<Entry>
+  Begin ();
+
+  virtual Ptr<const Entry>
+  End () const;
+
+  virtual Ptr<Entry>
+  End ();
+
+  virtual Ptr<const Entry>
+  Next (Ptr<const Entry> item) const;
+
+  virtual Ptr<Entry>
+  Next (Ptr<Entry> item);
+
+protected:
+  // inherited from Object class
+  virtual void DoDispose (); ///< @brief Perform cleanup
+
+private:
+  Ptr<NameTable>
+  GetNameTable ();
+
+  /**
+   * @brief Remove entry from the name table
+   */
+  void
+  Erase (Ptr<Entry> entry);
+
+  /**
+   * @brief Find the first node with FIB entry, starting from the node (inclusive) in depth-first order
+   */
+  Ptr<Entry>
+  FindNext (NameTable::trie::recursive_iterator item);
+
+private:
+  Ptr<NameTable> m_nameTable;
+  uint32_t m_size;
+};
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_FIB_NAME_TABLE_H_
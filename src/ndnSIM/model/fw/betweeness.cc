@@ -97,7 +97,7 @@ void Betweeness::OnInterest(Ptr<Face> inFace, Ptr<Interest> interest)
 	      FwHopCountTag hopCountTag;
 	      if (interest->GetPayload ()->PeekPacketTag (hopCountTag))
 	        {
-	          contentObject->GetPayload ()->AddPacketTag (hopCountTag);
+	          contentObject->SetHopCountTag (hopCountTag);
 	        }
 
 	      pitEntry->AddIncoming (inFace/*, Seconds (1.0)*/);
@@ -129,7 +129,8 @@ Nacks::DidExhaustForwardingOptions (Ptr<Face> inFace,
       Ptr<Interest> nack = Create<Interest> (*interest);
       nack->SetNack (Interest::NACK_GIVEUP_PIT);
 
-      BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
+      pit::Entry::in_container incomingFaces = pitEntry->GetIncoming (); // faces can be modified while sending NACKs
+      BOOST_FOREACH (const pit::IncomingFace &incoming, incomingFaces)
         {
           NS_LOG_DEBUG ("Send NACK for " << boost::cref (nack->GetName ()) << " to " << boost::cref (*incoming.m_face));
           incoming.m_face->SendInterest (nack);
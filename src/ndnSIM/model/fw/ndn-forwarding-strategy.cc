@@ -44,6 +44,8 @@
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
 #include <boost/tuple/tuple.hpp>
+
+#include <map>
 namespace ll = boost::lambda;
 
 namespace ns3 {
@@ -104,11 +106,18 @@ TypeId ForwardingStrategy::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&ForwardingStrategy::m_detectRetransmissions),
                    MakeBooleanChecker ())
+
+    .AddAttribute ("BatchInterests", "If true, Interests received within the same simulation time are processed "
+                                     "together in one event, grouped by name",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ForwardingStrategy::m_batchInterests),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
 
 ForwardingStrategy::ForwardingStrategy ()
+  : m_batchInterests (false)
 {
 }
 
@@ -142,9 +151,78 @@ ForwardingStrategy::DoDispose ()
   m_contentStore = 0;
   m_fib = 0;
 
+  Simulator::Remove (m_interestBatchEvent);
+  m_interestBatch.clear ();
+
   Object::DoDispose ();
 }
 
+void
+ForwardingStrategy::ReceiveInterest (Ptr<Face> inFace,
+                                     Ptr<Interest> interest)
+{
+  if (!m_batchInterests)
+    {
+      OnInterest (inFace, interest);
+      return;
+    }
+
+  m_interestBatch.push_back (std::make_pair (inFace, interest));
+  if (!m_interestBatchEvent.IsRunning ())
+    {
+      m_interestBatchEvent = Simulator::ScheduleNow (&ForwardingStrategy::ProcessInterestBatch, this);
+    }
+}
+
+void
+ForwardingStrategy::ProcessInterestBatch ()
+{
+  std::vector< std::pair< Ptr<Face>, Ptr<Interest> > > batch;
+  batch.swap (m_interestBatch); // Interests received while processing will form the next batch
+
+  NS_LOG_FUNCTION (this << batch.size ());
+
+  // Group Interests with the same name, so they are processed one after another.  With
+  // the unified name table (ndn::NameTable), PIT lookup, CS lookup, and FIB longest
+  // prefix match for all Interests of the group reuse the same cached walk, i.e., the
+  // table is walked only once per distinct name.  With other realizations, all but the
+  // first Interest of the group find the PIT entry created by the first one.  Groups are
+  // processed in the order of their first Interest, and Interests within a group in the
+  // order of arrival.  The full-name hash is only used to find candidate groups.
+  typedef std::map< size_t, std::vector<size_t> > GroupsByHash; // hash -> indexes of the groups
+  GroupsByHash groupsByHash;
+  std::vector< std::vector<size_t> > groups; // indexes of the Interests in the batch
+  for (size_t i = 0; i < batch.size (); i++)
+    {
+      const Name &name = batch[i].second->GetName ();
+      std::vector<size_t> &candidates = groupsByHash [name.getPrefixHash (name.size ())];
+
+      std::vector<size_t>::iterator group = candidates.begin ();
+      for (; group != candidates.end (); group++)
+        {
+          if (batch[groups[*group].front ()].second->GetName () == name)
+            break;
+        }
+
+      if (group != candidates.end ())
+        groups[*group].push_back (i);
+      else
+        {
+          candidates.push_back (groups.size ());
+          groups.push_back (std::vector<size_t> (1, i));
+        }
+    }
+
+  for (size_t group = 0; group < groups.size (); group++)
+    {
+      for (size_t item = 0; item < groups[group].size (); item++)
+        {
+          const std::pair< Ptr<Face>, Ptr<Interest> > &interest = batch[groups[group][item]];
+          OnInterest (interest.first, interest.second);
+        }
+    }
+}
+
 void
 ForwardingStrategy::OnInterest (Ptr<Face> inFace,
                                 Ptr<Interest> interest)
@@ -189,7 +267,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
       FwHopCountTag hopCountTag;
       if (interest->GetPayload ()->PeekPacketTag (hopCountTag))
         {
-          contentObject->GetPayload ()->AddPacketTag (hopCountTag);
+          contentObject->SetHopCountTag (hopCountTag);
         }
 
       pitEntry->AddIncoming (inFace/*, Seconds (1.0)*/);
@@ -366,7 +444,9 @@ ForwardingStrategy::SatisfyPendingInterest (Ptr<Face> inFace,
     pitEntry->RemoveIncoming (inFace);
 
   //satisfy all pending incoming Interests
-  BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
+  // (iterate over a copy, as application faces can modify the PIT entry while processing Data)
+  pit::Entry::in_container incomingFaces = pitEntry->GetIncoming ();
+  BOOST_FOREACH (const pit::IncomingFace &incoming, incomingFaces)
     {
       bool ok = incoming.m_face->SendData (data);
 
@@ -582,7 +662,15 @@ ForwardingStrategy::AddFace (Ptr<Face> face)
 void
 ForwardingStrategy::RemoveFace (Ptr<Face> face)
 {
-  // do nothing here
+  // drop Interests from the face that have not been processed yet
+  std::vector< std::pair< Ptr<Face>, Ptr<Interest> > >::iterator item = m_interestBatch.begin ();
+  while (item != m_interestBatch.end ())
+    {
+      if (item->first == face)
+        item = m_interestBatch.erase (item);
+      else
+        item ++;
+    }
 }
 
 void
@@ -25,6 +25,9 @@
 #include "ns3/callback.h"
 #include "ns3/object.h"
 #include "ns3/traced-callback.h"
+#include "ns3/event-id.h"
+
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -75,6 +78,23 @@ public:
   ForwardingStrategy ();
   virtual ~ForwardingStrategy ();
 
+  /**
+   * @brief Entry point for Interests received on the faces
+   *
+   * If BatchInterests attribute is not set, the Interest is immediately processed by OnInterest.
+   * Otherwise, the Interest is queued, and all Interests received within the same simulation
+   * time are processed (each one by OnInterest) in one event, scheduled when the first of them
+   * is received.  Interests for the same name are processed one after another, so with the
+   * unified name table (ndn::NameTable) PIT, CS, and FIB lookups for all of them share a single
+   * walk through the table.
+   *
+   * @param face     incoming face
+   * @param interest Interest packet
+   */
+  void
+  ReceiveInterest (Ptr<Face> face,
+                   Ptr<Interest> interest);
+
   /**
    * \brief Actual processing of incoming Ndn interests. Note, interests do not have payload
    *
@@ -433,6 +453,13 @@ protected:
   virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
   virtual void DoDispose (); ///< @brief Do cleanup
 
+private:
+  /**
+   * @brief Process all queued Interests (BatchInterests mode)
+   */
+  void
+  ProcessInterestBatch ();
+
 protected:
   Ptr<Pit> m_pit; ///< \brief Reference to PIT to which this forwarding strategy is associated
   Ptr<Fib> m_fib; ///< \brief FIB
@@ -442,6 +469,10 @@ protected:
   bool m_cacheUnsolicitedData;
   bool m_detectRetransmissions;
 
+  bool m_batchInterests;
+  std::vector< std::pair< Ptr<Face>, Ptr<Interest> > > m_interestBatch; ///< @brief Interests queued for processing (BatchInterests mode)
+  EventId m_interestBatchEvent;
+
   TracedCallback<Ptr<const Interest>,
                  Ptr<const Face> > m_outInterests; ///< @brief Transmitted interests trace
 
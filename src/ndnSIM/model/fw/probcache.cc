@@ -100,7 +100,7 @@ void Probcache::OnInterest(Ptr<Face> inFace, Ptr<Interest> interest)
 	      FwHopCountTag hopCountTag;
 	      if (interest->GetPayload ()->PeekPacketTag (hopCountTag))
 	        {
-	          contentObject->GetPayload ()->AddPacketTag (hopCountTag);
+	          contentObject->SetHopCountTag (hopCountTag);
 	        }
 
 	      pitEntry->AddIncoming (inFace/*, Seconds (1.0)*/);
@@ -39,6 +39,8 @@ Data::Data (Ptr<Packet> payload/* = Create<Packet> ()*/)
   , m_timeSinceInception (0)
   , m_maxBetweeness (0)
   , m_wire (0)
+  , m_overlay (false)
+  , m_hasHopCountTag (false)
 {
   if (m_payload == 0) // just in case
     {
@@ -56,11 +58,44 @@ Data::Data (const Data &other)
   , m_timeSinceInception (other.GetTimeSinceInception())
   , m_maxBetweeness (other.GetMaxBetweeness())
   , m_wire (0)
+  , m_overlay (false)
+  , m_hasHopCountTag (other.m_hasHopCountTag)
+  , m_hopCountTag (other.m_hopCountTag)
 {
   if (other.GetKeyLocator ())
     {
       m_keyLocator = Create<Name> (*other.GetKeyLocator ());
     }
+
+  if (other.IsOverlay ())
+    {
+      // tags of the shared payload do not belong to the overlay
+      m_payload->RemoveAllPacketTags ();
+    }
+}
+
+Ptr<Data>
+Data::CreateOverlay () const
+{
+  Ptr<Data> overlay = Create<Data> (m_payload);
+  overlay->m_name = m_name;
+  overlay->m_freshness = m_freshness;
+  overlay->m_timestamp = m_timestamp;
+  overlay->m_signature = m_signature;
+  overlay->m_keyLocator = m_keyLocator;
+  overlay->m_timeSinceInception = m_timeSinceInception;
+  overlay->m_timeSinceBirth = m_timeSinceBirth;
+  overlay->m_maxBetweeness = m_maxBetweeness;
+  overlay->m_wire = m_wire;
+  overlay->m_overlay = true;
+
+  return overlay;
+}
+
+bool
+Data::IsOverlay () const
+{
+  return m_overlay;
 }
 
 void
@@ -143,6 +178,21 @@ Data::GetKeyLocator () const
   return m_keyLocator;
 }
 
+void
+Data::SetHopCountTag (const FwHopCountTag &tag)
+{
+  m_hopCountTag = tag;
+  m_hasHopCountTag = true;
+}
+
+bool
+Data::PeekHopCountTag (FwHopCountTag &tag) const
+{
+  if (m_hasHopCountTag)
+    tag = m_hopCountTag;
+  return m_hasHopCountTag;
+}
+
 void
 Data::Print (std::ostream &os) const
 {
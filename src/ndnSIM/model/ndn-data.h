@@ -28,6 +28,7 @@
 #include "ns3/ptr.h"
 
 #include <ns3/ndn-name.h>
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
 namespace ns3 {
 namespace ndn {
@@ -51,6 +52,25 @@ public:
    */
   Data (const Data &other);
 
+  /**
+   * @brief Create a lightweight copy of the Data packet for a single transmission
+   *
+   * Unlike the copy constructor, the returned object shares name, key locator, payload,
+   * and cached wire format with the original, which should not be modified afterwards
+   * (e.g., Data stored in the content store).  Only per-transmission state can be
+   * changed on the overlay: TSI, TSB, MaxBetweeness fields and the hop count tag (see
+   * SetHopCountTag).  Packet tags of the original payload are not attached to the
+   * wire-formatted packets of the overlay.
+   */
+  Ptr<Data>
+  CreateOverlay () const;
+
+  /**
+   * @brief Check if the object is an overlay, created with CreateOverlay
+   */
+  bool
+  IsOverlay () const;
+
   /**
    * \brief Set content object name
    *
@@ -204,6 +224,21 @@ public:
   uint8_t
   GetMaxBetweeness () const;
 
+  /**
+   * @brief Set hop count tag that will be attached to the wire-formatted packet
+   *
+   * The tag replaces hop count tag of the payload (if any), without modifying the payload
+   */
+  void
+  SetHopCountTag (const FwHopCountTag &tag);
+
+  /**
+   * @brief Get hop count tag set with SetHopCountTag
+   * @returns false if hop count tag was not set
+   */
+  bool
+  PeekHopCountTag (FwHopCountTag &tag) const;
+
   /**
    * @brief Print Interest in plain-text to the specified output stream
    */
@@ -228,6 +263,11 @@ private:
   uint8_t m_maxBetweeness; // New field added for betweeness centrality strategy
 
   mutable Ptr<const Packet> m_wire;
+
+  // per-transmission state
+  bool m_overlay; ///< @brief name, payload, and key locator are shared with another Data object
+  bool m_hasHopCountTag;
+  FwHopCountTag m_hopCountTag;
 };
 
 inline std::ostream &
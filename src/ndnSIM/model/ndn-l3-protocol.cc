@@ -130,7 +130,7 @@ L3Protocol::AddFace (const Ptr<Face> &face)
   face->SetId (m_faceCounter); // sets a unique ID of the face. This ID serves only informational purposes
 
   // ask face to register in lower-layer stack
-  face->RegisterProtocolHandlers (MakeCallback (&ForwardingStrategy::OnInterest, m_forwardingStrategy),
+  face->RegisterProtocolHandlers (MakeCallback (&ForwardingStrategy::ReceiveInterest, m_forwardingStrategy),
                                   MakeCallback (&ForwardingStrategy::OnData, m_forwardingStrategy));
 
   m_faces.push_back (face);
@@ -0,0 +1,138 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-name-table.h"
+
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NameTable");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (NameTable);
+
+TypeId
+NameTable::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::NameTable")
+    .SetGroupName ("Ndn")
+    .SetParent<Object> ()
+    .AddConstructor<NameTable> ()
+    ;
+  return tid;
+}
+
+NameTable::NameTable ()
+  : m_trie (name::Component ())
+  , m_walkValid (false)
+  , m_walkCount (0)
+{
+}
+
+NameTable::~NameTable ()
+{
+}
+
+const std::vector<NameTable::iterator> &
+NameTable::Walk (const Name &name)
+{
+  if (m_walkValid &&
+      m_walkName.size () == name.size () &&
+      m_walkName.getPrefixHash (name.size ()) == name.getPrefixHash (name.size ()) &&
+      m_walkName == name)
+    {
+      return m_walkPath;
+    }
+
+  m_walkName = name;
+  m_walkValid = true;
+  m_walkCount ++;
+
+  m_walkPath.clear ();
+  iterator node = &m_trie;
+  m_walkPath.push_back (node);
+  for (Name::const_iterator component = name.begin (); component != name.end (); component++)
+    {
+      node = node->find_child (*component);
+      if (node == 0)
+        break;
+
+      m_walkPath.push_back (node);
+    }
+
+  return m_walkPath;
+}
+
+NameTable::iterator
+NameTable::Insert (const Name &name)
+{
+  Walk (name);
+  if (m_walkPath.size () == name.size () + 1)
+    return m_walkPath.back ();
+
+  // create missing nodes, the cached walk stays valid for the name
+  for (Name::const_iterator component = name.begin () + (m_walkPath.size () - 1);
+       component != name.end ();
+       component++)
+    {
+      m_walkPath.push_back (m_walkPath.back ()->insert_child (*component));
+    }
+
+  return m_walkPath.back ();
+}
+
+void
+NameTable::Prune (iterator node)
+{
+  if (node->prune () != node)
+    {
+      // some nodes were removed, cached walk cannot be trusted anymore
+      m_walkValid = false;
+    }
+}
+
+uint32_t
+NameTable::GetNodeCount () const
+{
+  uint32_t count = 0;
+  trie::const_recursive_iterator item (m_trie), end (0);
+  for (; item != end; item++)
+    {
+      count ++;
+    }
+  return count;
+}
+
+Ptr<NameTable>
+NameTable::GetNameTable (Ptr<Object> object)
+{
+  Ptr<NameTable> table = object->GetObject<NameTable> ();
+  if (table == 0)
+    {
+      NS_LOG_DEBUG ("Creating name table");
+      table = CreateObject<NameTable> ();
+      object->AggregateObject (table);
+    }
+  return table;
+}
+
+} // namespace ndn
+} // namespace ns3
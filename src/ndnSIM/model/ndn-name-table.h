@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_NAME_TABLE_H_
+#define _NDN_NAME_TABLE_H_
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include "ns3/ndn-name.h"
+#include "ns3/ndn-fib-entry.h"
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-content-store.h"
+
+#include "../utils/trie/trie.h"
+#include "../utils/trie/free-list-allocator.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+namespace name_table {
+
+/**
+ * @ingroup ndn
+ * @brief Payload of the name table node: FIB, PIT, and CS entries for the same name
+ *
+ * Each table links its entries into its own replacement policy container, so the node
+ * itself does not carry any policy hooks.
+ */
+struct Entry
+{
+  Ptr<fib::Entry> m_fibEntry; ///< @brief FIB entry for the name (0 if none)
+  Ptr<pit::Entry> m_pitEntry; ///< @brief PIT entry for the name (0 if none)
+  Ptr<cs::Entry>  m_csEntry;  ///< @brief cached Data with the name (0 if none)
+
+  inline bool
+  operator == (const Entry &other) const
+  {
+    return m_fibEntry == other.m_fibEntry && m_pitEntry == other.m_pitEntry && m_csEntry == other.m_csEntry;
+  }
+
+  inline bool
+  operator != (const Entry &other) const
+  {
+    return !(*this == other);
+  }
+};
+
+/// @brief Name table nodes are not linked into any policy container
+struct no_policy_hook { };
+
+} // namespace name_table
+
+/**
+ * @ingroup ndn
+ * @brief Name prefix table shared by FIB, PIT, and ContentStore of the node
+ *
+ * Name table based FIB, PIT, and ContentStore realizations (ns3::ndn::fib::NameTable,
+ * ns3::ndn::pit::NameTable::*, and ns3::ndn::cs::NameTable::*, see
+ * ndn::StackHelper::SetNameTable) keep their entries in the nodes of one trie, so
+ * prefixes used by several tables are stored only once.
+ *
+ * The result of the last walk is cached, and all lookups for the same name (e.g., PIT,
+ * CS, and FIB lookups while processing one Interest) reuse the same walk as long as no
+ * nodes are added to or removed from the trie.
+ */
+class NameTable : public Object
+{
+public:
+  typedef ndnSIM::trie< Name,
+                        ndnSIM::non_pointer_traits< name_table::Entry >,
+                        name_table::no_policy_hook,
+                        ndnSIM::free_list_allocator_traits > trie;
+
+  typedef trie::iterator iterator;
+  typedef trie::const_iterator const_iterator;
+
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  NameTable ();
+
+  /**
+   * @brief Virtual destructor
+   */
+  virtual ~NameTable ();
+
+  /**
+   * @brief Get nodes for all prefixes of the name that exist in the table
+   *
+   * Element i of the returned vector is the node for the first i components of the name,
+   * i.e., the vector contains name.size () + 1 elements if the node for the whole name
+   * exists.  The vector is valid until the next call to Walk, Insert, or Prune.
+   */
+  const std::vector<iterator> &
+  Walk (const Name &name);
+
+  /**
+   * @brief Get node for the name, creating it (and nodes for all its prefixes) if necessary
+   */
+  iterator
+  Insert (const Name &name);
+
+  /**
+   * @brief Remove the node if it has no entries and no children (parent nodes are pruned as well)
+   */
+  void
+  Prune (iterator node);
+
+  /**
+   * @brief Get root node of the trie
+   */
+  const trie &
+  GetTrie () const { return m_trie; }
+
+  /**
+   * @brief Get root node of the trie
+   */
+  trie &
+  GetTrie () { return m_trie; }
+
+  /**
+   * @brief Get total number of nodes in the trie (including the root node)
+   */
+  uint32_t
+  GetNodeCount () const;
+
+  /**
+   * @brief Get number of actual walks through the trie (walks served from the cache are not counted)
+   */
+  uint32_t
+  GetWalkCount () const { return m_walkCount; }
+
+  /**
+   * @brief Get name table aggregated to the object, aggregating a new one if there is none yet
+   */
+  static Ptr<NameTable>
+  GetNameTable (Ptr<Object> object);
+
+private:
+  trie m_trie;
+
+  // cached result of the last walk
+  Name m_walkName;
+  std::vector<iterator> m_walkPath;
+  bool m_walkValid;
+  uint32_t m_walkCount;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_NAME_TABLE_H_
@@ -27,12 +27,15 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
 
 // #include "ns3/address.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 #include "ns3/ndn-name.h"
 
+#include "ns3/ndn-decoded-packet-cache.h"
+
 NS_LOG_COMPONENT_DEFINE ("ndn.NetDeviceFace");
 
 namespace ns3 {
@@ -46,6 +49,13 @@ NetDeviceFace::GetTypeId ()
   static TypeId tid = TypeId ("ns3::ndn::NetDeviceFace")
     .SetParent<Face> ()
     .SetGroupName ("Ndn")
+    .AddAttribute ("DecodeOnce",
+                   "If true, Interests and Data that are forwarded unmodified are decoded only on "
+                   "the first hop and reused from DecodedPacketCache afterwards. If false, "
+                   "every received packet is fully decoded",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NetDeviceFace::m_decodeOnce),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
@@ -57,6 +67,7 @@ NetDeviceFace::GetTypeId ()
 NetDeviceFace::NetDeviceFace (Ptr<Node> node, const Ptr<NetDevice> &netDevice)
   : Face (node)
   , m_netDevice (netDevice)
+  , m_decodeOnce (false)
 {
   NS_LOG_FUNCTION (this << netDevice);
 
@@ -119,6 +130,50 @@ NetDeviceFace::Send (Ptr<Packet> packet)
   return ok;
 }
 
+bool
+NetDeviceFace::Receive (Ptr<const Packet> p)
+{
+  if (!m_decodeOnce || !IsUp ())
+    {
+      return Face::Receive (p);
+    }
+
+  Ptr<Packet> packet = p->Copy ();
+  Ptr<Interest> interest;
+  Ptr<Data> data;
+  if (DecodedPacketCache::Lookup (packet, interest, data))
+    {
+      if (interest != 0)
+        return ReceiveInterest (interest);
+      else
+        return ReceiveData (data);
+    }
+
+  return Face::Receive (packet);
+}
+
+bool
+NetDeviceFace::ReceiveInterest (Ptr<Interest> interest)
+{
+  if (m_decodeOnce)
+    {
+      DecodedPacketCache::AddInterest (interest);
+    }
+
+  return Face::ReceiveInterest (interest);
+}
+
+bool
+NetDeviceFace::ReceiveData (Ptr<Data> data)
+{
+  if (m_decodeOnce)
+    {
+      DecodedPacketCache::AddData (data);
+    }
+
+  return Face::ReceiveData (data);
+}
+
 // callback
 void
 NetDeviceFace::ReceiveFromNetDevice (Ptr<NetDevice> device,
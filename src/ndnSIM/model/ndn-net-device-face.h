@@ -64,11 +64,20 @@ public:
 
   virtual void
   UnRegisterProtocolHandlers ();
+
+  virtual bool
+  ReceiveInterest (Ptr<Interest> interest);
+
+  virtual bool
+  ReceiveData (Ptr<Data> data);
   
 protected:
   virtual bool
   Send (Ptr<Packet> p);
 
+  virtual bool
+  Receive (Ptr<const Packet> p);
+
 public:
   /**
    * @brief Print out name of the NdnFace to the stream
@@ -98,6 +107,7 @@ private:
 
 private:
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
+  bool m_decodeOnce; ///< \brief reuse decoded packets from DecodedPacketCache instead of decoding them
 };
 
 } // namespace ndn
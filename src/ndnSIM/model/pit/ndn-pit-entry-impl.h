@@ -28,6 +28,9 @@ class Pit;
 
 namespace pit {
 
+/// @brief Hook to keep PIT entry in a slot of the expiration timer wheel
+typedef boost::intrusive::list_member_hook< boost::intrusive::link_mode<boost::intrusive::auto_unlink> > wheel_hook;
+
 /**
  * @ingroup ndn-pit
  * @brief PIT entry implementation with additional pointers to the underlying container
@@ -48,12 +51,24 @@ public:
   : Entry (pit, header, fibEntry)
   , item_ (0)
   {
+    if (CONTAINER.IsWheelEnabled ())
+      {
+        CONTAINER.WheelInsert (*this);
+        return;
+      }
+
     CONTAINER.i_time.insert (*this);
     CONTAINER.RescheduleCleaning ();
   }
   
   virtual ~EntryImpl ()
   {
+    if (CONTAINER.IsWheelEnabled ())
+      {
+        wheel_hook_.unlink ();
+        return;
+      }
+
     CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
     
     CONTAINER.RescheduleCleaning ();
@@ -62,6 +77,14 @@ public:
   virtual void
   UpdateLifetime (const Time &offsetTime)
   {
+    if (CONTAINER.IsWheelEnabled ())
+      {
+        // lifetime can only be extended, the entry will be moved to the right slot
+        // when its current slot is processed
+        super::UpdateLifetime (offsetTime);
+        return;
+      }
+
     CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
     super::UpdateLifetime (offsetTime);
     CONTAINER.i_time.insert (*this);
@@ -72,6 +95,14 @@ public:
   virtual void
   OffsetLifetime (const Time &offsetTime)
   {
+    if (CONTAINER.IsWheelEnabled ())
+      {
+        wheel_hook_.unlink ();
+        super::OffsetLifetime (offsetTime);
+        CONTAINER.WheelInsert (*this);
+        return;
+      }
+
     CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
     super::OffsetLifetime (offsetTime);
     CONTAINER.i_time.insert (*this);
@@ -88,6 +119,7 @@ public:
 
 public:
   boost::intrusive::set_member_hook<> time_hook_;
+  wheel_hook wheel_hook_;
   
 private:
   typename Pit::super::iterator item_;
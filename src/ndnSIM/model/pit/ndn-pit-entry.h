@@ -29,6 +29,8 @@
 #include "ns3/ndn-pit-entry-incoming-face.h"
 #include "ns3/ndn-pit-entry-outgoing-face.h"
 
+#include "ns3/ndnSIM/utils/small-set.h"
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -36,7 +38,6 @@
 // #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 // #include <boost/multi_index/mem_fun.hpp>
-#include <set>
 #include <boost/shared_ptr.hpp>
 
 namespace ns3 {
@@ -53,18 +54,23 @@ namespace pit {
  * @brief structure for PIT entry
  *
  * All set-methods are virtual, in case index rearrangement is necessary in the derived classes
+ *
+ * Incoming faces, outgoing faces, and seen nonces are kept in small sorted arrays
+ * (ndnSIM::small_set) with inline space for a few elements, as most entries have
+ * only one or two of each.  Iterators to these containers are invalidated by
+ * additions and removals of faces and nonces.
  */
 class Entry : public SimpleRefCount<Entry>
 {
 public:
-  typedef std::set< IncomingFace > in_container; ///< @brief incoming faces container type
+  typedef ndnSIM::small_set< IncomingFace, 2 > in_container; ///< @brief incoming faces container type
   typedef in_container::iterator in_iterator;                ///< @brief iterator to incoming faces
 
   // typedef OutgoingFaceContainer::type out_container; ///< @brief outgoing faces container type
-  typedef std::set< OutgoingFace > out_container; ///< @brief outgoing faces container type
+  typedef ndnSIM::small_set< OutgoingFace, 2 > out_container; ///< @brief outgoing faces container type
   typedef out_container::iterator out_iterator;              ///< @brief iterator to outgoing faces
 
-  typedef std::set< uint32_t > nonce_container;  ///< @brief nonce container type
+  typedef ndnSIM::small_set< uint32_t, 2 > nonce_container;  ///< @brief nonce container type
 
   /**
    * \brief PIT entry constructor
@@ -25,8 +25,12 @@
 
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/nstime.h"
+
+#include <boost/intrusive/list.hpp>
 
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/trie/free-list-allocator.h"
 #include "ndn-pit-entry-impl.h"
 
 #include "ns3/ndn-interest.h"
@@ -45,20 +49,33 @@ namespace pit {
 /**
  * @ingroup ndn-pit
  * @brief Class implementing Pending Interests Table
+ *
+ * Trie nodes are allocated through free lists (ndnSIM::free_list_allocator_traits), as PIT
+ * entries are continuously created and pruned
+ *
+ * By default, each PIT entry expires exactly at its expiration time, which requires
+ * rescheduling of the cleaning event whenever the earliest expiration time changes.  If
+ * ExpirationGranularity attribute is set, entries are instead kept in a timer wheel with
+ * slots of the specified granularity and expire at the end of their slot (i.e., up to
+ * one granularity interval later).  Lifetime updates then do not touch any index or
+ * scheduler events: an entry whose lifetime was extended is moved to the right slot
+ * only when its old slot is processed.
  */
 template<class Policy>
 class PitImpl : public Pit
               , protected ndnSIM::trie_with_policy<Name,
                                                    ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy > > >,
                                                    // ndnSIM::persistent_policy_traits
-                                                   Policy
+                                                   Policy,
+                                                   ndnSIM::free_list_allocator_traits
                                                    >
 {
 public:
   typedef ndnSIM::trie_with_policy<Name,
                                    ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy > > >,
                                    // ndnSIM::persistent_policy_traits
-                                   Policy
+                                   Policy,
+                                   ndnSIM::free_list_allocator_traits
                                    > super;
   typedef EntryImpl< PitImpl< Policy > > entry;
 
@@ -120,6 +137,13 @@ protected:
   void RescheduleCleaning ();
   void CleanExpired ();
 
+  inline bool
+  IsWheelEnabled () const { return !m_wheelGranularity.IsZero (); }
+
+  void WheelInsert (entry &item);
+  void WheelScheduleTick (int64_t tick);
+  void WheelProcessTick ();
+
   // inherited from Object class
   virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
   virtual void DoDispose (); ///< @brief Do cleanup
@@ -134,6 +158,15 @@ private:
   uint32_t
   GetCurrentSize () const;
 
+  Time
+  GetExpirationGranularity () const;
+
+  void
+  SetExpirationGranularity (const Time &granularity);
+
+  int64_t
+  GetTick (const Time &time) const;
+
 private:
   EventId m_cleanEvent;
   Ptr<Fib> m_fib; ///< \brief Link to FIB table
@@ -151,6 +184,20 @@ private:
                         > time_index;
   time_index i_time;
 
+  typedef
+  boost::intrusive::list<entry,
+                         boost::intrusive::member_hook< entry, wheel_hook, &entry::wheel_hook_ >,
+                         boost::intrusive::constant_time_size<false>
+                         > wheel_slot;
+
+  static const size_t wheelSize = 256; ///< @brief number of slots in the timer wheel (power of 2)
+
+  Time m_wheelGranularity;      ///< @brief duration of one wheel slot, zero if the wheel is not used
+  std::vector<wheel_slot> m_wheel;
+  int64_t m_wheelCurrentTick;   ///< @brief last processed tick
+  int64_t m_wheelScheduledTick; ///< @brief tick for which m_wheelEvent is scheduled
+  EventId m_wheelEvent;
+
   friend class EntryImpl< PitImpl >;
 };
 
@@ -182,6 +229,14 @@ PitImpl< Policy >::GetTypeId ()
                    UintegerValue (0),
                    MakeUintegerAccessor (&PitImpl< Policy >::GetCurrentSize),
                    MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("ExpirationGranularity",
+                   "Granularity of PIT entry expiration. If 0, entries expire exactly at their expiration time, "
+                   "otherwise they are kept in a timer wheel and expire up to ExpirationGranularity later",
+                   TimeValue (), // by default, exact expiration
+                   MakeTimeAccessor (&PitImpl< Policy >::GetExpirationGranularity,
+                                     &PitImpl< Policy >::SetExpirationGranularity),
+                   MakeTimeChecker ())
     ;
 
   return tid;
@@ -196,6 +251,8 @@ PitImpl<Policy>::GetCurrentSize () const
 
 template<class Policy>
 PitImpl<Policy>::PitImpl ()
+  : m_wheelCurrentTick (0)
+  , m_wheelScheduledTick (0)
 {
 }
 
@@ -218,6 +275,73 @@ PitImpl<Policy>::SetMaxSize (uint32_t maxSize)
   super::getPolicy ().set_max_size (maxSize);
 }
 
+template<class Policy>
+Time
+PitImpl<Policy>::GetExpirationGranularity () const
+{
+  return m_wheelGranularity;
+}
+
+template<class Policy>
+void
+PitImpl<Policy>::SetExpirationGranularity (const Time &granularity)
+{
+  // move existing entries to the new index
+  std::vector< entry* > items;
+  if (IsWheelEnabled ())
+    {
+      for (typename std::vector<wheel_slot>::iterator slot = m_wheel.begin (); slot != m_wheel.end (); slot++)
+        {
+          while (!slot->empty ())
+            {
+              items.push_back (&slot->front ());
+              slot->pop_front ();
+            }
+        }
+      Simulator::Remove (m_wheelEvent);
+    }
+  else
+    {
+      while (!i_time.empty ())
+        {
+          items.push_back (&*i_time.begin ());
+          i_time.erase (i_time.begin ());
+        }
+      Simulator::Remove (m_cleanEvent);
+    }
+
+  m_wheelGranularity = granularity;
+  if (IsWheelEnabled ())
+    {
+      m_wheel.resize (wheelSize);
+      m_wheelCurrentTick = GetTick (Simulator::Now ());
+    }
+  else
+    {
+      std::vector<wheel_slot> ().swap (m_wheel);
+    }
+
+  for (typename std::vector< entry* >::iterator item = items.begin (); item != items.end (); item++)
+    {
+      if (IsWheelEnabled ())
+        WheelInsert (**item);
+      else
+        i_time.insert (**item);
+    }
+
+  if (!IsWheelEnabled ())
+    RescheduleCleaning ();
+}
+
+template<class Policy>
+int64_t
+PitImpl<Policy>::GetTick (const Time &time) const
+{
+  // tick at which the time interval expires (rounded up)
+  int64_t granularity = m_wheelGranularity.GetTimeStep ();
+  return (time.GetTimeStep () + granularity - 1) / granularity;
+}
+
 template<class Policy>
 void
 PitImpl<Policy>::NotifyNewAggregate ()
@@ -239,6 +363,7 @@ void
 PitImpl<Policy>::DoDispose ()
 {
   super::clear ();
+  Simulator::Remove (m_wheelEvent);
 
   m_forwardingStrategy = 0;
   m_fib = 0;
@@ -298,6 +423,70 @@ PitImpl<Policy>::CleanExpired ()
   RescheduleCleaning ();
 }
 
+template<class Policy>
+void
+PitImpl<Policy>::WheelInsert (entry &item)
+{
+  int64_t tick = std::max (GetTick (item.GetExpireTime ()), m_wheelCurrentTick + 1);
+  m_wheel [tick & (wheelSize - 1)].push_back (item);
+
+  if (!m_wheelEvent.IsRunning () || tick < m_wheelScheduledTick)
+    {
+      WheelScheduleTick (tick);
+    }
+}
+
+template<class Policy>
+void
+PitImpl<Policy>::WheelScheduleTick (int64_t tick)
+{
+  Simulator::Remove (m_wheelEvent);
+
+  m_wheelScheduledTick = tick;
+  m_wheelEvent = Simulator::Schedule (TimeStep (tick * m_wheelGranularity.GetTimeStep ()) - Simulator::Now (),
+                                      &PitImpl<Policy>::WheelProcessTick, this);
+}
+
+template<class Policy>
+void
+PitImpl<Policy>::WheelProcessTick ()
+{
+  m_wheelCurrentTick = m_wheelScheduledTick;
+  Time now = Simulator::Now ();
+
+  wheel_slot slot;
+  slot.splice (slot.end (), m_wheel [m_wheelCurrentTick & (wheelSize - 1)]);
+
+  NS_LOG_LOGIC ("Processing PIT timer wheel tick " << m_wheelCurrentTick);
+  while (!slot.empty ())
+    {
+      entry &item = slot.front ();
+      slot.pop_front ();
+
+      if (item.GetExpireTime () <= now) // is the record stale?
+        {
+          m_forwardingStrategy->WillEraseTimedOutPendingInterest (item.to_iterator ()->payload ());
+          super::erase (item.to_iterator ());
+        }
+      else
+        {
+          // lifetime was extended or the entry belongs to one of the next rounds of the wheel
+          WheelInsert (item);
+        }
+    }
+
+  // schedule the next tick at the first non-empty slot
+  for (int64_t tick = m_wheelCurrentTick + 1; tick <= m_wheelCurrentTick + static_cast<int64_t> (wheelSize); tick++)
+    {
+      if (!m_wheel [tick & (wheelSize - 1)].empty ())
+        {
+          if (!m_wheelEvent.IsRunning () || tick < m_wheelScheduledTick)
+            WheelScheduleTick (tick);
+          break;
+        }
+    }
+}
+
 template<class Policy>
 Ptr<Entry>
 PitImpl<Policy>::Lookup (const Data &header)
@@ -0,0 +1,576 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_NAME_TABLE_H_
+#define _NDN_PIT_NAME_TABLE_H_
+
+#include "ndn-pit.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+#include "ns3/ndn-forwarding-strategy.h"
+
+#include "../ndn-name-table.h"
+#include "ndn-pit-entry-impl.h"
+
+#include <boost/intrusive/set.hpp>
+#include <boost/ref.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+template<class Policy>
+class PitNameTable;
+
+/**
+ * @ingroup ndn-pit
+ * @brief PIT entry implementation that is linked into the replacement policy and expiration
+ * indexes of PitNameTable, with a reference to the node of the name table
+ */
+template<class Policy>
+class NameTableEntryImpl : public Entry
+{
+public:
+  typedef Entry base_type;
+
+  typedef Entry super;
+  typedef PitNameTable<Policy> container;
+
+  // to make sure policies work
+  typedef NameTableEntryImpl *iterator;
+  typedef const NameTableEntryImpl *const_iterator;
+
+public:
+  NameTableEntryImpl (Pit &pit,
+                      Ptr<const Interest> header,
+                      Ptr<fib::Entry> fibEntry)
+    : Entry (pit, header, fibEntry)
+    , node_ (0)
+  {
+    GetContainer ().i_time.insert (*this);
+    GetContainer ().RescheduleCleaning ();
+  }
+
+  virtual ~NameTableEntryImpl ()
+  {
+    if (!time_hook_.is_linked ())
+      return;
+
+    GetContainer ().i_time.erase (container::time_index::s_iterator_to (*this));
+    GetContainer ().RescheduleCleaning ();
+  }
+
+  virtual void
+  UpdateLifetime (const Time &offsetTime)
+  {
+    if (!time_hook_.is_linked ())
+      {
+        super::UpdateLifetime (offsetTime);
+        return;
+      }
+
+    GetContainer ().i_time.erase (container::time_index::s_iterator_to (*this));
+    super::UpdateLifetime (offsetTime);
+    GetContainer ().i_time.insert (*this);
+
+    GetContainer ().RescheduleCleaning ();
+  }
+
+  virtual void
+  OffsetLifetime (const Time &offsetTime)
+  {
+    if (!time_hook_.is_linked ())
+      {
+        super::OffsetLifetime (offsetTime);
+        return;
+      }
+
+    GetContainer ().i_time.erase (container::time_index::s_iterator_to (*this));
+    super::OffsetLifetime (offsetTime);
+    GetContainer ().i_time.insert (*this);
+
+    GetContainer ().RescheduleCleaning ();
+  }
+
+  void
+  SetNode (NameTable::iterator node) { node_ = node; }
+
+  NameTable::iterator GetNode () { return node_; }
+  NameTable::const_iterator GetNode () const { return node_; }
+
+public:
+  typename Policy::policy_hook_type policy_hook_;
+  boost::intrusive::set_member_hook<> time_hook_;
+
+private:
+  inline container &
+  GetContainer () { return static_cast<container&> (m_container); }
+
+private:
+  NameTable::iterator node_; ///< @brief node of the name table (0 if the entry has been removed from PIT)
+};
+
+/**
+ * @ingroup ndn-pit
+ * @brief PIT realization that keeps its entries in the name table shared with FIB and
+ * ContentStore (see ndn::NameTable)
+ *
+ * Entries are linked into the replacement policy (any of the policies available for
+ * ns3::ndn::pit::PitImpl) directly, instead of through the trie nodes.  Entries expire
+ * exactly at their expiration time (timer wheel of PitImpl is not supported).
+ */
+template<class Policy>
+class PitNameTable : public Pit
+{
+public:
+  typedef NameTableEntryImpl< Policy > entry;
+
+  typedef typename Policy::template policy<
+    PitNameTable< Policy >,
+    entry,
+    typename Policy::template container_hook< entry >::type >::type policy_container;
+
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief PIT constructor
+   */
+  PitNameTable ();
+
+  /**
+   * \brief Destructor
+   */
+  virtual ~PitNameTable ();
+
+  // inherited from Pit
+  virtual Ptr<Entry>
+  Lookup (const Data &header);
+
+  virtual Ptr<Entry>
+  Lookup (const Interest &header);
+
+  virtual Ptr<Entry>
+  Find (const Name &prefix);
+
+  virtual Ptr<Entry>
+  Create (Ptr<const Interest> header);
+
+  virtual void
+  MarkErased (Ptr<Entry> entry);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<Entry>
+  Begin ();
+
+  virtual Ptr<Entry>
+  End ();
+
+  virtual Ptr<Entry>
+  Next (Ptr<Entry>);
+
+  const policy_container &
+  GetPolicy () const { return m_policy; }
+
+  policy_container &
+  GetPolicy () { return m_policy; }
+
+  /**
+   * @brief Remove entry from PIT (used by replacement policies)
+   */
+  void
+  erase (entry *item);
+
+protected:
+  void RescheduleCleaning ();
+  void CleanExpired ();
+
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  Ptr<NameTable>
+  GetNameTable ();
+
+  uint32_t
+  GetMaxSize () const;
+
+  void
+  SetMaxSize (uint32_t maxSize);
+
+  uint32_t
+  GetCurrentSize () const;
+
+  Ptr<Entry>
+  FindNext (NameTable::trie::recursive_iterator item);
+
+private:
+  EventId m_cleanEvent;
+  Ptr<Fib> m_fib; ///< \brief Link to FIB table
+  Ptr<ForwardingStrategy> m_forwardingStrategy;
+  Ptr<NameTable> m_nameTable;
+
+  static LogComponent g_log; ///< @brief Logging variable
+
+  policy_container m_policy;
+
+  // indexes
+  typedef
+  boost::intrusive::multiset<entry,
+                        boost::intrusive::compare < TimestampIndex< entry > >,
+                        boost::intrusive::member_hook< entry,
+                                                       boost::intrusive::set_member_hook<>,
+                                                       &entry::time_hook_>
+                        > time_index;
+  time_index i_time;
+
+  friend class NameTableEntryImpl< Policy >;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+LogComponent PitNameTable< Policy >::g_log = LogComponent (("ndn.pit.NameTable." + Policy::GetName ()).c_str ());
+
+
+template<class Policy>
+TypeId
+PitNameTable< Policy >::GetTypeId ()
+{
+  static TypeId tid = TypeId (("ns3::ndn::pit::NameTable::"+Policy::GetName ()).c_str ())
+    .SetGroupName ("Ndn")
+    .SetParent<Pit> ()
+    .AddConstructor< PitNameTable< Policy > > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum size of PIT in bytes. If 0, limit is not enforced",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&PitNameTable< Policy >::GetMaxSize,
+                                         &PitNameTable< Policy >::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("CurrentSize", "Get current size of PIT in bytes",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&PitNameTable< Policy >::GetCurrentSize),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+
+  return tid;
+}
+
+template<class Policy>
+PitNameTable<Policy>::PitNameTable ()
+  : m_policy (*this)
+{
+}
+
+template<class Policy>
+PitNameTable<Policy>::~PitNameTable ()
+{
+}
+
+template<class Policy>
+uint32_t
+PitNameTable<Policy>::GetMaxSize () const
+{
+  return m_policy.get_max_size ();
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::SetMaxSize (uint32_t maxSize)
+{
+  m_policy.set_max_size (maxSize);
+}
+
+template<class Policy>
+uint32_t
+PitNameTable<Policy>::GetCurrentSize () const
+{
+  return m_policy.size ();
+}
+
+template<class Policy>
+Ptr<NameTable>
+PitNameTable<Policy>::GetNameTable ()
+{
+  if (m_nameTable == 0)
+    {
+      m_nameTable = NameTable::GetNameTable (this);
+    }
+  return m_nameTable;
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::NotifyNewAggregate ()
+{
+  if (m_fib == 0)
+    {
+      m_fib = GetObject<Fib> ();
+    }
+  if (m_forwardingStrategy == 0)
+    {
+      m_forwardingStrategy = GetObject<ForwardingStrategy> ();
+    }
+
+  Pit::NotifyNewAggregate ();
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::DoDispose ()
+{
+  while (m_policy.size () > 0)
+    {
+      erase (&(*m_policy.begin ()));
+    }
+  Simulator::Remove (m_cleanEvent);
+
+  m_nameTable = 0;
+  m_forwardingStrategy = 0;
+  m_fib = 0;
+
+  Pit::DoDispose ();
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::erase (entry *item)
+{
+  NameTable::iterator node = item->GetNode ();
+  if (node == 0)
+    return; // already removed
+
+  m_policy.erase (item);
+  i_time.erase (time_index::s_iterator_to (*item));
+  item->SetNode (0);
+
+  node->payload ().m_pitEntry = 0; // may destroy the entry
+  m_nameTable->Prune (node);
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::RescheduleCleaning ()
+{
+  Simulator::Remove (m_cleanEvent); // slower, but better for memory
+  if (i_time.empty ())
+    {
+      return;
+    }
+
+  Time nextEvent = i_time.begin ()->GetExpireTime () - Simulator::Now ();
+  if (nextEvent <= 0) nextEvent = Seconds (0);
+
+  NS_LOG_DEBUG ("Schedule next cleaning in " <<
+                nextEvent.ToDouble (Time::S) << "s (at " <<
+                i_time.begin ()->GetExpireTime () << "s abs time");
+
+  m_cleanEvent = Simulator::Schedule (nextEvent,
+                                      &PitNameTable<Policy>::CleanExpired, this);
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::CleanExpired ()
+{
+  NS_LOG_LOGIC ("Cleaning PIT. Total: " << i_time.size ());
+  Time now = Simulator::Now ();
+
+  while (!i_time.empty ())
+    {
+      entry &item = *i_time.begin ();
+      if (item.GetExpireTime () <= now) // is the record stale?
+        {
+          m_forwardingStrategy->WillEraseTimedOutPendingInterest (&item);
+          erase (&item);
+        }
+      else
+        break; // nothing else to do. All later records will not be stale
+    }
+
+  RescheduleCleaning ();
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::Lookup (const Data &header)
+{
+  /// @todo use predicate to search with exclude filters
+  const std::vector<NameTable::iterator> &path = GetNameTable ()->Walk (header.GetName ());
+  for (size_t i = path.size (); i > 0; i--)
+    {
+      const Ptr<Entry> &item = path[i-1]->payload ().m_pitEntry;
+
+      // same as in trie::find_if, predicate is not checked for the root node
+      if (item != 0 && (i == 1 || EntryIsNotEmpty () (item)))
+        {
+          m_policy.lookup (static_cast<entry*> (PeekPointer (item)));
+          return item;
+        }
+    }
+
+  return 0;
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::Lookup (const Interest &header)
+{
+  NS_ASSERT_MSG (m_fib != 0, "FIB should be set");
+  NS_ASSERT_MSG (m_forwardingStrategy != 0, "Forwarding strategy  should be set");
+
+  return Find (header.GetName ());
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::Find (const Name &prefix)
+{
+  const std::vector<NameTable::iterator> &path = GetNameTable ()->Walk (prefix);
+  if (path.size () != prefix.size () + 1)
+    return 0;
+  else
+    return path.back ()->payload ().m_pitEntry; // which could also be 0
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::Create (Ptr<const Interest> header)
+{
+  NS_LOG_DEBUG (header->GetName ());
+  Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
+  if (fibEntry == 0)
+    return 0;
+
+  Ptr<Entry> existingEntry = Find (header->GetName ());
+  if (existingEntry != 0)
+    return existingEntry;
+
+  Ptr< entry > newEntry = ns3::Create< entry > (boost::ref (*this), header, fibEntry);
+  if (!m_policy.insert (PeekPointer (newEntry)))
+    return 0;
+
+  // policy could have removed other entries, so the node is looked up only now
+  NameTable::iterator node = GetNameTable ()->Insert (header->GetName ());
+  newEntry->SetNode (node);
+  node->payload ().m_pitEntry = newEntry;
+
+  return newEntry;
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::MarkErased (Ptr<Entry> item)
+{
+  if (this->m_PitEntryPruningTimout.IsZero ())
+    {
+      erase (PeekPointer (StaticCast< entry > (item)));
+    }
+  else
+    {
+      item->OffsetLifetime (this->m_PitEntryPruningTimout - item->GetExpireTime () + Simulator::Now ());
+    }
+}
+
+template<class Policy>
+void
+PitNameTable<Policy>::Print (std::ostream& os) const
+{
+  // !!! unordered_set imposes "random" order of item in the same level !!!
+  Ptr<Entry> item = const_cast<PitNameTable<Policy>*> (this)->Begin ();
+  for (; item != 0; item = const_cast<PitNameTable<Policy>*> (this)->Next (item))
+    {
+      os << item->GetPrefix () << "\t" << *item << "\n";
+    }
+}
+
+template<class Policy>
+uint32_t
+PitNameTable<Policy>::GetSize () const
+{
+  return m_policy.size ();
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::FindNext (NameTable::trie::recursive_iterator item)
+{
+  NameTable::trie::recursive_iterator end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload ().m_pitEntry != 0)
+        return item->payload ().m_pitEntry;
+    }
+
+  return End ();
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::Begin ()
+{
+  if (m_nameTable == 0)
+    return End ();
+
+  return FindNext (NameTable::trie::recursive_iterator (m_nameTable->GetTrie ()));
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::End ()
+{
+  return 0;
+}
+
+template<class Policy>
+Ptr<Entry>
+PitNameTable<Policy>::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  NameTable::trie::recursive_iterator item (StaticCast< entry > (from)->GetNode ());
+  item++;
+  return FindNext (item);
+}
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_PIT_NAME_TABLE_H_
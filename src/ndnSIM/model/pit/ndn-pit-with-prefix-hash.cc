@@ -0,0 +1,71 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-pit-with-prefix-hash.h"
+
+#include "../../utils/trie/persistent-policy.h"
+#include "../../utils/trie/random-policy.h"
+#include "../../utils/trie/lru-policy.h"
+
+
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
+  static struct X ## type ## templ ## RegistrationClass \
+  {                                                     \
+    X ## type ## templ ## RegistrationClass () {        \
+      ns3::TypeId tid = type<templ>::GetTypeId ();      \
+      tid.GetParent ();                                 \
+    }                                                   \
+  } x_ ## type ## templ ## RegistrationVariable
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+using namespace ndnSIM;
+
+// explicit instantiation and registering
+template class PitWithPrefixHash<persistent_policy_traits>;
+template class PitWithPrefixHash<random_policy_traits>;
+template class PitWithPrefixHash<lru_policy_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitWithPrefixHash, persistent_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitWithPrefixHash, random_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitWithPrefixHash, lru_policy_traits);
+
+#ifdef DOXYGEN
+/**
+ * \brief PIT with flat prefix-hash index, in which new entries will be rejected if PIT size reached its limit
+ */
+class PrefixHash::Persistent : public PitWithPrefixHash<persistent_policy_traits> { };
+
+/**
+ * \brief PIT with flat prefix-hash index, in which random entry will be removed when PIT size reached its limit
+ */
+class PrefixHash::Random : public PitWithPrefixHash<random_policy_traits> { };
+
+/**
+ * \brief PIT with flat prefix-hash index, in which the least recently used entry will be removed when PIT size reached its limit
+ */
+class PrefixHash::Lru : public PitWithPrefixHash<lru_policy_traits> { };
+#endif
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_WITH_PREFIX_HASH_H_
+#define _NDN_PIT_WITH_PREFIX_HASH_H_
+
+#include "ndn-pit-impl.h"
+
+#include "../../utils/trie/multi-policy.h"
+#include "../../utils/trie/prefix-hash-policy.h"
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+/**
+ * @ingroup ndn-pit
+ * @brief PIT realization that resolves exact and longest prefix matches using flat
+ * index of full-prefix hashes (ndnSIM::prefix_hash_policy_traits), instead of walking the trie
+ */
+template<class Policy>
+class PitWithPrefixHash :
+    public PitImpl< ndnSIM::multi_policy_traits< boost::mpl::vector2< Policy, ndnSIM::prefix_hash_policy_traits > > >
+{
+public:
+  typedef PitImpl< ndnSIM::multi_policy_traits< boost::mpl::vector2< Policy, ndnSIM::prefix_hash_policy_traits > > > super;
+
+  typedef typename super::policy_container::template index<1>::type prefix_hash_policy_container;
+
+  static TypeId
+  GetTypeId ();
+
+  // inherited from Pit
+  virtual Ptr<Entry>
+  Lookup (const Data &header);
+
+  virtual Ptr<Entry>
+  Lookup (const Interest &header);
+
+  virtual Ptr<Entry>
+  Find (const Name &prefix);
+
+private:
+  inline prefix_hash_policy_container &
+  GetIndex ()
+  {
+    return this->GetPolicy ().template get<prefix_hash_policy_container> ();
+  }
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+TypeId
+PitWithPrefixHash< Policy >::GetTypeId ()
+{
+  static TypeId tid = TypeId (("ns3::ndn::pit::PrefixHash::"+Policy::GetName ()).c_str ())
+    .SetGroupName ("Ndn")
+    .SetParent<super> ()
+    .template AddConstructor< PitWithPrefixHash< Policy > > ()
+    ;
+
+  return tid;
+}
+
+template<class Policy>
+Ptr<Entry>
+PitWithPrefixHash< Policy >::Lookup (const Data &header)
+{
+  typename super::super::iterator item = GetIndex ().longest_prefix_match_if (header.GetName (), EntryIsNotEmpty ());
+
+  if (item == 0)
+    return 0;
+  else
+    return item->payload ();
+}
+
+template<class Policy>
+Ptr<Entry>
+PitWithPrefixHash< Policy >::Lookup (const Interest &header)
+{
+  typename super::super::iterator item = GetIndex ().find_exact (header.GetName ());
+
+  if (item == 0)
+    return 0;
+  else
+    return item->payload ();
+}
+
+template<class Policy>
+Ptr<Entry>
+PitWithPrefixHash< Policy >::Find (const Name &prefix)
+{
+  typename super::super::iterator item = GetIndex ().find_exact (prefix);
+
+  if (item == 0)
+    return 0;
+  else
+    return item->payload ();
+}
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif	// _NDN_PIT_WITH_PREFIX_HASH_H_
@@ -53,6 +53,18 @@ public:
   virtual void Serialize (Buffer::Iterator start) const;
   virtual uint32_t Deserialize (Buffer::Iterator start);
 
+  /**
+   * @brief Decode packet in a single pass, without building the syntax tree (default)
+   */
+  uint32_t
+  DeserializeStream (Buffer::Iterator start);
+
+  /**
+   * @brief Decode packet by building the syntax tree and walking it with visitors (reference implementation)
+   */
+  uint32_t
+  DeserializeSyntaxTree (Buffer::Iterator start);
+
 private:
   Ptr<ndn::Interest> m_interest;
 };
@@ -86,6 +98,18 @@ public:
   virtual void Serialize (Buffer::Iterator start) const;
   virtual uint32_t Deserialize (Buffer::Iterator start);
 
+  /**
+   * @brief Decode packet in a single pass, without building the syntax tree (default)
+   */
+  uint32_t
+  DeserializeStream (Buffer::Iterator start);
+
+  /**
+   * @brief Decode packet by building the syntax tree and walking it with visitors (reference implementation)
+   */
+  uint32_t
+  DeserializeSyntaxTree (Buffer::Iterator start);
+
 private:
   Ptr<ndn::Data> m_data;  
 };
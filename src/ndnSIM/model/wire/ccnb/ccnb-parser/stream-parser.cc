@@ -0,0 +1,308 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "stream-parser.h"
+
+#include <vector>
+#include <cstring>
+
+NDN_NAMESPACE_BEGIN
+
+namespace wire {
+namespace CcnbParser {
+
+/// @cond include_hidden
+static const uint8_t CCN_TT_BITS = 3;
+static const uint8_t CCN_TT_MASK = ((1 << CCN_TT_BITS) - 1);
+static const uint8_t CCN_TT_HBIT = ((uint8_t)(1 << 7));
+
+static const uint32_t MAX_INLINE_COMPONENT = 256;
+/// @endcond
+
+StreamParser::StreamParser (Buffer::Iterator &start)
+  : m_i (start)
+{
+}
+
+bool
+StreamParser::ReadBlockHeader (uint32_t &type, uint32_t &value)
+{
+  if (m_i.IsEnd ())
+    throw CcnbDecodingException ();
+
+  uint8_t byte = m_i.ReadU8 ();
+  if (byte == CCN_CLOSE)
+    return false;
+
+  value = 0;
+  while (!(byte & CCN_TT_HBIT))
+    {
+      value = (value << 7) + byte;
+
+      if (m_i.IsEnd ())
+        throw CcnbDecodingException ();
+      byte = m_i.ReadU8 ();
+    }
+
+  value = (value << 4) + ((byte & ~CCN_TT_HBIT) >> 3);
+  type = byte & CCN_TT_MASK;
+  return true;
+}
+
+bool
+StreamParser::ReadDtag (uint32_t &dtag)
+{
+  uint32_t type;
+  while (ReadBlockHeader (type, dtag))
+    {
+      if (type == CCN_DTAG)
+        return true;
+
+      // attributes and non-DTAG blocks are ignored
+      SkipBlock (type, dtag);
+    }
+  return false;
+}
+
+void
+StreamParser::SkipBlock (uint32_t type, uint32_t value)
+{
+  uint32_t nestedType, nestedValue;
+
+  switch (type)
+    {
+    case CCN_BLOB:
+    case CCN_UDATA:
+      Skip (value);
+      break;
+    case CCN_TAG:
+      Skip (value + 1); // tag name
+      // no break
+    case CCN_DTAG:
+      while (ReadBlockHeader (nestedType, nestedValue))
+        {
+          SkipBlock (nestedType, nestedValue);
+        }
+      break;
+    case CCN_ATTR:
+      Skip (value + 1); // attribute name
+      // no break
+    case CCN_DATTR:
+      if (!ReadBlockHeader (nestedType, nestedValue) || nestedType != CCN_UDATA)
+        throw CcnbDecodingException (); // "ATTR must be followed by UDATA field"
+      Skip (nestedValue);
+      break;
+    case CCN_EXT:
+      break;
+    default:
+      throw CcnbDecodingException ();
+    }
+}
+
+void
+StreamParser::SkipBlockHeader ()
+{
+  // same as Block::ParseBlock (start, true)
+  uint8_t byte = 0;
+  while (!m_i.IsEnd () && !(byte & CCN_TT_HBIT))
+    {
+      byte = m_i.ReadU8 ();
+    }
+}
+
+void
+StreamParser::ReadCloser ()
+{
+  if (m_i.IsEnd () || m_i.ReadU8 () != CCN_CLOSE)
+    throw CcnbDecodingException ();
+}
+
+void
+StreamParser::ReadValueHeader (uint32_t &type, uint32_t &length)
+{
+  // should be exactly one nested block (not counting attributes) inside the DTAG
+  while (true)
+    {
+      if (!ReadBlockHeader (type, length))
+        throw CcnbDecodingException ();
+
+      if (type != CCN_ATTR && type != CCN_DATTR)
+        return;
+
+      SkipBlock (type, length);
+    }
+}
+
+void
+StreamParser::Skip (uint32_t length)
+{
+  for (uint32_t i = 0; i < length; i++)
+    {
+      if (m_i.IsEnd ())
+        throw CcnbDecodingException ();
+      m_i.Next ();
+    }
+}
+
+uint32_t
+StreamParser::ReadNonNegativeInteger ()
+{
+  uint32_t type, length;
+  ReadValueHeader (type, length);
+  if (type != CCN_UDATA)
+    throw CcnbDecodingException ();
+
+  uint64_t value = 0;
+  bool negative = false;
+  bool digits = false;
+  bool stop = false;
+  for (uint32_t i = 0; i < length; i++)
+    {
+      if (m_i.IsEnd ())
+        throw CcnbDecodingException ();
+      uint8_t c = m_i.ReadU8 ();
+
+      if (stop)
+        continue;
+
+      if (c >= '0' && c <= '9')
+        {
+          value = value * 10 + (c - '0');
+          if (value > 0x7FFFFFFF)
+            throw CcnbDecodingException ();
+          digits = true;
+        }
+      else if (c == '-' && i == 0)
+        negative = true;
+      else
+        stop = true;
+    }
+
+  if (!digits || (negative && value > 0)) // value should be non-negative
+    throw CcnbDecodingException ();
+
+  ReadCloser ();
+  return static_cast<uint32_t> (value);
+}
+
+Time
+StreamParser::ReadTimestamp ()
+{
+  uint32_t type, length;
+  ReadValueHeader (type, length);
+  if (type != CCN_BLOB || length < 2)
+    throw CcnbDecodingException ();
+
+  intmax_t seconds = 0;
+  intmax_t nanoseconds = 0;
+
+  for (uint32_t i = 0; i < length - 2; i++)
+    {
+      if (m_i.IsEnd ())
+        throw CcnbDecodingException ();
+      seconds = (seconds << 8) | m_i.ReadU8 ();
+    }
+
+  if (m_i.IsEnd ())
+    throw CcnbDecodingException ();
+  uint8_t combo = m_i.ReadU8 (); // 4 most significant bits hold 4 least significant bits of number of seconds
+  seconds = (seconds << 4) | (combo >> 4);
+
+  if (m_i.IsEnd ())
+    throw CcnbDecodingException ();
+  nanoseconds = combo & 0x0F; // 4 least significant bits hold 4 most significant bits of number of
+  nanoseconds = (nanoseconds << 8) | m_i.ReadU8 ();
+  nanoseconds = (intmax_t) ((nanoseconds / 4096.0/*2^12*/) * 1000000 /*up-convert useconds*/);
+
+  ReadCloser ();
+  return Time::FromInteger (seconds, Time::S) + Time::FromInteger (nanoseconds, Time::US);
+}
+
+uint32_t
+StreamParser::ReadUint32Blob ()
+{
+  uint32_t type, length;
+  ReadValueHeader (type, length);
+  if (type != CCN_BLOB || length < 4)
+    throw CcnbDecodingException ();
+
+  uint8_t buf[4];
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      if (m_i.IsEnd ())
+        throw CcnbDecodingException ();
+      buf[i] = m_i.ReadU8 ();
+    }
+  Skip (length - 4);
+
+  uint32_t value;
+  std::memcpy (&value, buf, sizeof (value));
+
+  ReadCloser ();
+  return value;
+}
+
+void
+StreamParser::ReadName (Name &name)
+{
+  uint32_t type, value;
+  while (ReadBlockHeader (type, value))
+    {
+      if (type != CCN_DTAG)
+        {
+          SkipBlock (type, value);
+        }
+      else if (value != CCN_DTAG_Component)
+        {
+          ReadName (name); // e.g., <Name> inside <KeyName>
+        }
+      else
+        {
+          uint32_t length;
+          ReadValueHeader (type, length);
+          if (type != CCN_BLOB && type != CCN_UDATA)
+            throw CcnbDecodingException ();
+
+          uint8_t inlineBuf[MAX_INLINE_COMPONENT];
+          std::vector<uint8_t> heapBuf;
+          uint8_t *buf = inlineBuf;
+          if (length > MAX_INLINE_COMPONENT)
+            {
+              heapBuf.resize (length);
+              buf = &heapBuf[0];
+            }
+
+          for (uint32_t i = 0; i < length; i++)
+            {
+              if (m_i.IsEnd ())
+                throw CcnbDecodingException ();
+              buf[i] = m_i.ReadU8 ();
+            }
+
+          name.append (buf, length);
+          ReadCloser ();
+        }
+    }
+}
+
+} // CcnbParser
+} // wire
+
+NDN_NAMESPACE_END
@@ -0,0 +1,134 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _CCNB_PARSER_STREAM_PARSER_H_
+#define _CCNB_PARSER_STREAM_PARSER_H_
+
+#include "common.h"
+
+#include "ns3/buffer.h"
+#include "ns3/nstime.h"
+#include "ns3/ndn-name.h"
+
+NDN_NAMESPACE_BEGIN
+
+namespace wire {
+namespace CcnbParser {
+
+/**
+ * @brief Single-pass (pull) parser of ccnb-encoded blocks
+ *
+ * Unlike Block::ParseBlock, which builds a syntax tree of the whole packet that is later
+ * interpreted by visitors, StreamParser reads blocks directly from the buffer on request,
+ * leaving it to the caller to decide which blocks should be decoded and which skipped.  No
+ * memory is allocated except for the decoded values themselves.
+ *
+ * Values of the leaf blocks are decoded in the same way as by the corresponding visitors
+ * (NameVisitor, NonNegativeIntegerVisitor, TimestampVisitor, Uint32tBlobVisitor).
+ * CcnbDecodingException is thrown on any parsing error.
+ */
+class StreamParser
+{
+public:
+  /**
+   * @brief Create parser that reads (and advances) the supplied iterator
+   */
+  StreamParser (Buffer::Iterator &start);
+
+  /**
+   * @brief Read header of the next block
+   * @param type Type of the block (ccn_tt)
+   * @param value Value of the block header (e.g., dtag or length, depending on the type)
+   * @returns false if closer was read instead of a block header
+   */
+  bool
+  ReadBlockHeader (uint32_t &type, uint32_t &value);
+
+  /**
+   * @brief Read header of the next block, skipping all attributes, and check that it is a DTAG
+   * @param dtag Dictionary tag of the block (ccn_dtag)
+   * @returns false if closer was read instead of a DTAG
+   */
+  bool
+  ReadDtag (uint32_t &dtag);
+
+  /**
+   * @brief Skip the rest of the block, which header was just read (including all nested blocks)
+   */
+  void
+  SkipBlock (uint32_t type, uint32_t value);
+
+  /**
+   * @brief Skip block header without interpreting it
+   *
+   * Used for the header of the virtual payload just after <Content> dtag
+   */
+  void
+  SkipBlockHeader ();
+
+  /**
+   * @brief Read the closer of the current block
+   */
+  void
+  ReadCloser ();
+
+  /**
+   * @brief Read UDATA with a non-negative decimal number and closer of the current DTAG
+   */
+  uint32_t
+  ReadNonNegativeInteger ();
+
+  /**
+   * @brief Read BLOB with a binary timestamp (12-bit fraction) and closer of the current DTAG
+   */
+  Time
+  ReadTimestamp ();
+
+  /**
+   * @brief Read BLOB with a uint32_t value (host byte order) and closer of the current DTAG
+   */
+  uint32_t
+  ReadUint32Blob ();
+
+  /**
+   * @brief Read name components and closer of the current DTAG (<Name> or <KeyName>)
+   *
+   * Components can be nested at any depth inside the current DTAG (e.g., <KeyName><Name><Component>...)
+   */
+  void
+  ReadName (Name &name);
+
+private:
+  void
+  ReadValueHeader (uint32_t &type, uint32_t &length);
+
+  void
+  Skip (uint32_t length);
+
+private:
+  Buffer::Iterator &m_i;
+};
+
+} // CcnbParser
+} // wire
+
+NDN_NAMESPACE_END
+
+#endif // _CCNB_PARSER_STREAM_PARSER_H_
@@ -48,7 +48,7 @@ TimestampVisitor::visit (Blob &n)
   seconds = (seconds << 4) | (combo >> 4);
 
   nanoseconds = combo & 0x0F; /*00001111*/ // 4 least significant bits hold 4 most significant bits of number of
-  nanoseconds = (nanoseconds << 8) | start[n.m_blobSize-1];
+  nanoseconds = (nanoseconds << 8) | (uint8_t)start[n.m_blobSize-1];
   nanoseconds = (intmax_t) ((nanoseconds / 4096.0/*2^12*/) * 1000000 /*up-convert useconds*/);
 
   return boost::any (Time::FromInteger (seconds, Time::S) + Time::FromInteger (nanoseconds, Time::US));
@@ -26,6 +26,7 @@
 #include "ns3/log.h"
 
 #include "ccnb-parser/common.h"
+#include "ccnb-parser/stream-parser.h"
 #include "ccnb-parser/visitors/void-depth-first-visitor.h"
 #include "ccnb-parser/visitors/name-visitor.h"
 #include "ccnb-parser/visitors/non-negative-integer-visitor.h"
@@ -480,8 +481,100 @@ public:
   }
 };
 
+/**
+ * @brief Decode nested blocks of the current DTAG (<Data>, <Signature>, <SignedInfo>, or <KeyLocator>)
+ * @returns true if <Content> tag has been reached, i.e., the rest of the packet is the payload
+ */
+static bool
+DeserializeDataBlocks (CcnbParser::StreamParser &parser, ndn::Data &contentObject)
+{
+  uint32_t dtag;
+  while (parser.ReadDtag (dtag))
+    {
+      switch (dtag)
+        {
+        case CcnbParser::CCN_DTAG_Signature:
+        case CcnbParser::CCN_DTAG_SignedInfo:
+        case CcnbParser::CCN_DTAG_KeyLocator:
+          if (DeserializeDataBlocks (parser, contentObject))
+            return true;
+          break;
+
+        case CcnbParser::CCN_DTAG_Name:
+          {
+            Ptr<Name> name = Create<Name> ();
+            parser.ReadName (*name);
+            contentObject.SetName (name);
+            break;
+          }
+
+        case CcnbParser::CCN_DTAG_SignatureBits:
+          contentObject.SetSignature (parser.ReadUint32Blob ());
+          break;
+
+        case CcnbParser::CCN_DTAG_Timestamp:
+          contentObject.SetTimestamp (parser.ReadTimestamp ());
+          break;
+
+        case CcnbParser::CCN_DTAG_FreshnessSeconds:
+          contentObject.SetFreshness (Seconds (parser.ReadNonNegativeInteger ()));
+          break;
+
+        case CcnbParser::CCN_DTAG_KeyName:
+          {
+            Ptr<Name> name = Create<Name> ();
+            parser.ReadName (*name);
+            contentObject.SetKeyLocator (name);
+            break;
+          }
+
+        case CcnbParser::CCN_DTAG_Content:
+          // Actual content (including virtual payload) is stored in the packet buffer,
+          // only length field of the BLOB is processed (and ignored)
+          parser.SkipBlockHeader ();
+          return true;
+
+        default: // ignore all other stuff
+          parser.SkipBlock (CcnbParser::CCN_DTAG, dtag);
+          break;
+        }
+    }
+
+  return false;
+}
+
 uint32_t
 Data::Deserialize (Buffer::Iterator start)
+{
+  if (Ccnb::IsSyntaxTreeParserEnabled ())
+    return DeserializeSyntaxTree (start);
+  else
+    return DeserializeStream (start);
+}
+
+uint32_t
+Data::DeserializeStream (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  CcnbParser::StreamParser parser (i);
+
+  uint32_t type, dtag;
+  if (!parser.ReadBlockHeader (type, dtag))
+    throw CcnbParser::CcnbDecodingException ();
+
+  if (type != CcnbParser::CCN_DTAG || dtag != CcnbParser::CCN_DTAG_Data)
+    {
+      parser.SkipBlock (type, dtag);
+      return i.GetDistanceFrom (start);
+    }
+
+  DeserializeDataBlocks (parser, *m_data);
+
+  return i.GetDistanceFrom (start);
+}
+
+uint32_t
+Data::DeserializeSyntaxTree (Buffer::Iterator start)
 {
   static DataVisitor contentObjectVisitor;
 
@@ -27,6 +27,7 @@
 #include "ns3/unused.h"
 #include "ns3/packet.h"
 
+#include "ccnb-parser/stream-parser.h"
 #include "ccnb-parser/visitors/name-visitor.h"
 #include "ccnb-parser/visitors/non-negative-integer-visitor.h"
 #include "ccnb-parser/visitors/timestamp-visitor.h"
@@ -389,6 +390,64 @@ InterestVisitor::visit (CcnbParser::Dtag &n, boost::any param/*should be Interes
 
 uint32_t
 Interest::Deserialize (Buffer::Iterator start)
+{
+  if (Ccnb::IsSyntaxTreeParserEnabled ())
+    return DeserializeSyntaxTree (start);
+  else
+    return DeserializeStream (start);
+}
+
+uint32_t
+Interest::DeserializeStream (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  CcnbParser::StreamParser parser (i);
+
+  uint32_t type, dtag;
+  if (!parser.ReadBlockHeader (type, dtag))
+    throw CcnbParser::CcnbDecodingException ();
+
+  if (type != CcnbParser::CCN_DTAG || dtag != CcnbParser::CCN_DTAG_Interest)
+    {
+      parser.SkipBlock (type, dtag);
+      return i.GetDistanceFrom (start);
+    }
+
+  // We don't care about any other fields
+  while (parser.ReadDtag (dtag))
+    {
+      switch (dtag)
+        {
+        case CcnbParser::CCN_DTAG_Name:
+          {
+            Ptr<Name> name = Create<Name> ();
+            parser.ReadName (*name);
+            m_interest->SetName (name);
+            break;
+          }
+        case CcnbParser::CCN_DTAG_Scope:
+          m_interest->SetScope (parser.ReadNonNegativeInteger ());
+          break;
+        case CcnbParser::CCN_DTAG_InterestLifetime:
+          m_interest->SetInterestLifetime (parser.ReadTimestamp ());
+          break;
+        case CcnbParser::CCN_DTAG_Nonce:
+          m_interest->SetNonce (parser.ReadUint32Blob ());
+          break;
+        case CcnbParser::CCN_DTAG_Nack:
+          m_interest->SetNack (parser.ReadNonNegativeInteger ());
+          break;
+        default:
+          parser.SkipBlock (CcnbParser::CCN_DTAG, dtag);
+          break;
+        }
+    }
+
+  return i.GetDistanceFrom (start);
+}
+
+uint32_t
+Interest::DeserializeSyntaxTree (Buffer::Iterator start)
 {
   static InterestVisitor interestVisitor;
 
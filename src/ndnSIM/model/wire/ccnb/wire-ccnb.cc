@@ -23,13 +23,24 @@
 #include <sstream>
 #include <boost/foreach.hpp>
 #include "ccnb-parser/common.h"
+#include "ccnb-parser/stream-parser.h"
 #include "ccnb-parser/visitors/name-visitor.h"
 #include "ccnb-parser/syntax-tree/block.h"
 
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
+
 NDN_NAMESPACE_BEGIN
 
 namespace wire {
 
+static
+GlobalValue g_ccnbSyntaxTreeParser ("ndn::CcnbSyntaxTreeParser",
+                                    "Decode CCNb packets using the syntax tree parser and visitors "
+                                    "(reference implementation) instead of the single-pass stream parser",
+                                    BooleanValue (false),
+                                    MakeBooleanChecker ());
+
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
@@ -247,14 +258,36 @@ Ptr<Name>
 Ccnb::DeserializeName (Buffer::Iterator &i)
 {
   Ptr<Name> name = Create<Name> ();
-  CcnbParser::NameVisitor nameVisitor;
 
-  Ptr<CcnbParser::Block> root = CcnbParser::Block::ParseBlock (i);
-  root->accept (nameVisitor, GetPointer (name));
+  if (IsSyntaxTreeParserEnabled ())
+    {
+      CcnbParser::NameVisitor nameVisitor;
+
+      Ptr<CcnbParser::Block> root = CcnbParser::Block::ParseBlock (i);
+      root->accept (nameVisitor, GetPointer (name));
+    }
+  else
+    {
+      CcnbParser::StreamParser parser (i);
+
+      uint32_t dtag;
+      if (!parser.ReadDtag (dtag))
+        throw CcnbParser::CcnbDecodingException ();
+      parser.ReadName (*name);
+    }
 
   return name;
 }
 
+bool
+Ccnb::IsSyntaxTreeParserEnabled ()
+{
+  // not cached, so the value can be changed between decodes (e.g., between simulations in one process)
+  BooleanValue value;
+  g_ccnbSyntaxTreeParser.GetValue (value);
+  return value.Get ();
+}
+
 } // wire
 
 NDN_NAMESPACE_END
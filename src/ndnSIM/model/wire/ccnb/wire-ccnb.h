@@ -235,6 +235,15 @@ public:
    */
   static Ptr<Name>
   DeserializeName (Buffer::Iterator &start);
+
+  /**
+   * @brief Check if CCNb packets should be decoded by building the syntax tree and walking it with
+   *        visitors (slower reference implementation), instead of the single-pass stream parser
+   *
+   * Controlled by "ndn::CcnbSyntaxTreeParser" global value (false by default), which is checked on every decode
+   */
+  static bool
+  IsSyntaxTreeParserEnabled ();
 }; // Ccnb
 
 
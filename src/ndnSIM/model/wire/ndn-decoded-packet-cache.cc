@@ -0,0 +1,215 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-decoded-packet-cache.h"
+
+#include "ns3/packet.h"
+#include "ns3/tag.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "ns3/ndn-header-helper.h"
+
+#include <deque>
+#include <boost/unordered_map.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.DecodedPacketCache");
+
+NDN_NAMESPACE_BEGIN
+
+/**
+ * @brief Packet tag that marks wire packets of the decoded objects stored in DecodedPacketCache
+ */
+class DecodedPacketTag : public Tag
+{
+public:
+  static TypeId
+  GetTypeId ()
+  {
+    static TypeId tid = TypeId ("ns3::ndn::DecodedPacketTag")
+      .SetParent<Tag> ()
+      .AddConstructor<DecodedPacketTag> ()
+      ;
+    return tid;
+  }
+
+  DecodedPacketTag (uint64_t id = 0) : m_id (id) { }
+
+  uint64_t
+  GetId () const { return m_id; }
+
+  virtual TypeId
+  GetInstanceTypeId () const { return GetTypeId (); }
+
+  virtual uint32_t
+  GetSerializedSize () const { return sizeof (uint64_t); }
+
+  virtual void
+  Serialize (TagBuffer i) const { i.WriteU64 (m_id); }
+
+  virtual void
+  Deserialize (TagBuffer i) { m_id = i.ReadU64 (); }
+
+  virtual void
+  Print (std::ostream &os) const { os << m_id; }
+
+private:
+  uint64_t m_id;
+};
+
+NS_OBJECT_ENSURE_REGISTERED (DecodedPacketTag);
+
+/// @cond include_hidden
+namespace {
+
+struct Snapshot
+{
+  Ptr<const Interest> m_interest;
+  Ptr<const Data> m_data;
+  uint32_t m_headerSize;
+  uint32_t m_trailerSize;
+};
+
+typedef boost::unordered_map<uint64_t, Snapshot> snapshots_container;
+typedef std::deque< std::pair<Time, uint64_t> > expirations_container;
+
+snapshots_container g_snapshots;
+expirations_container g_expirations;
+uint64_t g_lastId = 0;
+bool g_clearScheduled = false;
+
+const Time g_snapshotLifetime = Seconds (10);
+
+void
+Insert (Ptr<const Packet> wire, const Snapshot &snapshot)
+{
+  if (!g_clearScheduled)
+    {
+      Simulator::ScheduleDestroy (&DecodedPacketCache::Clear);
+      g_clearScheduled = true;
+    }
+
+  // remove expired snapshots
+  while (!g_expirations.empty () && g_expirations.front ().first <= Simulator::Now ())
+    {
+      g_snapshots.erase (g_expirations.front ().second);
+      g_expirations.pop_front ();
+    }
+
+  uint64_t id = ++g_lastId;
+  g_snapshots.insert (std::make_pair (id, snapshot));
+  g_expirations.push_back (std::make_pair (Simulator::Now () + g_snapshotLifetime, id));
+
+  wire->AddPacketTag (DecodedPacketTag (id));
+}
+
+}
+/// @endcond
+
+void
+DecodedPacketCache::AddInterest (Ptr<const Interest> interest)
+{
+  Ptr<const Packet> wire = interest->GetWire ();
+  DecodedPacketTag tag;
+  if (wire == 0 || wire->PeekPacketTag (tag))
+    return;
+
+  NS_LOG_FUNCTION (interest->GetName ());
+
+  Snapshot snapshot;
+  snapshot.m_interest = Create<Interest> (*interest);
+  snapshot.m_headerSize = wire->GetSize () - interest->GetPayload ()->GetSize ();
+  snapshot.m_trailerSize = 0;
+
+  Insert (wire, snapshot);
+}
+
+void
+DecodedPacketCache::AddData (Ptr<const Data> data)
+{
+  Ptr<const Packet> wire = data->GetWire ();
+  DecodedPacketTag tag;
+  if (wire == 0 || wire->PeekPacketTag (tag))
+    return;
+
+  NS_LOG_FUNCTION (data->GetName ());
+
+  Snapshot snapshot;
+  snapshot.m_data = Create<Data> (*data);
+  // ccnb-encoded Data has closing tags after the payload (see wire::ccnb::Data)
+  snapshot.m_trailerSize = (HeaderHelper::GetNdnHeaderType (wire) == HeaderHelper::CONTENT_OBJECT_CCNB) ? 2 : 0;
+  snapshot.m_headerSize = wire->GetSize () - data->GetPayload ()->GetSize () - snapshot.m_trailerSize;
+
+  Insert (wire, snapshot);
+}
+
+bool
+DecodedPacketCache::Lookup (Ptr<Packet> packet, Ptr<Interest> &interest, Ptr<Data> &data)
+{
+  DecodedPacketTag tag;
+  if (!packet->PeekPacketTag (tag))
+    return false;
+
+  snapshots_container::const_iterator item = g_snapshots.find (tag.GetId ());
+  if (item == g_snapshots.end ())
+    {
+      NS_LOG_DEBUG ("Snapshot " << tag.GetId () << " is no longer available");
+      packet->RemovePacketTag (tag);
+      return false;
+    }
+
+  const Snapshot &snapshot = item->second;
+
+  Ptr<Packet> wire = packet->Copy ();
+  packet->RemovePacketTag (tag);
+  packet->RemoveAtStart (snapshot.m_headerSize);
+  packet->RemoveAtEnd (snapshot.m_trailerSize);
+
+  if (snapshot.m_interest != 0)
+    {
+      interest = Create<Interest> (*snapshot.m_interest);
+      interest->SetPayload (packet);
+      interest->SetWire (wire);
+    }
+  else
+    {
+      data = Create<Data> (*snapshot.m_data);
+      data->SetPayload (packet);
+      data->SetWire (wire);
+    }
+
+  return true;
+}
+
+uint32_t
+DecodedPacketCache::GetSize ()
+{
+  return g_snapshots.size ();
+}
+
+void
+DecodedPacketCache::Clear ()
+{
+  g_snapshots.clear ();
+  g_expirations.clear ();
+  g_clearScheduled = false;
+}
+
+NDN_NAMESPACE_END
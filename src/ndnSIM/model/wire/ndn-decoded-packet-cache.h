@@ -0,0 +1,100 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_DECODED_PACKET_CACHE_H
+#define NDN_DECODED_PACKET_CACHE_H
+
+#include "ns3/ndn-common.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+
+NDN_NAMESPACE_BEGIN
+
+/**
+ * @ingroup ndn-face
+ * @brief Cache of decoded Interest and Data packets, allowing to skip decoding of the same
+ *        packet on every hop
+ *
+ * When Interest or Data is decoded from the wire (Wire::ToInterest, Wire::ToData), its wire
+ * packet is kept inside the decoded object and reused when the object is sent out unmodified.
+ * DecodedPacketCache::AddInterest and DecodedPacketCache::AddData store a snapshot of such a
+ * decoded object and mark its wire packet with a packet tag.  When the marked packet is received
+ * on the next hop,
+ * DecodedPacketCache::Lookup returns a copy of the snapshot with the payload and wire taken
+ * from the received packet (i.e., with all per-hop packet tags), as if the packet was decoded.
+ *
+ * Packets are still fully encoded and all the decoded fields are exactly the same as with
+ * decoding (including precision losses of the wire format), since the snapshot is taken after
+ * the first decoding.  If the object is modified, it gets a new wire packet without the mark.
+ *
+ * Snapshots are kept for 10 seconds (of simulation time) after they have been added.  If a
+ * marked packet is received after its snapshot has been removed, the packet is decoded as usual.
+ *
+ * @see NetDeviceFace (DecodeOnce attribute)
+ */
+class DecodedPacketCache
+{
+public:
+  /**
+   * @brief Store snapshot of the Interest, decoded using Wire::ToInterest, and mark its wire packet
+   *
+   * Nothing is done if the Interest does not have a wire packet or the wire packet is already marked
+   */
+  static void
+  AddInterest (Ptr<const Interest> interest);
+
+  /**
+   * @brief Store snapshot of the Data, decoded using Wire::ToData, and mark its wire packet
+   *
+   * Nothing is done if the Data does not have a wire packet or the wire packet is already marked
+   */
+  static void
+  AddData (Ptr<const Data> data);
+
+  /**
+   * @brief Get decoded Interest or Data for the received packet
+   *
+   * @param packet Received packet.  On success, packet becomes payload of the returned object.
+   *               If the packet is marked, but the snapshot is no longer available, the mark is
+   *               removed from the packet
+   * @param interest Decoded Interest (set only if packet is a marked Interest)
+   * @param data Decoded Data (set only if packet is a marked Data)
+   *
+   * @returns true if Interest or Data has been found in the cache
+   */
+  static bool
+  Lookup (Ptr<Packet> packet, Ptr<Interest> &interest, Ptr<Data> &data);
+
+  /**
+   * @brief Get number of snapshots in the cache
+   */
+  static uint32_t
+  GetSize ();
+
+  /**
+   * @brief Remove all snapshots from the cache (done automatically at the end of the simulation)
+   */
+  static void
+  Clear ();
+};
+
+NDN_NAMESPACE_END
+
+#endif // NDN_DECODED_PACKET_CACHE_H
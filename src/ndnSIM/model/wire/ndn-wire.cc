@@ -16,6 +16,7 @@
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-data.h"
 #include "ns3/ndn-header-helper.h"
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
 #include "ndnsim.h"
 #include "ndnsim/wire-ndnsim.h"
@@ -118,15 +119,32 @@ Wire::FromData (Ptr<const Data> data, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*
   if (wireFormat == WIRE_FORMAT_DEFAULT)
     wireFormat = GetWireFormat ();
 
+  Ptr<Packet> packet;
   if (wireFormat == WIRE_FORMAT_NDNSIM)
-    return wire::ndnSIM::Data::ToWire (data);
+    packet = wire::ndnSIM::Data::ToWire (data);
   else if (wireFormat == WIRE_FORMAT_CCNB)
-    return wire::ccnb::Data::ToWire (data);
+    packet = wire::ccnb::Data::ToWire (data);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
       return 0;
     }
+
+  if (data->IsOverlay ())
+    {
+      // packet tags belong to the shared payload, not to this transmission
+      packet->RemoveAllPacketTags ();
+    }
+
+  FwHopCountTag hopCountTag;
+  if (data->PeekHopCountTag (hopCountTag))
+    {
+      FwHopCountTag oldTag;
+      packet->RemovePacketTag (oldTag);
+      packet->AddPacketTag (hopCountTag);
+    }
+
+  return packet;
 }
 
 Ptr<Data>
@@ -121,7 +121,7 @@ NDN_NAMESPACE_END
 namespace boost
 {
 inline std::size_t
-hash_value (const ns3::ndn::Blob v)
+hash_value (const ns3::ndn::Blob &v)
 {
   return boost::hash_range (v.begin(), v.end());
 }
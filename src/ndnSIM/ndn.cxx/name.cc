@@ -28,10 +28,12 @@ ATTRIBUTE_HELPER_CPP (Name);
 ///////////////////////////////////////////////////////////////////////////////
 
 Name::Name ()
+  : m_size (0)
 {
 }
 
 Name::Name (const string &uri)
+  : m_size (0)
 { 
   string::const_iterator i = uri.begin ();
   string::const_iterator end = uri.end ();
@@ -100,17 +102,127 @@ Name::Name (const string &uri)
 }
 
 Name::Name (const Name &other)
+  : m_storage (other.share ())
+  , m_size (other.m_size)
 {
-  m_comps = other.m_comps;
 }
 
 Name &
 Name::operator= (const Name &other)
 {
-  m_comps = other.m_comps;
+  if (this != &other)
+    {
+      m_storage = other.share ();
+      m_size = other.m_size;
+    }
   return *this;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//                             STORAGE HELPERS                               //
+///////////////////////////////////////////////////////////////////////////////
+
+Ptr<Name::Storage>
+Name::share () const
+{
+  if (m_storage != 0 && m_storage->leaked)
+    rehash ();
+
+  return m_storage;
+}
+
+Ptr<Name::Storage>
+Name::flatten () const
+{
+  Ptr<Storage> storage = Create<Storage> ();
+  storage->comps.reserve (m_size);
+  storage->hashes.reserve (m_size);
+
+  size_t hash = 0;
+  for (size_t i = 0; i < m_size; i++)
+    {
+      storage->comps.push_back (component (i));
+      boost::hash_combine (hash, boost::hash_value (storage->comps.back ()));
+      storage->hashes.push_back (hash);
+    }
+  return storage;
+}
+
+void
+Name::detach ()
+{
+  if (m_storage == 0)
+    {
+      m_storage = Create<Storage> ();
+    }
+  else if (m_storage->GetReferenceCount () > 1 ||
+           m_storage->prefix != 0 ||
+           m_storage->comps.size () != m_size)
+    {
+      m_storage = flatten ();
+    }
+
+  m_storage->leaked = true;
+}
+
+void
+Name::rehash () const
+{
+  // leaked storage is always flat and owned only by this name (see detach)
+  Storage &storage = *PeekPointer (m_storage);
+  size_t hash = 0;
+  for (size_t i = 0; i < storage.comps.size (); i++)
+    {
+      boost::hash_combine (hash, boost::hash_value (storage.comps[i]));
+      storage.hashes[i] = hash;
+    }
+  storage.leaked = false;
+}
+
+Name::Storage &
+Name::prepareAppend ()
+{
+  if (m_storage == 0)
+    {
+      m_storage = Create<Storage> ();
+      return *m_storage;
+    }
+
+  if (m_storage->leaked)
+    rehash ();
+
+  if (m_storage->GetReferenceCount () == 1 && m_size >= m_storage->prefixSize)
+    {
+      // storage is not shared, drop components that are not part of the name (if any) and extend in place
+      m_storage->comps.resize (m_size - m_storage->prefixSize);
+      m_storage->hashes.resize (m_size - m_storage->prefixSize);
+      return *m_storage;
+    }
+
+  if (m_storage->depth + 1 >= maxStorageDepth)
+    {
+      m_storage = flatten ();
+      return *m_storage;
+    }
+
+  // storage is shared and immutable, extend it with a new storage
+  Ptr<Storage> storage = Create<Storage> ();
+  storage->prefix = m_storage;
+  storage->prefixSize = m_size;
+  storage->depth = m_storage->depth + 1;
+  m_storage = storage;
+  return *m_storage;
+}
+
+void
+Name::finishAppend ()
+{
+  size_t hash = getPrefixHash (m_size);
+  boost::hash_combine (hash, boost::hash_value (m_storage->comps.back ()));
+  m_storage->hashes.push_back (hash);
+  m_size ++;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //                                SETTERS                                    //
 ///////////////////////////////////////////////////////////////////////////////
@@ -154,7 +266,7 @@ Name::get (int index) const
                              << error::msg ("Index out of range")
                              << error::pos (index));
     }
-  return m_comps [index];
+  return component (index);
 }
 
 name::Component &
@@ -171,7 +283,8 @@ Name::get (int index)
                              << error::msg ("Index out of range")
                              << error::pos (index));
     }
-  return m_comps [index];
+  detach ();
+  return const_cast<name::Component &> (component (index));
 }
 
 
@@ -198,9 +311,17 @@ Name::getSubName (size_t pos/* = 0*/, size_t len/* = Name::npos*/) const
                              << error::pos (len));
     }
 
+  if (pos == 0)
+    {
+      // prefix of the name, share components
+      retval.m_storage = share ();
+      retval.m_size = len;
+      return retval;
+    }
+
   for (size_t i = pos; i < pos + len; i++)
     {
-      retval.append (get (i));
+      retval.append (component (i));
     }
 
   return retval;
@@ -20,21 +20,44 @@
 
 #include "name-component.h"
 
+#include <iterator>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/functional/hash.hpp>
+
 NDN_NAMESPACE_BEGIN
 
 /**
  * @ingroup ndn-cxx
  * @brief Class for NDN Name
+ *
+ * Components are kept in reference-counted storage that is shared between copies of
+ * the name.  Storage that is shared is never modified: appending a component to a name
+ * that shares its storage creates a small new storage that refers to the shared one as
+ * to its immutable prefix.  As a result, copying a name and extending the copy (e.g.,
+ * adding a sequence number to a base prefix) does not copy any of the base components.
+ *
+ * Together with components, storage keeps hashes of all name prefixes (see getPrefixHash),
+ * so data structures that index names by prefix hashes do not need to rehash components.
+ *
+ * Non-const accessors (non-const iterators, get and operator[]) give the name its own
+ * flat copy of the components, which is not shared with any other name at that moment.
+ * Components can be modified through the returned references only until the name is
+ * copied, extended, or its prefix hashes are requested: at that point cached hashes are
+ * rebuilt and the storage can be shared again.
  */
 class Name : public SimpleRefCount<Name>
 {
+private:
+  template<class Value>
+  class component_iterator;
+
 public:
-  typedef std::vector<name::Component>::iterator iterator;
-  typedef std::vector<name::Component>::const_iterator const_iterator;
-  typedef std::vector<name::Component>::reverse_iterator reverse_iterator;
-  typedef std::vector<name::Component>::const_reverse_iterator const_reverse_iterator;
-  typedef std::vector<name::Component>::reference reference;
-  typedef std::vector<name::Component>::const_reference const_reference;
+  typedef component_iterator<name::Component> iterator;
+  typedef component_iterator<const name::Component> const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef name::Component &reference;
+  typedef const name::Component &const_reference;
 
   typedef name::Component partial_type;
   
@@ -222,6 +245,18 @@ public:
   inline size_t
   size () const;
 
+  /**
+   * @brief Get hash of the name prefix
+   * @param len number of components in the prefix (len <= size ())
+   *
+   * Hash of an empty prefix is zero, hash of each longer prefix is obtained as
+   * boost::hash_combine (hash, boost::hash_value (component)) from the hash of
+   * the prefix that is one component shorter.  Hashes are cached, the call does
+   * not touch the components.
+   */
+  inline size_t
+  getPrefixHash (size_t len) const;
+
   /**
    * @brief Get binary blob of name component
    * @param index index of the name component.  If less than 0, then getting component from the back:
@@ -395,7 +430,114 @@ public:
   const static uint64_t nversion = static_cast<uint64_t> (-1);
 
 private:
-  std::vector<name::Component> m_comps;
+  /**
+   * @brief Reference-counted component storage
+   *
+   * Storage keeps components [prefixSize, prefixSize + comps.size ()) of the name, the
+   * first prefixSize components are kept in the (immutable) prefix storage.
+   */
+  struct Storage : public SimpleRefCount<Storage>
+  {
+    Storage () : prefixSize (0), depth (0), leaked (false) { }
+
+    Ptr<Storage> prefix;          ///< @brief storage with the first prefixSize components (can be 0)
+    size_t prefixSize;            ///< @brief number of components in the prefix storage
+    uint32_t depth;               ///< @brief number of storages in the prefix chain
+    bool leaked;                  ///< @brief components were given out for modification, cached hashes cannot be trusted
+    std::vector<name::Component> comps; ///< @brief components that belong to this storage
+    std::vector<size_t> hashes;   ///< @brief hashes[i] is the hash of the prefix that ends with comps[i]
+  };
+
+  /// @brief Maximum number of storages in the prefix chain, longer chains are flattened
+  static const uint32_t maxStorageDepth = 4;
+
+  inline const name::Component &
+  component (size_t index) const;
+
+  Ptr<Storage>
+  share () const;
+
+  Ptr<Storage>
+  flatten () const;
+
+  void
+  detach ();
+
+  void
+  rehash () const;
+
+  Storage &
+  prepareAppend ();
+
+  void
+  finishAppend ();
+
+private:
+  Ptr<Storage> m_storage;
+  size_t m_size;
+};
+
+/**
+ * @brief Random access iterator over name components
+ *
+ * Iterator keeps position inside the name, so it is not invalidated when new
+ * components are appended to the name
+ */
+template<class Value>
+class Name::component_iterator
+  : public boost::iterator_facade<component_iterator<Value>, Value, boost::random_access_traversal_tag>
+{
+public:
+  component_iterator ()
+    : m_name (0)
+    , m_index (0)
+  {
+  }
+
+  component_iterator (const Name *name, size_t index)
+    : m_name (name)
+    , m_index (index)
+  {
+  }
+
+  template<class OtherValue>
+  component_iterator (const component_iterator<OtherValue> &other)
+    : m_name (other.m_name)
+    , m_index (other.m_index)
+  {
+  }
+
+private:
+  friend class boost::iterator_core_access;
+  template<class> friend class component_iterator;
+
+  Value &
+  dereference () const
+  {
+    return const_cast<Value &> (m_name->component (m_index));
+  }
+
+  template<class OtherValue>
+  bool
+  equal (const component_iterator<OtherValue> &other) const
+  {
+    return m_index == other.m_index;
+  }
+
+  void increment () { m_index ++; }
+  void decrement () { m_index --; }
+  void advance (std::ptrdiff_t n) { m_index += n; }
+
+  template<class OtherValue>
+  std::ptrdiff_t
+  distance_to (const component_iterator<OtherValue> &other) const
+  {
+    return static_cast<std::ptrdiff_t> (other.m_index) - static_cast<std::ptrdiff_t> (m_index);
+  }
+
+private:
+  const Name *m_name;
+  size_t m_index;
 };
 
 inline std::ostream &
@@ -421,6 +563,7 @@ operator >> (std::istream &is, Name &name)
 
 template<class Iterator>
 Name::Name (Iterator begin, Iterator end)
+  : m_size (0)
 {
   append (begin, end);
 }
@@ -429,7 +572,10 @@ inline Name &
 Name::append (const name::Component &comp)
 {
   if (comp.size () != 0)
-    m_comps.push_back (comp);
+    {
+      prepareAppend ().comps.push_back (comp);
+      finishAppend ();
+    }
   return *this;
 }
 
@@ -438,8 +584,10 @@ Name::appendBySwap (name::Component &comp)
 {
   if (comp.size () != 0)
     {
-      Name::iterator newComp = m_comps.insert (end (), name::Component ());
-      newComp->swap (comp);
+      Storage &storage = prepareAppend ();
+      storage.comps.push_back (name::Component ());
+      storage.comps.back ().swap (comp);
+      finishAppend ();
     }
   return *this;
 }
@@ -458,6 +606,12 @@ Name::append (Iterator begin, Iterator end)
 Name &
 Name::append (const Name &comp)
 {
+  if (size () == 0)
+    {
+      // nothing to extend, just share components of the other name
+      return *this = comp;
+    }
+
   if (this == &comp)
     {
       // have to double-copy if the object is self, otherwise results very frustrating (because we use vector...)
@@ -515,7 +669,36 @@ Name::appendBlkId (uint64_t blkid)
 inline size_t
 Name::size () const
 {
-  return m_comps.size ();
+  return m_size;
+}
+
+inline const name::Component &
+Name::component (size_t index) const
+{
+  const Storage *storage = GetPointer (m_storage);
+  while (index < storage->prefixSize)
+    {
+      storage = GetPointer (storage->prefix);
+    }
+  return storage->comps [index - storage->prefixSize];
+}
+
+inline size_t
+Name::getPrefixHash (size_t len) const
+{
+  if (len == 0)
+    return 0;
+
+  const Storage *storage = GetPointer (m_storage);
+  while (len - 1 < storage->prefixSize)
+    {
+      storage = GetPointer (storage->prefix);
+    }
+
+  if (storage->leaked)
+    rehash ();
+
+  return storage->hashes [len - 1 - storage->prefixSize];
 }
 
 /////
@@ -524,50 +707,52 @@ Name::size () const
 inline Name::const_iterator
 Name::begin () const
 {
-  return m_comps.begin ();
+  return const_iterator (this, 0);
 }
 
 inline Name::iterator
 Name::begin ()
 {
-  return m_comps.begin ();
+  detach ();
+  return iterator (this, 0);
 }
 
 inline Name::const_iterator
 Name::end () const
 {
-  return m_comps.end ();
+  return const_iterator (this, m_size);
 }
 
 inline Name::iterator
 Name::end ()
 {
-  return m_comps.end ();
+  detach ();
+  return iterator (this, m_size);
 }
 
 inline Name::const_reverse_iterator
 Name::rbegin () const
 {
-  return m_comps.rbegin ();
+  return const_reverse_iterator (end ());
 }
 
 inline Name::reverse_iterator
 Name::rbegin ()
 {
-  return m_comps.rbegin ();
+  return reverse_iterator (end ());
 }
 
 inline Name::const_reverse_iterator
 Name::rend () const
 {
-  return m_comps.rend ();
+  return const_reverse_iterator (begin ());
 }
 
 
 inline Name::reverse_iterator
 Name::rend ()
 {
-  return m_comps.rend ();
+  return reverse_iterator (begin ());
 }
 
 
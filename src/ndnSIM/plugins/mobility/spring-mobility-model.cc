@@ -26,6 +26,10 @@
 
 #include <boost/foreach.hpp>
 
+#include <cmath>
+#include <vector>
+#include <limits>
+
 NS_LOG_COMPONENT_DEFINE ("SpringMobilityModel");
 
 namespace ns3 {
@@ -36,9 +40,126 @@ double SpringMobilityModel::m_totalKineticEnergy = 0.0;
 bool SpringMobilityModel::m_stable = false;
 EventId SpringMobilityModel::m_updateEvent;
 double SpringMobilityModel::m_epsilon = 100.0;
+Time SpringMobilityModel::m_resetTime;
 
 const double COLOUMB_K = 200; 
 
+namespace {
+
+const uint32_t NONE = std::numeric_limits<uint32_t>::max ();
+const uint32_t MAX_DEPTH = 32; // deeper cells are not split (nodes with almost the same coordinates)
+
+/**
+ * Models and positions of all nodes, in the order of NodeList (filled for the duration of UpdateAll).
+ * Positions are kept in separate contiguous arrays, so the exact force calculation is a plain loop
+ */
+std::vector<SpringMobilityModel*> g_models;
+std::vector<double> g_x;
+std::vector<double> g_y;
+std::vector<double> g_z;
+
+/**
+ * Cell of the quadtree, built from node positions at the beginning of UpdateAll
+ */
+struct Cell
+{
+  double centerX, centerY, halfSize; // square bounds of the cell
+  double sumX, sumY, sumZ;           // sum of node positions (center of mass multiplied by count)
+  uint32_t count;                    // number of nodes in the cell
+  uint32_t children;                 // index of the first of 4 children, NONE for a leaf
+  uint32_t first;                    // first node in a leaf (NONE if empty), others linked through g_next
+};
+
+std::vector<Cell> g_cells;
+std::vector<uint32_t> g_next;
+std::vector<uint32_t> g_stack;
+
+uint32_t
+AddCell (double centerX, double centerY, double halfSize)
+{
+  Cell cell = { centerX, centerY, halfSize, 0, 0, 0, 0, NONE, NONE };
+  g_cells.push_back (cell);
+  return g_cells.size () - 1;
+}
+
+uint32_t
+GetChild (const Cell &cell, uint32_t node)
+{
+  return cell.children + (g_x[node] >= cell.centerX ? 1 : 0) + (g_y[node] >= cell.centerY ? 2 : 0);
+}
+
+void
+InsertNode (uint32_t cellIndex, uint32_t node, uint32_t depth)
+{
+  while (true)
+    {
+      Cell &cell = g_cells[cellIndex];
+      cell.count ++;
+      cell.sumX += g_x[node];
+      cell.sumY += g_y[node];
+      cell.sumZ += g_z[node];
+
+      if (cell.children != NONE)
+        {
+          cellIndex = GetChild (cell, node);
+          depth ++;
+          continue;
+        }
+
+      if (cell.first == NONE || depth >= MAX_DEPTH)
+        {
+          g_next[node] = cell.first;
+          cell.first = node;
+          return;
+        }
+
+      // split the leaf (it has exactly one node) and move its node to a child
+      uint32_t other = cell.first;
+      double quarter = cell.halfSize / 2;
+      double centerX = cell.centerX;
+      double centerY = cell.centerY;
+      cell.first = NONE;
+
+      uint32_t children = AddCell (centerX - quarter, centerY - quarter, quarter); // invalidates cell
+      AddCell (centerX + quarter, centerY - quarter, quarter);
+      AddCell (centerX - quarter, centerY + quarter, quarter);
+      AddCell (centerX + quarter, centerY + quarter, quarter);
+      g_cells[cellIndex].children = children;
+
+      InsertNode (GetChild (g_cells[cellIndex], other), other, depth + 1);
+
+      cellIndex = GetChild (g_cells[cellIndex], node);
+      depth ++;
+    }
+}
+
+void
+BuildQuadtree ()
+{
+  g_cells.clear ();
+  g_next.assign (g_models.size (), NONE);
+  if (g_models.empty ())
+    return;
+
+  double minX = g_x[0], maxX = g_x[0], minY = g_y[0], maxY = g_y[0];
+  for (uint32_t node = 1; node < g_models.size (); node++)
+    {
+      minX = std::min (minX, g_x[node]);
+      maxX = std::max (maxX, g_x[node]);
+      minY = std::min (minY, g_y[node]);
+      maxY = std::max (maxY, g_y[node]);
+    }
+
+  double halfSize = std::max (maxX - minX, maxY - minY) / 2 + 1.0;
+  uint32_t root = AddCell ((minX + maxX) / 2, (minY + maxY) / 2, halfSize);
+  for (uint32_t node = 0; node < g_models.size (); node++)
+    {
+      InsertNode (root, node, 0);
+    }
+}
+
+}
+
 TypeId SpringMobilityModel::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SpringMobilityModel")
@@ -68,6 +189,12 @@ TypeId SpringMobilityModel::GetTypeId (void)
                    DoubleValue (0.8),
                    MakeDoubleAccessor (&SpringMobilityModel::m_dampingFactor),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("Theta", "Accuracy of Barnes-Hut approximation of repulsive forces "
+                   "(ratio of cell size to the distance, below which all nodes in the cell are replaced by one particle). "
+                   "0 means that forces are calculated exactly (in O(N^2) time)",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&SpringMobilityModel::m_theta),
+                   MakeDoubleChecker<double> (0.0))
     ;
   
   return tid;
@@ -99,15 +226,36 @@ SpringMobilityModel::DoStart ()
 void
 SpringMobilityModel::UpdateAll ()
 {
+  g_models.clear ();
+  g_x.clear ();
+  g_y.clear ();
+  g_z.clear ();
+
+  bool approximate = false;
   for (NodeList::Iterator node = NodeList::Begin ();
        node != NodeList::End ();
        node++)
     {
       Ptr<SpringMobilityModel> model = (*node)->GetObject<SpringMobilityModel> ();
       if (model != 0)
-        model->Update ();
+        {
+          g_models.push_back (PeekPointer (model));
+          g_x.push_back (model->m_position.x);
+          g_y.push_back (model->m_position.y);
+          g_z.push_back (model->m_position.z);
+          approximate = approximate || (model->m_theta > 0);
+        }
     }
 
+  if (approximate)
+    BuildQuadtree ();
+
+  for (uint32_t index = 0; index < g_models.size (); index++)
+    {
+      g_models[index]->Update (index);
+    }
+  g_models.clear ();
+
   if (m_totalKineticEnergy < m_epsilon)
     {
       m_stable = true;
@@ -117,13 +265,96 @@ SpringMobilityModel::UpdateAll ()
     m_updateEvent = Simulator::Schedule (Seconds(0.05), SpringMobilityModel::UpdateAll);  
 }
 
+Vector
+SpringMobilityModel::GetExactForce (uint32_t index) const
+{
+  double x = g_x[index], y = g_y[index], z = g_z[index];
+  double forceX = 0.0, forceY = 0.0, forceZ = 0.0;
+
+  for (uint32_t node = 0; node < g_models.size (); node++)
+    {
+      if (node == index) continue;
+
+      double dx = x - g_x[node], dy = y - g_y[node], dz = z - g_z[node];
+      double distance = std::sqrt (dx * dx + dy * dy + dz * dz);
+      if (distance < 0.1) continue;
+
+      // (dx, dy, dz) / distance is direction vector of size 1, force trying to take nodes apart
+      forceX += dx / distance * COLOUMB_K * m_nodeCharge * m_nodeCharge / distance / distance;
+      forceY += dy / distance * COLOUMB_K * m_nodeCharge * m_nodeCharge / distance / distance;
+      forceZ += dz / distance * COLOUMB_K * m_nodeCharge * m_nodeCharge / distance / distance;
+    }
+
+  return Vector (forceX, forceY, forceZ);
+}
+
+Vector
+SpringMobilityModel::GetApproximateForce (uint32_t index) const
+{
+  double x = g_x[index], y = g_y[index], z = g_z[index];
+  double forceX = 0.0, forceY = 0.0, forceZ = 0.0;
+  double k = COLOUMB_K * m_nodeCharge * m_nodeCharge;
+
+  g_stack.clear ();
+  g_stack.push_back (0);
+  while (!g_stack.empty ())
+    {
+      const Cell &cell = g_cells[g_stack.back ()];
+      g_stack.pop_back ();
+      if (cell.count == 0) continue;
+
+      if (cell.children == NONE)
+        {
+          for (uint32_t node = cell.first; node != NONE; node = g_next[node])
+            {
+              if (node == index) continue;
+
+              double dx = x - g_x[node], dy = y - g_y[node], dz = z - g_z[node];
+              double distance = std::sqrt (dx * dx + dy * dy + dz * dz);
+              if (distance < 0.1) continue;
+
+              double scale = k / distance / distance / distance;
+              forceX += dx * scale;
+              forceY += dy * scale;
+              forceZ += dz * scale;
+            }
+          continue;
+        }
+
+      double dx = x - cell.sumX / cell.count;
+      double dy = y - cell.sumY / cell.count;
+      double dz = z - cell.sumZ / cell.count;
+      double distance = std::sqrt (dx * dx + dy * dy + dz * dz);
+
+      bool inside = std::abs (x - cell.centerX) <= cell.halfSize && std::abs (y - cell.centerY) <= cell.halfSize;
+      if (!inside && 2 * cell.halfSize < m_theta * distance)
+        {
+          // all nodes of the cell are replaced by one particle in their center of mass
+          double scale = k * cell.count / distance / distance / distance;
+          forceX += dx * scale;
+          forceY += dy * scale;
+          forceZ += dz * scale;
+        }
+      else
+        {
+          for (uint32_t child = 0; child < 4; child++)
+            g_stack.push_back (cell.children + child);
+        }
+    }
+
+  return Vector (forceX, forceY, forceZ);
+}
+
 void
-SpringMobilityModel::Update () const
+SpringMobilityModel::Update (uint32_t index) const
 {
   NS_LOG_FUNCTION (this << m_stable << m_position << m_velocity);
   if (m_stable) return;
   Time now = Simulator::Now ();
 
+  if (m_lastTime < m_resetTime)
+    m_lastTime = m_resetTime;
+
   if (now <= m_lastTime)
     {
       m_lastTime = now;
@@ -133,24 +364,7 @@ SpringMobilityModel::Update () const
   double time_step_s = (now - m_lastTime).ToDouble (Time::S);
   m_lastTime = now;
 
-  Vector force (0.0, 0.0, 0.0);
-
-  for (NodeList::Iterator node = NodeList::Begin ();
-       node != NodeList::End ();
-       node++)
-    {
-      if ((*node)->GetId () == GetObject<Node> ()->GetId ()) continue;
-      Ptr<SpringMobilityModel> model = (*node)->GetObject<SpringMobilityModel> ();
-      if (model == 0) continue;
-      if (model == this) continue;
-
-      double distance = GetDistanceFrom (model);
-      if (distance < 0.1) continue;
-
-      Vector direction = (GetPosition () - model->GetPosition ()) / distance; // direction vector of size 1, force trying to take nodes apart
-
-      force += direction * COLOUMB_K * m_nodeCharge * m_nodeCharge / distance / distance;
-    }
+  Vector force = (m_theta > 0) ? GetApproximateForce (index) : GetExactForce (index);
 
   BOOST_FOREACH (Ptr<MobilityModel> model, m_springs)
     {
@@ -169,6 +383,9 @@ SpringMobilityModel::Update () const
   // Correct velocity and position
   m_velocity = (m_velocity + force * time_step_s) * m_dampingFactor;
   m_position += m_velocity * time_step_s;
+  g_x[index] = m_position.x;
+  g_y[index] = m_position.y;
+  g_z[index] = m_position.z;
 
   // Add new value for the kinetic energy
   velocityValue = CalculateDistance (m_velocity, Vector(0,0,0)); 
@@ -192,15 +409,8 @@ SpringMobilityModel::DoSetPosition (const Vector &position)
   NotifyCourseChange ();
   m_stable = false;
 
-
-  for (NodeList::Iterator node = NodeList::Begin ();
-       node != NodeList::End ();
-       node++)
-    {
-      Ptr<SpringMobilityModel> model = (*node)->GetObject<SpringMobilityModel> ();
-      if (model != 0)
-        model->m_lastTime = Simulator::Now ();
-    }
+  // all nodes start moving from now (see Update)
+  m_resetTime = Simulator::Now ();
   
   if (!m_updateEvent.IsRunning ())
     m_updateEvent = Simulator::Schedule (Seconds(0.05), SpringMobilityModel::UpdateAll);
@@ -29,7 +29,14 @@ namespace ns3 {
 /**
  * \ingroup mobility
  *
- * \brief 
+ * \brief Force-directed layout: nodes are attached by springs and repel each other as charged particles
+ *
+ * Positions of all nodes are updated every 50ms, until total kinetic energy becomes small enough.
+ * By default, repulsive forces are calculated exactly, i.e., in O(N^2) time for each update.
+ * For large graphs, Theta attribute can be set to use Barnes-Hut approximation (O(N log N)
+ * time): nodes in each cell of a quadtree (in x-y plane), which is seen from the node at angle
+ * less than Theta (cell size / distance to the cell's center of mass), are replaced by one
+ * particle with their total charge.
  */
 class SpringMobilityModel : public MobilityModel 
 {
@@ -64,9 +71,17 @@ private:
   virtual Vector 
   DoGetVelocity (void) const;
 
-  // Updating positions
+  // Updating positions (index in the arrays of node positions)
   void 
-  Update (void) const;
+  Update (uint32_t index) const;
+
+  // Repulsive force calculated exactly
+  Vector
+  GetExactForce (uint32_t index) const;
+
+  // Repulsive force calculated using quadtree
+  Vector
+  GetApproximateForce (uint32_t index) const;
 
   static void
   UpdateAll ();
@@ -79,10 +94,12 @@ private:
   double m_springNormalLength;
   double m_springConstant;
   double m_dampingFactor;
+  double m_theta;
 
   static double m_totalKineticEnergy;  
   static bool m_stable;
   static EventId m_updateEvent;
+  static Time m_resetTime; // time of the last position change, from which all nodes start moving
   
   mutable Vector m_position;
   mutable Vector m_velocity;
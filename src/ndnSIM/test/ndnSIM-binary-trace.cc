@@ -0,0 +1,84 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-binary-trace.h"
+#include "ns3/ndn-binary-trace.h"
+
+#include <sstream>
+
+namespace ns3
+{
+
+void
+BinaryTraceTest::Check (const std::string &file)
+{
+  std::ostringstream expected;
+  expected << "Time\tNode\tId\tType\tValue\n";
+
+  {
+    // small blocks, so records and dictionary entries span several blocks
+    ndn::BinaryTraceWriter writer (file, 3);
+    NS_TEST_ASSERT_MSG_EQ (writer.IsOpen (), true, file << " should be opened for writing");
+
+    writer.AddColumn ("Time",  ndn::BINARY_TRACE_DOUBLE);
+    writer.AddColumn ("Node",  ndn::BINARY_TRACE_STRING);
+    writer.AddColumn ("Id",    ndn::BINARY_TRACE_INT32);
+    writer.AddColumn ("Type",  ndn::BINARY_TRACE_STRING);
+    writer.AddColumn ("Value", ndn::BINARY_TRACE_DOUBLE);
+    writer.WriteHeader ("TestTracer", "Time\tNode\tId\tType\tValue");
+
+    for (uint32_t i = 0; i < 10; i++)
+      {
+        std::ostringstream node;
+        node << "node-" << (i % 4);
+        const char *type = (i % 2 == 0) ? "InInterests" : "OutData";
+
+        writer << (i * 0.1) << node.str () << static_cast<int32_t> (i) - 1 << type << (i / 1024.0);
+        writer.EndRecord ();
+
+        expected << (i * 0.1) << "\t" << node.str () << "\t" << static_cast<int32_t> (i) - 1 << "\t"
+                 << type << "\t" << (i / 1024.0) << "\n";
+      }
+  }
+
+  ndn::BinaryTraceReader reader (file);
+  NS_TEST_ASSERT_MSG_EQ (reader.IsOpen (), true, file << " should be a valid binary trace");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetType (), "TestTracer", "Incorrect trace type");
+
+  std::ostringstream text;
+  NS_TEST_ASSERT_MSG_EQ (reader.PrintText (text), true, file << " should be read completely");
+  NS_TEST_ASSERT_MSG_EQ (text.str (), expected.str (), "Text output does not match the written records");
+}
+
+void
+BinaryTraceTest::DoRun ()
+{
+  Check (CreateTempDirFilename ("trace.bin"));
+
+  if (ndn::BinaryTraceWriter::IsCompressionSupported ())
+    {
+      Check (CreateTempDirFilename ("trace.bin.gz"));
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (ndn::BinaryTraceWriter::IsBinaryTraceFile ("trace.bin.gz"), true, "");
+  NS_TEST_ASSERT_MSG_EQ (ndn::BinaryTraceWriter::IsBinaryTraceFile ("trace.txt"), false, "");
+}
+
+}
@@ -0,0 +1,140 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-ccnb-parser.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/model/wire/ccnb.h"
+#include "ns3/ndnSIM/model/wire/ccnb/ccnb-parser/common.h"
+#include "ns3/ndnSIM/model/wire/ccnb/wire-ccnb.h"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3 {
+
+using namespace ndn;
+
+static Buffer
+ToBuffer (Ptr<const Packet> packet)
+{
+  std::vector<uint8_t> bytes (packet->GetSize ());
+  packet->CopyData (&bytes[0], bytes.size ());
+
+  Buffer buffer;
+  buffer.AddAtStart (bytes.size ());
+  buffer.Begin ().Write (&bytes[0], bytes.size ());
+  return buffer;
+}
+
+void
+CcnbStreamParserTest::DoRun ()
+{
+  // Interest
+  Ptr<Interest> source = Create<Interest> ();
+  source->SetName (Create<Name> (boost::lexical_cast<Name> ("/test/stream/%00%01/long-component-0123456789")));
+  source->SetScope (2);
+  source->SetInterestLifetime (MilliSeconds (4250));
+  source->SetNonce (0xDEADBEEF);
+  source->SetNack (3);
+
+  Buffer interestBuffer = ToBuffer (wire::ccnb::Interest::ToWire (source));
+
+  Ptr<Interest> stream = Create<Interest> ();
+  Ptr<Interest> tree = Create<Interest> ();
+  uint32_t streamSize = wire::ccnb::Interest (stream).DeserializeStream (interestBuffer.Begin ());
+  uint32_t treeSize = wire::ccnb::Interest (tree).DeserializeSyntaxTree (interestBuffer.Begin ());
+
+  NS_TEST_ASSERT_MSG_EQ (streamSize, treeSize, "parsers consumed different number of bytes");
+  NS_TEST_ASSERT_MSG_EQ (streamSize, interestBuffer.GetSize (), "whole Interest should be consumed");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetName (), source->GetName (), "name failed");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetName (), tree->GetName (), "name differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetScope (), tree->GetScope (), "scope differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetInterestLifetime (), tree->GetInterestLifetime (), "lifetime differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetNonce (), source->GetNonce (), "nonce failed");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetNonce (), tree->GetNonce (), "nonce differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetNack (), tree->GetNack (), "NACK differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetScope (), 2, "scope failed");
+  NS_TEST_ASSERT_MSG_EQ (stream->GetNack (), 3, "NACK failed");
+  // timestamp is encoded with 1/4096 second precision
+  NS_TEST_ASSERT_MSG_EQ_TOL (stream->GetInterestLifetime ().GetSeconds (), 4.25, 0.001, "lifetime failed");
+
+  // truncated Interest
+  Buffer truncated = interestBuffer;
+  truncated.RemoveAtEnd (5);
+  bool thrown = false;
+  try
+    {
+      wire::ccnb::Interest (Create<Interest> ()).DeserializeStream (truncated.Begin ());
+    }
+  catch (wire::CcnbParser::CcnbDecodingException &)
+    {
+      thrown = true;
+    }
+  NS_TEST_ASSERT_MSG_EQ (thrown, true, "truncated Interest should not be accepted");
+
+  // Data
+  Ptr<Data> data = Create<Data> (Create<Packet> (1024));
+  data->SetName (Create<Name> (boost::lexical_cast<Name> ("/test/stream/data/%FF%FE")));
+  data->SetTimestamp (MilliSeconds (1234567)); // fraction with the high bit set in the last byte
+  data->SetFreshness (Seconds (10));
+  data->SetSignature (12345);
+  data->SetKeyLocator (Create<Name> (boost::lexical_cast<Name> ("/key/locator")));
+
+  Buffer dataBuffer = ToBuffer (wire::ccnb::Data::ToWire (data));
+
+  Ptr<Data> streamData = Create<Data> ();
+  Ptr<Data> treeData = Create<Data> ();
+  streamSize = wire::ccnb::Data (streamData).DeserializeStream (dataBuffer.Begin ());
+  treeSize = wire::ccnb::Data (treeData).DeserializeSyntaxTree (dataBuffer.Begin ());
+
+  NS_TEST_ASSERT_MSG_EQ (streamSize, treeSize, "parsers consumed different number of bytes");
+  NS_TEST_ASSERT_MSG_EQ (streamSize, dataBuffer.GetSize () - 1024 - 2, "only header should be consumed");
+  NS_TEST_ASSERT_MSG_EQ (streamData->GetName (), data->GetName (), "name failed");
+  NS_TEST_ASSERT_MSG_EQ (streamData->GetName (), treeData->GetName (), "name differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ (streamData->GetTimestamp (), treeData->GetTimestamp (), "timestamp differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ_TOL (streamData->GetTimestamp ().GetSeconds (), 1234.567, 0.001, "timestamp failed");
+  NS_TEST_ASSERT_MSG_EQ (streamData->GetFreshness (), Seconds (10), "freshness failed");
+  NS_TEST_ASSERT_MSG_EQ (streamData->GetFreshness (), treeData->GetFreshness (), "freshness differs from reference parser");
+  NS_TEST_ASSERT_MSG_EQ (streamData->GetSignature (), 12345, "signature failed");
+  NS_TEST_ASSERT_MSG_EQ (streamData->GetSignature (), treeData->GetSignature (), "signature differs from reference parser");
+  NS_TEST_ASSERT_MSG_NE (streamData->GetKeyLocator (), 0, "key locator failed");
+  NS_TEST_ASSERT_MSG_NE (treeData->GetKeyLocator (), 0, "key locator failed");
+  NS_TEST_ASSERT_MSG_EQ (*streamData->GetKeyLocator (), *data->GetKeyLocator (), "key locator failed");
+  NS_TEST_ASSERT_MSG_EQ (*streamData->GetKeyLocator (), *treeData->GetKeyLocator (), "key locator differs from reference parser");
+
+  // full round trip through the default (stream) parser
+  Ptr<Data> target = wire::ccnb::Data::FromWire (wire::ccnb::Data::ToWire (data));
+  NS_TEST_ASSERT_MSG_EQ (target->GetName (), data->GetName (), "name failed");
+  NS_TEST_ASSERT_MSG_EQ (target->GetPayload ()->GetSize (), 1024, "payload failed");
+
+  // switching parsers between decodes
+  Config::SetGlobal ("ndn::CcnbSyntaxTreeParser", BooleanValue (true));
+  NS_TEST_ASSERT_MSG_EQ (wire::Ccnb::IsSyntaxTreeParserEnabled (), true, "syntax tree parser should be enabled");
+  target = wire::ccnb::Data::FromWire (wire::ccnb::Data::ToWire (data));
+  NS_TEST_ASSERT_MSG_EQ (target->GetName (), data->GetName (), "name failed");
+
+  Config::SetGlobal ("ndn::CcnbSyntaxTreeParser", BooleanValue (false));
+  NS_TEST_ASSERT_MSG_EQ (wire::Ccnb::IsSyntaxTreeParserEnabled (), false, "syntax tree parser should be disabled");
+  Ptr<Interest> interest = wire::ccnb::Interest::FromWire (wire::ccnb::Interest::ToWire (source));
+  NS_TEST_ASSERT_MSG_EQ (interest->GetName (), source->GetName (), "name failed");
+}
+
+}
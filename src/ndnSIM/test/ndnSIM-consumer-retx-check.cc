@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-consumer-retx-check.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerRetxCheckTest");
+
+namespace ns3
+{
+
+void
+ConsumerRetxCheckTest::TransmittedInterest (Ptr<const ndn::Interest> interest, Ptr<ndn::App> app, Ptr<ndn::Face> face)
+{
+  std::ostringstream os;
+  os << Simulator::Now ().GetTimeStep () << " Interest " << interest->GetName ();
+  m_trace.push_back (os.str ());
+}
+
+void
+ConsumerRetxCheckTest::FirstDataDelay (Ptr<ndn::App> app, uint32_t seq, Time delay, uint32_t retxCount, int32_t hopCount)
+{
+  std::ostringstream os;
+  os << Simulator::Now ().GetTimeStep () << " FullDelay " << seq << " " << delay.GetTimeStep () << " " << retxCount << " " << hopCount;
+  m_trace.push_back (os.str ());
+
+  m_retransmissions += retxCount - 1;
+}
+
+void
+ConsumerRetxCheckTest::LastDataDelay (Ptr<ndn::App> app, uint32_t seq, Time delay, int32_t hopCount)
+{
+  std::ostringstream os;
+  os << Simulator::Now ().GetTimeStep () << " LastDelay " << seq << " " << delay.GetTimeStep () << " " << hopCount;
+  m_trace.push_back (os.str ());
+}
+
+void
+ConsumerRetxCheckTest::Run (const std::string &retxCheck)
+{
+  m_trace.clear ();
+  m_retransmissions = 0;
+
+  // consumer <--> router <--> producer, with Data lost on the router-consumer link and in the small queue
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("1Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  p2p.SetQueue ("ns3::DropTailQueue", "MaxPackets", StringValue ("5"));
+  NetDeviceContainer devices = p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+
+  // every 7th packet and a burst of packets received by the consumer are lost
+  std::list<uint32_t> lost;
+  for (uint32_t packet = 3; packet < 1000; packet += 7)
+    lost.push_back (packet);
+  for (uint32_t packet = 200; packet < 220; packet++)
+    lost.push_back (packet);
+  Ptr<ReceiveListErrorModel> errorModel = CreateObject<ReceiveListErrorModel> ();
+  errorModel->SetList (lost);
+  devices.Get (0)->SetAttribute ("ReceiveErrorModel", PointerValue (errorModel));
+
+  ndn::StackHelper ndn;
+  ndn.SetDefaultRoutes (true);
+  ndn.Install (nodes);
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("200"));
+  consumerHelper.SetAttribute ("MaxSeq", StringValue ("400"));
+  consumerHelper.SetAttribute ("RetxCheck", StringValue (retxCheck));
+  ApplicationContainer consumer = consumerHelper.Install (nodes.Get (0));
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.Install (nodes.Get (2));
+
+  consumer.Get (0)->TraceConnectWithoutContext ("TransmittedInterests",
+                                                MakeCallback (&ConsumerRetxCheckTest::TransmittedInterest, this));
+  consumer.Get (0)->TraceConnectWithoutContext ("FirstInterestDataDelay",
+                                                MakeCallback (&ConsumerRetxCheckTest::FirstDataDelay, this));
+  consumer.Get (0)->TraceConnectWithoutContext ("LastRetransmittedInterestDataDelay",
+                                                MakeCallback (&ConsumerRetxCheckTest::LastDataDelay, this));
+
+  Simulator::Stop (Seconds (20.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+ConsumerRetxCheckTest::DoRun ()
+{
+  Run ("Polling");
+  std::vector<std::string> polling;
+  polling.swap (m_trace);
+  uint32_t retransmissions = m_retransmissions;
+
+  Run ("OnDemand");
+
+  NS_TEST_ASSERT_MSG_GT (retransmissions, 0, "Losses should cause retransmissions");
+  NS_TEST_ASSERT_MSG_EQ (m_retransmissions, retransmissions, "Number of retransmissions should not depend on RetxCheck");
+  NS_TEST_ASSERT_MSG_EQ (m_trace.size (), polling.size (), "Traces should not depend on RetxCheck");
+  for (size_t i = 0; i < m_trace.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_trace[i], polling[i], "Traces should not depend on RetxCheck");
+    }
+}
+
+}
@@ -0,0 +1,69 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_TEST_CONSUMER_RETX_CHECK_H
+#define NDNSIM_TEST_CONSUMER_RETX_CHECK_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+namespace ndn {
+class App;
+class Face;
+class Interest;
+}
+
+class ConsumerRetxCheckTest : public TestCase
+{
+public:
+  ConsumerRetxCheckTest ()
+    : TestCase ("Polling and on-demand retransmission checks of consumer test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  Run (const std::string &retxCheck);
+
+  void
+  TransmittedInterest (Ptr<const ndn::Interest> interest, Ptr<ndn::App> app, Ptr<ndn::Face> face);
+
+  void
+  FirstDataDelay (Ptr<ndn::App> app, uint32_t seq, Time delay, uint32_t retxCount, int32_t hopCount);
+
+  void
+  LastDataDelay (Ptr<ndn::App> app, uint32_t seq, Time delay, int32_t hopCount);
+
+private:
+  std::vector<std::string> m_trace; // transmitted Interests and delays of received Data
+  uint32_t m_retransmissions;
+};
+
+}
+
+#endif // NDNSIM_TEST_CONSUMER_RETX_CHECK_H
@@ -0,0 +1,83 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-cs-hop-count.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.CsHopCountTest");
+
+namespace ns3
+{
+
+void
+CsHopCountTest::DataDelay (Ptr<ndn::App> app, uint32_t seq, Time delay, int32_t hopCount)
+{
+  m_hopCounts[PeekPointer (app) == m_first ? 0 : 1][seq] = hopCount;
+}
+
+void
+CsHopCountTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.SetDefaultRoutes (true);
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  // the second consumer requests the same Data after the first one, getting it from the local cache
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10"));
+  consumerHelper.SetAttribute ("MaxSeq", StringValue ("5"));
+  ApplicationContainer first = consumerHelper.Install (node);
+  ApplicationContainer second = consumerHelper.Install (node);
+  second.Start (Seconds (1.0));
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.Install (nodeSink);
+
+  m_first = PeekPointer (DynamicCast<ndn::App> (first.Get (0)));
+  first.Get (0)->TraceConnectWithoutContext ("LastRetransmittedInterestDataDelay",
+                                             MakeCallback (&CsHopCountTest::DataDelay, this));
+  second.Get (0)->TraceConnectWithoutContext ("LastRetransmittedInterestDataDelay",
+                                              MakeCallback (&CsHopCountTest::DataDelay, this));
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_hopCounts[0].size (), 5, "First consumer should receive all Data packets");
+  NS_TEST_ASSERT_MSG_EQ (m_hopCounts[1].size (), 5, "Second consumer should receive all Data packets");
+  for (uint32_t seq = 0; seq < 5; seq++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((m_hopCounts[0][seq] > 0), true, "Data from the producer should travel over the link");
+      NS_TEST_EXPECT_MSG_EQ (m_hopCounts[1][seq], 0, "Data from the local content store should have zero hop count");
+    }
+
+}
+
+}
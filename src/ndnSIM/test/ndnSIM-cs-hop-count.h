@@ -0,0 +1,58 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_TEST_CS_HOP_COUNT_H
+#define NDNSIM_TEST_CS_HOP_COUNT_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+#include <map>
+
+namespace ns3 {
+
+namespace ndn {
+class App;
+}
+
+class CsHopCountTest : public TestCase
+{
+public:
+  CsHopCountTest ()
+    : TestCase ("Hop count of Data from the local content store test")
+    , m_first (0)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  DataDelay (Ptr<ndn::App> app, uint32_t seq, Time delay, int32_t hopCount);
+
+private:
+  std::map<uint32_t, int32_t> m_hopCounts[2]; // per consumer, indexed by sequence number
+  ndn::App *m_first;
+};
+
+}
+
+#endif // NDNSIM_TEST_CS_HOP_COUNT_H
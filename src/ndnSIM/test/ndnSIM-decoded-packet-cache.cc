@@ -0,0 +1,95 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-decoded-packet-cache.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndn-wire.h"
+#include "ns3/ndn-decoded-packet-cache.h"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3 {
+
+using namespace ndn;
+
+void
+DecodedPacketCacheTest::DoRun ()
+{
+  DecodedPacketCache::Clear ();
+
+  // Interest
+  Ptr<Interest> source = Create<Interest> (Create<Packet> (10));
+  source->SetName (Create<Name> (boost::lexical_cast<Name> ("/test/decoded/interest")));
+  source->SetInterestLifetime (MilliSeconds (4250));
+  source->SetNonce (12345);
+
+  Ptr<Interest> decoded = Wire::ToInterest (Wire::FromInterest (source, Wire::WIRE_FORMAT_NDNSIM));
+  DecodedPacketCache::AddInterest (decoded);
+  DecodedPacketCache::AddInterest (decoded);
+  NS_TEST_ASSERT_MSG_EQ (DecodedPacketCache::GetSize (), 1, "the same wire should be added only once");
+
+  Ptr<Packet> received = decoded->GetWire ()->Copy ();
+  Ptr<Interest> interest;
+  Ptr<Data> data;
+  NS_TEST_ASSERT_MSG_EQ (DecodedPacketCache::Lookup (received, interest, data), true, "marked Interest should be found");
+  NS_TEST_ASSERT_MSG_EQ (data, 0, "Data should not be returned for Interest");
+  NS_TEST_ASSERT_MSG_EQ (interest->GetName (), source->GetName (), "name failed");
+  NS_TEST_ASSERT_MSG_EQ (interest->GetNonce (), source->GetNonce (), "nonce failed");
+  NS_TEST_ASSERT_MSG_EQ (interest->GetInterestLifetime (), decoded->GetInterestLifetime (), "lifetime failed");
+  NS_TEST_ASSERT_MSG_EQ (interest->GetPayload ()->GetSize (), 10, "payload failed");
+  NS_TEST_ASSERT_MSG_EQ (interest->GetWire ()->GetSize (), decoded->GetWire ()->GetSize (), "wire failed");
+
+  // unmarked packet is not found
+  interest = 0;
+  NS_TEST_ASSERT_MSG_EQ (DecodedPacketCache::Lookup (Wire::FromInterest (source, Wire::WIRE_FORMAT_NDNSIM), interest, data),
+                         false, "unmarked Interest should not be found");
+
+  // Data (ccnb has a trailer after the payload)
+  Ptr<Data> sourceData = Create<Data> (Create<Packet> (1024));
+  sourceData->SetName (Create<Name> (boost::lexical_cast<Name> ("/test/decoded/data")));
+  sourceData->SetFreshness (Seconds (10));
+  sourceData->SetTimestamp (MilliSeconds (1500));
+
+  Ptr<Data> decodedData = Wire::ToData (Wire::FromData (sourceData, Wire::WIRE_FORMAT_CCNB));
+  DecodedPacketCache::AddData (decodedData);
+  NS_TEST_ASSERT_MSG_EQ (DecodedPacketCache::GetSize (), 2, "Data should be added");
+
+  received = decodedData->GetWire ()->Copy ();
+  NS_TEST_ASSERT_MSG_EQ (DecodedPacketCache::Lookup (received, interest, data), true, "marked Data should be found");
+  NS_TEST_ASSERT_MSG_EQ (interest, 0, "Interest should not be returned for Data");
+  NS_TEST_ASSERT_MSG_EQ (data->GetName (), sourceData->GetName (), "name failed");
+  NS_TEST_ASSERT_MSG_EQ (data->GetFreshness (), decodedData->GetFreshness (), "freshness failed");
+  NS_TEST_ASSERT_MSG_EQ (data->GetTimestamp (), decodedData->GetTimestamp (), "timestamp failed");
+  NS_TEST_ASSERT_MSG_EQ (data->GetPayload ()->GetSize (), 1024, "payload failed");
+  NS_TEST_ASSERT_MSG_EQ (data->GetWire ()->GetSize (), decodedData->GetWire ()->GetSize (), "wire failed");
+
+  // snapshot is gone, packet should be decoded as usual
+  DecodedPacketCache::Clear ();
+  received = decodedData->GetWire ()->Copy ();
+  data = 0;
+  NS_TEST_ASSERT_MSG_EQ (DecodedPacketCache::Lookup (received, interest, data), false, "removed snapshot should not be found");
+  NS_TEST_ASSERT_MSG_EQ (Wire::ToData (received)->GetPayload ()->GetSize (), 1024, "fallback decoding failed");
+
+  Simulator::Destroy ();
+}
+
+}
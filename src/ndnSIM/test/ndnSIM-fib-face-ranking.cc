@@ -0,0 +1,160 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-fib-face-ranking.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndn-fib-entry.h"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FibFaceRankingTest");
+
+namespace ns3
+{
+
+void
+FibFaceRankingTest::CheckRanking (const ndn::fib::Entry &entry, const std::string &update)
+{
+  typedef ndn::fib::FaceMetricContainer::type::index<ndn::fib::i_metric>::type FacesByMetric;
+  typedef ndn::fib::FaceMetricContainer::type::index<ndn::fib::i_nth>::type FacesByNth;
+
+  const FacesByMetric &byMetric = entry.m_faces.get<ndn::fib::i_metric> ();
+  const FacesByNth &byNth = entry.m_faces.get<ndn::fib::i_nth> ();
+
+  NS_TEST_ASSERT_MSG_EQ (byNth.size (), byMetric.size (), update);
+
+  FacesByMetric::const_iterator metric = byMetric.begin ();
+  for (FacesByNth::const_iterator nth = byNth.begin (); nth != byNth.end (); nth++, metric++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (nth->GetFace ()->GetId (), metric->GetFace ()->GetId (),
+                             "nth candidates should be ordered by metric after " << update);
+    }
+}
+
+void
+FibFaceRankingTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  NodeContainer neighbors;
+  neighbors.Create (4);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < neighbors.GetN (); i++)
+    {
+      p2p.Install (node, neighbors.Get (i));
+    }
+
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+
+  Ptr<ndn::L3Protocol> l3 = node->GetObject<ndn::L3Protocol> ();
+  NS_TEST_ASSERT_MSG_EQ (l3->GetNFaces (), 4, "");
+  Ptr<ndn::Face> faces[4];
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      faces[i] = l3->GetFace (i);
+    }
+
+  Ptr<ndn::fib::Entry> entry = Create<ndn::fib::Entry> (node->GetObject<ndn::Fib> (), Create<ndn::Name> ("/prefix"));
+
+  // new faces
+  entry->AddOrUpdateRoutingMetric (faces[0], 10);
+  CheckRanking (*entry, "adding face 0");
+  entry->AddOrUpdateRoutingMetric (faces[1], 5);
+  CheckRanking (*entry, "adding face 1");
+  entry->AddOrUpdateRoutingMetric (faces[2], 20);
+  CheckRanking (*entry, "adding face 2");
+  entry->AddOrUpdateRoutingMetric (faces[3], 5);
+  CheckRanking (*entry, "adding face 3");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (0).GetFace (), faces[1], "Face with the lowest cost should be the best");
+
+  // updates that change the ranking
+  entry->UpdateStatus (faces[2], ndn::fib::FaceMetric::NDN_FIB_GREEN);
+  CheckRanking (*entry, "face 2 turning green");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (0).GetFace (), faces[2], "Green face should be the best");
+
+  entry->AddOrUpdateRoutingMetric (faces[0], 1);
+  CheckRanking (*entry, "decreasing cost of face 0");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (1).GetFace (), faces[0], "");
+
+  entry->UpdateStatus (faces[2], ndn::fib::FaceMetric::NDN_FIB_RED);
+  CheckRanking (*entry, "face 2 turning red");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (3).GetFace (), faces[2], "Red face should be the last");
+
+  // updates that do not change the ranking
+  entry->UpdateStatus (faces[0], ndn::fib::FaceMetric::NDN_FIB_YELLOW);
+  CheckRanking (*entry, "face 0 staying yellow");
+  entry->AddOrUpdateRoutingMetric (faces[1], 50);
+  CheckRanking (*entry, "increasing cost of face 1");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (0).GetFace (), faces[0], "");
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      entry->UpdateFaceRtt (faces[i], MilliSeconds (10 * (i + 1)));
+      CheckRanking (*entry, "RTT sample of face " + boost::lexical_cast<std::string> (i));
+    }
+
+  entry->Invalidate ();
+  CheckRanking (*entry, "invalidating entry");
+  entry->AddOrUpdateRoutingMetric (faces[3], 2);
+  CheckRanking (*entry, "re-adding face 3");
+  NS_TEST_ASSERT_MSG_EQ (entry->FindBestCandidate (0).GetFace (), faces[3], "");
+
+  // random sequence of updates
+  UniformVariable rand (0, 1);
+  for (uint32_t i = 0; i < 5000; i++)
+    {
+      Ptr<ndn::Face> face = faces[rand.GetInteger (0, 3)];
+      std::string update;
+      switch (rand.GetInteger (0, 3))
+        {
+        case 0:
+          entry->UpdateStatus (face, static_cast<ndn::fib::FaceMetric::Status> (rand.GetInteger (1, 3)));
+          update = "status update";
+          break;
+        case 1:
+          entry->AddOrUpdateRoutingMetric (face, rand.GetInteger (0, 10));
+          update = "routing cost update";
+          break;
+        case 2:
+          entry->UpdateFaceRtt (face, MilliSeconds (rand.GetInteger (1, 100)));
+          update = "RTT sample";
+          break;
+        default:
+          if (rand.GetValue () < 0.01)
+            {
+              entry->Invalidate ();
+              update = "invalidation";
+            }
+          else
+            {
+              update = "nothing";
+            }
+          break;
+        }
+      CheckRanking (*entry, update + " #" + boost::lexical_cast<std::string> (i));
+    }
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,154 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-fw-batch.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "../model/ndn-name-table.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FwBatchTest");
+
+namespace ns3
+{
+
+class FwBatchTestClient : public ndn::App
+{
+protected:
+  void
+  StartApplication ()
+  {
+    ndn::App::StartApplication ();
+
+    Simulator::Schedule (Seconds (0.1), &FwBatchTestClient::SendPackets, this);
+  }
+
+private:
+  void
+  SendPackets ()
+  {
+    // all received at the same time
+    SendPacket ("/a", 1);
+    SendPacket ("/b", 2);
+    SendPacket ("/a", 3);
+    SendPacket ("/c", 4);
+    SendPacket ("/b", 5);
+  }
+
+  void
+  SendPacket (const std::string &prefix, uint32_t nonce)
+  {
+    Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+    interest->SetName (Create<ndn::Name> (prefix));
+    interest->SetNonce (nonce);
+    interest->SetInterestLifetime (Seconds (0.5));
+
+    m_face->ReceiveInterest (interest);
+  }
+};
+
+void
+FwBatchTest::InInterest (Ptr<const ndn::Interest> interest, Ptr<const ndn::Face> face)
+{
+  m_processed.push_back (interest->GetName ().toUri ());
+}
+
+void
+FwBatchTest::SaveWalkCount (Ptr<ndn::NameTable> nameTable)
+{
+  m_walkCount = nameTable->GetWalkCount ();
+}
+
+void
+FwBatchTest::Check (Ptr<ndn::Pit> pit, Ptr<ndn::NameTable> nameTable, bool batch)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_processed.size (), 5, "All Interests should be processed");
+  NS_TEST_ASSERT_MSG_EQ (pit->GetSize (), 3, "There should be 3 entries in PIT");
+
+  if (batch)
+    {
+      // Interests for the same name are processed together, in the order of the first Interest
+      const char *expected[] = { "/a", "/a", "/b", "/b", "/c" };
+      for (size_t i = 0; i < m_processed.size () && i < 5; i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (m_processed[i], expected[i], "Wrong order of Interest processing");
+        }
+    }
+
+  if (nameTable != 0)
+    {
+      // all lookups for Interests with the same name share one walk
+      NS_TEST_EXPECT_MSG_EQ (nameTable->GetWalkCount () - m_walkCount, batch ? 3 : 5,
+                             "Wrong number of name table walks");
+    }
+}
+
+void
+FwBatchTest::Run (bool batch, bool nameTable)
+{
+  m_processed.clear ();
+  m_walkCount = 0;
+
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.SetForwardingStrategy ("ns3::ndn::fw::BestRoute", "BatchInterests", batch ? "true" : "false");
+  if (nameTable)
+    {
+      ndn.SetNameTable ();
+    }
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  node->GetObject<ndn::ForwardingStrategy> ()->TraceConnectWithoutContext ("InInterests",
+                                                                          MakeCallback (&FwBatchTest::InInterest, this));
+
+  Ptr<Application> app = CreateObject<FwBatchTestClient> ();
+  app->SetStartTime (Seconds (0.0));
+  node->AddApplication (app);
+
+  Ptr<ndn::NameTable> table = node->GetObject<ndn::NameTable> ();
+  NS_TEST_ASSERT_MSG_EQ ((table != 0), nameTable, "Name table should be used only if requested");
+  if (table != 0)
+    {
+      Simulator::Schedule (Seconds (0.05), &FwBatchTest::SaveWalkCount, this, table);
+    }
+  Simulator::Schedule (Seconds (0.2), &FwBatchTest::Check, this, node->GetObject<ndn::Pit> (), table, batch);
+
+  Simulator::Stop (Seconds (1.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+FwBatchTest::DoRun ()
+{
+  Run (true, false);
+  Run (true, true);
+  Run (false, true);
+}
+
+}
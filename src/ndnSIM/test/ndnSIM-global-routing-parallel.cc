@@ -0,0 +1,116 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-global-routing-parallel.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndn-link-control-helper.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/foreach.hpp>
+#include <sstream>
+
+namespace ns3 {
+
+using namespace ndn;
+
+std::string
+GlobalRoutingParallelTest::DumpFibs (const NodeContainer &nodes)
+{
+  std::ostringstream os;
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      Ptr<Fib> fib = (*node)->GetObject<Fib> ();
+      os << "Node " << (*node)->GetId () << "\n" << *fib;
+
+      for (Ptr<fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          BOOST_FOREACH (const fib::FaceMetric &faceMetric, entry->m_faces)
+            {
+              os << entry->GetPrefix () << " " << *faceMetric.GetFace () << " " << faceMetric.GetRealDelay () << "\n";
+            }
+        }
+    }
+  return os.str ();
+}
+
+void
+GlobalRoutingParallelTest::DoRun ()
+{
+  // 5x5 grid with equal metrics (many equal-cost paths) and a few extra links
+  const uint32_t size = 5;
+  NodeContainer nodes;
+  nodes.Create (size * size);
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < size; row++)
+    {
+      for (uint32_t col = 0; col < size; col++)
+        {
+          if (col + 1 < size)
+            p2p.Install (nodes.Get (row * size + col), nodes.Get (row * size + col + 1));
+          if (row + 1 < size)
+            p2p.Install (nodes.Get (row * size + col), nodes.Get ((row + 1) * size + col));
+        }
+    }
+  p2p.SetChannelAttribute ("Delay", StringValue ("5ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (12));
+  p2p.Install (nodes.Get (4), nodes.Get (20));
+
+  StackHelper ndnHelper;
+  ndnHelper.Install (nodes);
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.Install (nodes);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      routingHelper.AddOrigin ("/node" + boost::lexical_cast<std::string> (i), nodes.Get (i));
+    }
+  routingHelper.AddOrigins ("/anycast", NodeContainer (nodes.Get (3), nodes.Get (21)));
+
+  LinkControlHelper::FailLink (nodes.Get (6), nodes.Get (7));
+
+  for (uint32_t round = 0; round < 2; round++)
+    {
+      Config::SetGlobal ("ndn::GlobalRoutingThreads", UintegerValue (1));
+      if (round == 0)
+        GlobalRoutingHelper::CalculateRoutes ();
+      else
+        GlobalRoutingHelper::CalculateAllPossibleRoutes ();
+      std::string serial = DumpFibs (nodes);
+
+      Config::SetGlobal ("ndn::GlobalRoutingThreads", UintegerValue (4));
+      if (round == 0)
+        GlobalRoutingHelper::CalculateRoutes ();
+      else
+        GlobalRoutingHelper::CalculateAllPossibleRoutes ();
+      std::string parallel = DumpFibs (nodes);
+
+      NS_TEST_EXPECT_MSG_EQ (parallel, serial, "parallel calculation gives different FIBs (round " << round << ")");
+    }
+
+  Config::SetGlobal ("ndn::GlobalRoutingThreads", UintegerValue (1));
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,49 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_TEST_GLOBAL_ROUTING_PARALLEL_H
+#define NDNSIM_TEST_GLOBAL_ROUTING_PARALLEL_H
+
+#include "ns3/test.h"
+
+#include <string>
+
+namespace ns3 {
+
+class NodeContainer;
+
+class GlobalRoutingParallelTest : public TestCase
+{
+public:
+  GlobalRoutingParallelTest ()
+    : TestCase ("Parallel global routing calculation test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  std::string
+  DumpFibs (const NodeContainer &nodes);
+};
+
+}
+
+#endif // NDNSIM_TEST_GLOBAL_ROUTING_PARALLEL_H
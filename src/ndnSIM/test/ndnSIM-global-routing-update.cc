@@ -0,0 +1,156 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-global-routing-update.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndn-link-control-helper.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/foreach.hpp>
+#include <limits>
+
+namespace ns3 {
+
+using namespace ndn;
+
+GlobalRoutingUpdateTest::Routes
+GlobalRoutingUpdateTest::GetRoutes (const NodeContainer &nodes)
+{
+  Routes routes;
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      Ptr<Fib> fib = (*node)->GetObject<Fib> ();
+      for (Ptr<fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          std::pair<int32_t, uint32_t> route (std::numeric_limits<int32_t>::max (), 0);
+          BOOST_FOREACH (const fib::FaceMetric &faceMetric, entry->m_faces)
+            {
+              if (faceMetric.GetStatus () == fib::FaceMetric::NDN_FIB_RED)
+                continue;
+
+              NS_TEST_EXPECT_MSG_EQ (faceMetric.GetFace ()->IsUp (), true, "route via face that is down");
+              route.first = std::min (route.first, faceMetric.GetRoutingCost ());
+              route.second ++;
+            }
+
+          routes[std::make_pair ((*node)->GetId (), boost::lexical_cast<std::string> (entry->GetPrefix ()))] = route;
+        }
+    }
+  return routes;
+}
+
+void
+GlobalRoutingUpdateTest::CheckRoutes (const NodeContainer &nodes, const std::string &step)
+{
+  Routes updated = GetRoutes (nodes);
+
+  GlobalRoutingHelper::CalculateRoutes ();
+  Routes calculated = GetRoutes (nodes);
+
+  NS_TEST_ASSERT_MSG_EQ (updated.size (), calculated.size (), step << ": different number of FIB entries");
+  for (Routes::iterator route = updated.begin (), reference = calculated.begin ();
+       route != updated.end ();
+       route++, reference++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (route->first.first, reference->first.first, step << ": different FIB entries");
+      NS_TEST_ASSERT_MSG_EQ (route->first.second, reference->first.second, step << ": different FIB entries");
+      NS_TEST_EXPECT_MSG_EQ (route->second.first, reference->second.first,
+                             step << ": cost of " << route->first.second << " on node " << route->first.first);
+      NS_TEST_EXPECT_MSG_EQ (route->second.second, reference->second.second,
+                             step << ": number of faces for " << route->first.second << " on node " << route->first.first);
+    }
+
+  // trees are discarded by CalculateRoutes, calculate them again for the next step
+  GlobalRoutingHelper::UpdateRoutes ();
+}
+
+void
+GlobalRoutingUpdateTest::DoRun ()
+{
+  // 4x4 grid
+  const uint32_t size = 4;
+  NodeContainer nodes;
+  nodes.Create (size * size);
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < size; row++)
+    {
+      for (uint32_t col = 0; col < size; col++)
+        {
+          if (col + 1 < size)
+            p2p.Install (nodes.Get (row * size + col), nodes.Get (row * size + col + 1));
+          if (row + 1 < size)
+            p2p.Install (nodes.Get (row * size + col), nodes.Get ((row + 1) * size + col));
+        }
+    }
+
+  StackHelper ndnHelper;
+  ndnHelper.Install (nodes);
+
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<L3Protocol> l3 = nodes.Get (i)->GetObject<L3Protocol> ();
+      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+        {
+          l3->GetFace (faceId)->SetMetric (1 + (i * 5 + faceId * 3) % 7);
+        }
+    }
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.Install (nodes);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      routingHelper.AddOrigin ("/node" + boost::lexical_cast<std::string> (i), nodes.Get (i));
+    }
+  routingHelper.AddOrigins ("/anycast", NodeContainer (nodes.Get (0), nodes.Get (size * size - 1)));
+
+  GlobalRoutingHelper::UpdateRoutes ();
+  CheckRoutes (nodes, "initial");
+
+  LinkControlHelper::FailLink (nodes.Get (0), nodes.Get (1));
+  LinkControlHelper::FailLink (nodes.Get (5), nodes.Get (9));
+  LinkControlHelper::FailLink (nodes.Get (10), nodes.Get (11));
+  GlobalRoutingHelper::UpdateRoutes ();
+  CheckRoutes (nodes, "links failed");
+
+  // node 0 becomes unreachable
+  LinkControlHelper::FailLink (nodes.Get (0), nodes.Get (size));
+  GlobalRoutingHelper::UpdateRoutes ();
+  CheckRoutes (nodes, "node isolated");
+
+  LinkControlHelper::UpLink (nodes.Get (0), nodes.Get (1));
+  LinkControlHelper::UpLink (nodes.Get (0), nodes.Get (size));
+  LinkControlHelper::FailLink (nodes.Get (6), nodes.Get (7));
+  GlobalRoutingHelper::UpdateRoutes ();
+  CheckRoutes (nodes, "links restored");
+
+  nodes.Get (5)->GetObject<L3Protocol> ()->GetFace (1)->SetMetric (20);
+  nodes.Get (9)->GetObject<L3Protocol> ()->GetFace (1)->SetMetric (1);
+  GlobalRoutingHelper::UpdateRoutes ();
+  CheckRoutes (nodes, "metrics changed");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-lfu-policy.h"
+
+#include "ns3/ndn-name.h"
+#include "ns3/random-variable.h"
+
+#include "../utils/trie/trie-with-policy.h"
+#include "../utils/trie/lfu-policy.h"
+
+#include <boost/lexical_cast.hpp>
+#include <vector>
+
+using namespace ns3::ndn::ndnSIM;
+
+namespace ns3
+{
+
+/// @cond include_hidden
+namespace {
+
+class Payload : public SimpleRefCount<Payload>
+{
+};
+
+typedef trie_with_policy<ndn::Name,
+                         smart_pointer_payload_traits<Payload>,
+                         lfu_policy_traits> lfu_trie;
+
+ndn::Name
+MakeName (uint32_t id)
+{
+  ndn::Name name;
+  name.append (boost::lexical_cast<std::string> (id));
+  return name;
+}
+
+// Names of the items in the policy order (from the least frequently used)
+std::string
+GetOrder (const lfu_trie &trie)
+{
+  std::string order;
+  for (lfu_trie::policy_container::const_iterator item = trie.getPolicy ().begin ();
+       item != trie.getPolicy ().end ();
+       item++)
+    {
+      order += boost::lexical_cast<std::string> (item->key ()) + " ";
+    }
+  return order;
+}
+
+// Straightforward LFU: evicts the item with the smallest number of lookups, and among them the one
+// that got this number of lookups first (same as the multiset-based implementation did)
+struct ReferenceItem
+{
+  uint32_t id;
+  uint32_t frequency;
+  uint32_t stamp;
+};
+
+}
+/// @endcond
+
+void
+LfuPolicyTest::DoRun ()
+{
+  Ptr<Payload> payload = Create<Payload> ();
+
+  {
+    lfu_trie trie;
+    trie.getPolicy ().set_max_size (3);
+
+    trie.insert (MakeName (1), payload);
+    trie.insert (MakeName (2), payload);
+    trie.insert (MakeName (3), payload);
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "1 2 3 ", "");
+
+    trie.getPolicy ().lookup (trie.find_exact (MakeName (1)));
+    trie.getPolicy ().lookup (trie.find_exact (MakeName (1)));
+    trie.getPolicy ().lookup (trie.find_exact (MakeName (2)));
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "3 2 1 ", "");
+    NS_TEST_ASSERT_MSG_EQ (lfu_trie::policy_container::policy_base::get_frequency (trie.find_exact (MakeName (1))), 2, "");
+
+    trie.insert (MakeName (4), payload); // evicts 3 (never looked up)
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "4 2 1 ", "");
+
+    trie.getPolicy ().lookup (trie.find_exact (MakeName (4))); // 4 goes after 2 (same frequency)
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "2 4 1 ", "");
+
+    trie.insert (MakeName (5), payload); // evicts 2
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "5 4 1 ", "");
+    NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 3, "");
+
+    trie.erase (MakeName (4));
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "5 1 ", "");
+
+    trie.clear ();
+    NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 0, "");
+    trie.insert (MakeName (6), payload);
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "6 ", "");
+  }
+
+  // random sequence of operations, compared with the straightforward LFU
+  {
+    const uint32_t maxSize = 20;
+    lfu_trie trie;
+    trie.getPolicy ().set_max_size (maxSize);
+
+    std::vector<ReferenceItem> reference;
+    uint32_t stamp = 0;
+
+    UniformVariable rand (0, 60);
+    UniformVariable operation (0, 10);
+    for (uint32_t i = 0; i < 10000; i++)
+      {
+        uint32_t id = rand.GetInteger (0, 59);
+        uint32_t op = operation.GetInteger (0, 9);
+
+        std::vector<ReferenceItem>::iterator item = reference.begin ();
+        while (item != reference.end () && item->id != id)
+          item++;
+
+        if (op == 0)
+          {
+            trie.erase (MakeName (id));
+            if (item != reference.end ())
+              reference.erase (item);
+          }
+        else if (item != reference.end ())
+          {
+            trie.getPolicy ().lookup (trie.find_exact (MakeName (id)));
+            item->frequency ++;
+            item->stamp = stamp++;
+          }
+        else
+          {
+            trie.insert (MakeName (id), payload);
+            if (reference.size () >= maxSize)
+              {
+                std::vector<ReferenceItem>::iterator victim = reference.begin ();
+                for (std::vector<ReferenceItem>::iterator j = reference.begin (); j != reference.end (); j++)
+                  {
+                    if (j->frequency < victim->frequency ||
+                        (j->frequency == victim->frequency && j->stamp < victim->stamp))
+                      victim = j;
+                  }
+                reference.erase (victim);
+              }
+            ReferenceItem newItem = { id, 0, stamp++ };
+            reference.push_back (newItem);
+          }
+
+        NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), reference.size (), "at step " << i);
+      }
+
+    for (std::vector<ReferenceItem>::iterator item = reference.begin (); item != reference.end (); item++)
+      {
+        lfu_trie::iterator found = trie.find_exact (MakeName (item->id));
+        NS_TEST_ASSERT_MSG_NE (found, trie.end (), "item " << item->id << " should be in the cache");
+        NS_TEST_ASSERT_MSG_EQ (lfu_trie::policy_container::policy_base::get_frequency (found), item->frequency, "");
+      }
+  }
+}
+
+}
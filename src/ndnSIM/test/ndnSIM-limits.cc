@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-limits.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/ndn-limits-lazy-rate.h"
+
+namespace ns3
+{
+
+void
+LimitsLazyRateTest::SlotAvailable ()
+{
+  m_notifications.push_back (Simulator::Now ());
+}
+
+void
+LimitsLazyRateTest::Fill ()
+{
+  // 100 Interests per second, 5 Interests burst
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_limits->IsBelowLimit (), true, "Bucket should not be full yet");
+      m_limits->BorrowLimit ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_limits->IsBelowLimit (), false, "Bucket should be full");
+}
+
+void
+LimitsLazyRateTest::CheckFull ()
+{
+  // only half of the token has leaked
+  NS_TEST_ASSERT_MSG_EQ (m_limits->IsBelowLimit (), false, "Bucket should still be full");
+  NS_TEST_ASSERT_MSG_EQ (m_notifications.size (), 0, "Slot should not be available yet");
+}
+
+void
+LimitsLazyRateTest::CheckIdle ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_notifications.size (), 1, "Slot notification should be fired exactly once");
+  NS_TEST_ASSERT_MSG_EQ (m_notifications[0], MilliSeconds (1010), "Slot should be available after one token leaked");
+
+  // bucket is completely empty, but the burst is still limited
+  Fill ();
+}
+
+void
+LimitsLazyRateTest::CheckNoSlot ()
+{
+  NS_TEST_EXPECT_MSG_EQ (m_limits->IsBelowLimit (), false, "Burst is less than one Interest, no slot should be available");
+
+  // nothing else is scheduled, unless the bucket keeps polling for a slot that never frees up
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsFinished (), true, "Slot notification should not be scheduled");
+  Simulator::Stop ();
+}
+
+void
+LimitsLazyRateTest::DoRun ()
+{
+  m_limits = CreateObject<ndn::LimitsLazyRate> ();
+  m_limits->SetLimits (100.0, 0.05);
+  m_limits->RegisterAvailableSlotCallback (MakeCallback (&LimitsLazyRateTest::SlotAvailable, this));
+
+  Simulator::Schedule (Seconds (1.0), &LimitsLazyRateTest::Fill, this);
+  Simulator::Schedule (Seconds (1.005), &LimitsLazyRateTest::CheckFull, this);
+  Simulator::Schedule (Seconds (10.0), &LimitsLazyRateTest::CheckIdle, this);
+
+  Simulator::Run ();
+
+  // after the last fill, only one notification event is pending
+  NS_TEST_ASSERT_MSG_EQ (m_notifications.size (), 2, "Notification should be fired after the last fill");
+  NS_TEST_ASSERT_MSG_EQ (m_notifications[1], MilliSeconds (10010), "");
+
+  m_limits->Dispose ();
+  m_limits = 0;
+  Simulator::Destroy ();
+
+  // 100 Interests per second, 0.5 Interest burst
+  m_notifications.clear ();
+  m_limits = CreateObject<ndn::LimitsLazyRate> ();
+  m_limits->SetLimits (100.0, 0.005);
+  m_limits->RegisterAvailableSlotCallback (MakeCallback (&LimitsLazyRateTest::SlotAvailable, this));
+
+  Simulator::Schedule (Seconds (1.0), &LimitsLazyRateTest::CheckNoSlot, this);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_notifications.size (), 0, "Slot notification should never be fired");
+
+  m_limits->Dispose ();
+  m_limits = 0;
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,66 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-log-histogram.h"
+#include "ns3/ndn-log-histogram.h"
+
+namespace ns3
+{
+
+void
+LogHistogramTest::DoRun ()
+{
+  ndn::LogHistogram histogram;
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetPercentile (50), 0, "Empty histogram");
+
+  // small values are counted exactly
+  for (uint64_t value = 1; value <= 100; value++)
+    {
+      histogram.Add (value);
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (), 100, "");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetMean (), 50.5, 1e-9, "");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetPercentile (50), 50, "");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetPercentile (99), 99, "");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetPercentile (100), 100, "");
+
+  // large values (e.g., delays in nanoseconds) are within the relative error of the precision
+  histogram.Reset ();
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (), 0, "");
+  for (uint64_t value = 1; value <= 1000; value++)
+    {
+      histogram.Add (value * 1000003);
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetMin (), 1000003, "");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetMax (), 1000003000, "");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetPercentile (50) / 500001500.0, 1.0, 1.0 / 64, "");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetPercentile (90) / 900002700.0, 1.0, 1.0 / 64, "");
+  NS_TEST_ASSERT_MSG_EQ_TOL (histogram.GetPercentile (99) / 990002970.0, 1.0, 1.0 / 64, "");
+
+  // percentiles of the same values are exact
+  histogram.Reset ();
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      histogram.Add (57584000);
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetPercentile (50), 57584000, "");
+}
+
+}
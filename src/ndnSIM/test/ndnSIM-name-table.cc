@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-name-table.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "../model/ndn-name-table.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NameTableTest");
+
+namespace ns3
+{
+
+static Ptr<ndn::Interest>
+MakeInterest (const std::string &name)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> (name));
+  interest->SetNonce (1);
+  interest->SetInterestLifetime (Seconds (1.0));
+  return interest;
+}
+
+static Ptr<ndn::Data>
+MakeData (const std::string &name)
+{
+  Ptr<ndn::Data> data = Create<ndn::Data> ();
+  data->SetName (Create<ndn::Name> (name));
+  return data;
+}
+
+void
+NameTableTest::Fill (Ptr<Node> node)
+{
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  Ptr<ndn::Pit> pit = node->GetObject<ndn::Pit> ();
+  Ptr<ndn::ContentStore> cs = node->GetObject<ndn::ContentStore> ();
+  Ptr<ndn::Face> face = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+  Ptr<ndn::NameTable> nameTable = node->GetObject<ndn::NameTable> ();
+
+  NS_TEST_ASSERT_MSG_NE (nameTable, 0, "Name table should be aggregated to the node");
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 1, "There should be one FIB entry");
+
+  Ptr<ndn::pit::Entry> pitEntry = pit->Create (MakeInterest ("/prefix/1"));
+  NS_TEST_ASSERT_MSG_NE (pitEntry, 0, "PIT entry should be created");
+  NS_TEST_ASSERT_MSG_EQ (pitEntry->GetFibEntry (), fib->Find (ndn::Name ("/prefix")), "PIT entry should refer to /prefix FIB entry");
+  pitEntry->AddIncoming (face);
+
+  NS_TEST_ASSERT_MSG_EQ (cs->Add (MakeData ("/prefix/1")), true, "Data should be cached");
+  NS_TEST_ASSERT_MSG_EQ (cs->Add (MakeData ("/prefix/2")), true, "Data should be cached");
+  NS_TEST_ASSERT_MSG_EQ (cs->Add (MakeData ("/prefix/2")), false, "Data should not be cached twice");
+
+  // root, /prefix, /prefix/1, /prefix/2
+  NS_TEST_ASSERT_MSG_EQ (nameTable->GetNodeCount (), 4, "FIB, PIT, and CS should share name table nodes");
+
+  // lookups for one Interest
+  Ptr<ndn::Interest> interest = MakeInterest ("/prefix/1");
+  NS_TEST_ASSERT_MSG_EQ (pit->Lookup (*interest), pitEntry, "PIT lookup should find the entry");
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (interest), 0, "CS lookup should find cached Data");
+  NS_TEST_ASSERT_MSG_EQ (fib->LongestPrefixMatch (*interest)->GetPrefix (), ndn::Name ("/prefix"), "FIB lookup should find /prefix");
+
+  NS_TEST_ASSERT_MSG_EQ (pit->Lookup (*MakeData ("/prefix/1/segment")), pitEntry, "PIT should match Data with longer name");
+  NS_TEST_ASSERT_MSG_EQ (pit->Lookup (*MakeData ("/prefix/2")), 0, "There is no PIT entry for /prefix/2");
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (MakeInterest ("/prefix")), 0, "CS lookup should find Data under /prefix");
+  NS_TEST_ASSERT_MSG_EQ (cs->Lookup (MakeInterest ("/prefix/3")), 0, "There is no cached Data for /prefix/3");
+  NS_TEST_ASSERT_MSG_EQ (cs->Lookup (MakeInterest ("/other")), 0, "There is no cached Data for /other");
+
+  // CS is limited to 2 entries, /prefix/1 is more recently used than /prefix/2
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (MakeInterest ("/prefix/1")), 0, "CS lookup should find cached Data");
+  NS_TEST_ASSERT_MSG_EQ (cs->Add (MakeData ("/prefix/3")), true, "Data should be cached");
+  NS_TEST_ASSERT_MSG_EQ (cs->GetSize (), 2, "There should be 2 entries in CS");
+  NS_TEST_ASSERT_MSG_EQ (cs->Lookup (MakeInterest ("/prefix/2")), 0, "/prefix/2 should be evicted");
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (MakeInterest ("/prefix/3")), 0, "CS lookup should find cached Data");
+
+  // root, /prefix, /prefix/1, /prefix/3
+  NS_TEST_ASSERT_MSG_EQ (nameTable->GetNodeCount (), 4, "Node of evicted entry should be removed");
+}
+
+void
+NameTableTest::CheckExpired (Ptr<Node> node)
+{
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  Ptr<ndn::Pit> pit = node->GetObject<ndn::Pit> ();
+  Ptr<ndn::ContentStore> cs = node->GetObject<ndn::ContentStore> ();
+  Ptr<ndn::NameTable> nameTable = node->GetObject<ndn::NameTable> ();
+
+  NS_TEST_ASSERT_MSG_EQ (pit->GetSize (), 0, "PIT entry should expire");
+  NS_TEST_ASSERT_MSG_EQ (pit->Find (ndn::Name ("/prefix/1")), 0, "PIT entry should expire");
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (MakeInterest ("/prefix/1")), 0, "Cached Data should stay");
+  NS_TEST_ASSERT_MSG_EQ (nameTable->GetNodeCount (), 4, "Nodes with cached Data should stay");
+
+  fib->Remove (Create<ndn::Name> ("/prefix"));
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 0, "FIB should be empty");
+  NS_TEST_ASSERT_MSG_EQ (fib->Begin (), fib->End (), "FIB should be empty");
+  NS_TEST_ASSERT_MSG_NE (cs->Lookup (MakeInterest ("/prefix/3")), 0, "Cached Data should stay");
+  NS_TEST_ASSERT_MSG_EQ (nameTable->GetNodeCount (), 4, "Nodes with cached Data should stay");
+}
+
+void
+NameTableTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.SetNameTable ("Persistent", "Lru");
+  ndn.SetContentStore ("ns3::ndn::cs::NameTable::Lru", "MaxSize", "2");
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  ndn::StackHelper::AddRoute (node, "/prefix", 0, 0);
+
+  NS_TEST_ASSERT_MSG_EQ (node->GetObject<ndn::Pit> ()->GetInstanceTypeId ().GetName (), "ns3::ndn::pit::NameTable::Persistent",
+                         "PIT should use name table");
+
+  Simulator::Schedule (Seconds (0.1), &NameTableTest::Fill, this, node);
+  Simulator::Schedule (Seconds (2.0), &NameTableTest::CheckExpired, this, node);
+
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+}
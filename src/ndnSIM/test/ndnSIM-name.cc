@@ -0,0 +1,123 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-name.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/functional/hash.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NameTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+size_t
+RecomputedHash (const ndn::Name &name, size_t len)
+{
+  size_t hash = 0;
+  for (size_t i = 0; i < len; i++)
+    {
+      boost::hash_combine (hash, boost::hash_value (name.get (i)));
+    }
+  return hash;
+}
+
+}
+
+void
+NameTest::DoRun ()
+{
+  ndn::Name base ("/prefix/name");
+
+  // copies share components, but extending a copy does not affect other names
+  ndn::Name first (base);
+  first.appendSeqNum (1);
+  ndn::Name second (base);
+  second.appendSeqNum (2);
+
+  NS_TEST_ASSERT_MSG_EQ (base.size (), 2, "Base name should not change");
+  NS_TEST_ASSERT_MSG_EQ (first.size (), 3, "Wrong size");
+  NS_TEST_ASSERT_MSG_EQ (first.get (-1).toSeqNum (), 1, "Wrong sequence number");
+  NS_TEST_ASSERT_MSG_EQ (second.get (-1).toSeqNum (), 2, "Wrong sequence number");
+  NS_TEST_ASSERT_MSG_EQ (first.getPrefix (2), base, "Prefix should be equal to the base name");
+
+  // prefixes share components too
+  ndn::Name prefix = first.getPrefix (1);
+  prefix.append ("other");
+  NS_TEST_ASSERT_MSG_EQ (prefix, ndn::Name ("/prefix/other"), "Wrong name");
+  NS_TEST_ASSERT_MSG_EQ (first, ndn::Name ("/prefix/name/%00%01"), "Extending a prefix should not change the name");
+
+  // long chains of copies
+  ndn::Name chain ("/chain");
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      ndn::Name copy (chain);
+      chain.appendSeqNum (i);
+      NS_TEST_ASSERT_MSG_EQ (copy.size (), i + 1, "Copy should not change");
+    }
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (chain.get (i + 1).toSeqNum (), i, "Wrong sequence number");
+    }
+
+  // cached prefix hashes
+  for (size_t len = 0; len <= chain.size (); len++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (chain.getPrefixHash (len), RecomputedHash (chain, len), "Wrong cached prefix hash");
+    }
+
+  // modification through non-const accessors affects only the modified name
+  ndn::Name modified (first);
+  modified.get (0) = ndn::name::Component ("changed");
+  NS_TEST_ASSERT_MSG_EQ (modified, ndn::Name ("/changed/name/%00%01"), "Wrong name after modification");
+  NS_TEST_ASSERT_MSG_EQ (first, ndn::Name ("/prefix/name/%00%01"), "Copy should not be modified");
+  NS_TEST_ASSERT_MSG_EQ (modified.getPrefixHash (3), RecomputedHash (modified, 3), "Wrong prefix hash after modification");
+
+  ndn::Name copyOfModified (modified);
+  *modified.begin () = ndn::name::Component ("again");
+  NS_TEST_ASSERT_MSG_EQ (copyOfModified, ndn::Name ("/changed/name/%00%01"), "Copy should not be modified");
+
+  // after modification, hashes are rebuilt when the name is extended or copied
+  modified.appendSeqNum (5);
+  *modified.begin () = ndn::name::Component ("third");
+  modified.appendSeqNum (6);
+  for (size_t len = 0; len <= modified.size (); len++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (modified.getPrefixHash (len), RecomputedHash (modified, len), "Wrong prefix hash after modification and append");
+    }
+
+  modified.get (1) = ndn::name::Component ("fourth");
+  ndn::Name copyOfExtended (modified);
+  NS_TEST_ASSERT_MSG_EQ (copyOfExtended, ndn::Name ("/third/fourth/%00%01/%00%05/%00%06"), "Wrong copy");
+  for (size_t len = 0; len <= copyOfExtended.size (); len++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (copyOfExtended.getPrefixHash (len), RecomputedHash (copyOfExtended, len), "Wrong prefix hash of the copy");
+    }
+
+  modified.get (1) = ndn::name::Component ("fifth");
+  NS_TEST_ASSERT_MSG_EQ (copyOfExtended.get (1), ndn::name::Component ("fourth"), "Copy should not be modified");
+  NS_TEST_ASSERT_MSG_EQ (modified.getPrefixHash (2), RecomputedHash (modified, 2), "Wrong prefix hash after modification");
+}
+
+}
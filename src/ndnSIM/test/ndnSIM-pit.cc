@@ -113,6 +113,7 @@ PitTest::DoRun ()
   p2p.Install (node, nodeSink);
   
   ndn::StackHelper ndn;
+  ndn.SetPit ("ns3::ndn::pit::Persistent", "ExpirationGranularity", m_granularity);
   ndn.Install (node);
   ndn.Install (nodeSink);
 
@@ -130,11 +131,13 @@ PitTest::DoRun ()
   Simulator::Schedule (Seconds (0.21), &PitTest::Check2, this, node->GetObject<ndn::Pit> ());
   Simulator::Schedule (Seconds (0.31), &PitTest::Check3, this, node->GetObject<ndn::Pit> ());
 
-  Simulator::Schedule (Seconds (0.61), &PitTest::Check3, this, node->GetObject<ndn::Pit> ());
-  Simulator::Schedule (Seconds (0.71), &PitTest::Check2, this, node->GetObject<ndn::Pit> ());
-  Simulator::Schedule (Seconds (0.81), &PitTest::Check1, this, node->GetObject<ndn::Pit> ());
+  // with timer wheel, entries can expire up to one granularity interval later
+  Time delay = Time (m_granularity);
+  Simulator::Schedule (Seconds (0.61) + delay, &PitTest::Check3, this, node->GetObject<ndn::Pit> ());
+  Simulator::Schedule (Seconds (0.71) + delay, &PitTest::Check2, this, node->GetObject<ndn::Pit> ());
+  Simulator::Schedule (Seconds (0.81) + delay, &PitTest::Check1, this, node->GetObject<ndn::Pit> ());
 
-  Simulator::Schedule (Seconds (0.91), &PitTest::Check0, this, node->GetObject<ndn::Pit> ());
+  Simulator::Schedule (Seconds (0.91) + delay, &PitTest::Check0, this, node->GetObject<ndn::Pit> ());
 
   Simulator::Stop (Seconds (10.0));
   Simulator::Run ();
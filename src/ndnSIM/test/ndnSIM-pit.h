@@ -23,6 +23,9 @@
 
 #include "ns3/test.h"
 #include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+#include <string>
 
 namespace ns3 {
 
@@ -34,8 +37,13 @@ class Pit;
 class PitTest : public TestCase
 {
 public:
-  PitTest ()
-    : TestCase ("PIT test")
+  /**
+   * @param granularity value for ExpirationGranularity attribute of the PIT (timer wheel
+   *                    is used if it is not zero)
+   */
+  PitTest (const std::string &granularity = "0s")
+    : TestCase (Time (granularity).IsZero () ? "PIT test" : "PIT test with expiration timer wheel")
+    , m_granularity (granularity)
   {
   }
     
@@ -47,6 +55,9 @@ private:
   void Check1 (Ptr<ndn::Pit> pit);
   void Check2 (Ptr<ndn::Pit> pit);
   void Check3 (Ptr<ndn::Pit> pit);
+
+private:
+  std::string m_granularity;
 };
   
 }
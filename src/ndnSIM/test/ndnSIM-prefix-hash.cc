@@ -0,0 +1,119 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-prefix-hash.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "../utils/trie/trie-with-policy.h"
+#include "../utils/trie/persistent-policy.h"
+#include "../utils/trie/multi-policy.h"
+#include "../utils/trie/prefix-hash-policy.h"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PrefixHashTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+class Integer : public SimpleRefCount<Integer>
+{
+public:
+  Integer (int value) : m_value (value) { }
+  int m_value;
+};
+
+struct IsOdd
+{
+  bool
+  operator () (Ptr<Integer> value) const
+  {
+    return value->m_value % 2 == 1;
+  }
+};
+
+typedef ndn::ndnSIM::trie_with_policy<
+  ndn::Name,
+  ndn::ndnSIM::smart_pointer_payload_traits<Integer>,
+  ndn::ndnSIM::multi_policy_traits<
+    boost::mpl::vector2< ndn::ndnSIM::persistent_policy_traits,
+                         ndn::ndnSIM::prefix_hash_policy_traits > > > test_trie;
+
+typedef test_trie::policy_container::index<1>::type prefix_hash_index;
+
+ndn::Name
+RandomName (UniformVariable &rand)
+{
+  ndn::Name name;
+  uint32_t depth = rand.GetInteger (0, 4);
+  for (uint32_t i = 0; i < depth; i++)
+    {
+      name.append (boost::lexical_cast<std::string> (rand.GetInteger (0, 3)));
+    }
+  return name;
+}
+
+}
+
+void
+PrefixHashTest::DoRun ()
+{
+  test_trie trie;
+  trie.getPolicy ().set_max_size (0);
+  prefix_hash_index &index = trie.getPolicy ().get<prefix_hash_index> ();
+
+  UniformVariable rand (0, 1);
+  for (int round = 0; round < 2000; round++)
+    {
+      ndn::Name name = RandomName (rand);
+      if (rand.GetValue () < 0.6)
+        {
+          trie.insert (name, Create<Integer> (round));
+        }
+      else
+        {
+          trie.erase (name);
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (index.size (), trie.getPolicy ().size (), "Index should contain all entries");
+
+      ndn::Name query = RandomName (rand);
+      NS_TEST_ASSERT_MSG_EQ (index.find_exact (query), trie.find_exact (query),
+                             "Exact match differs for " << query);
+      NS_TEST_ASSERT_MSG_EQ (index.longest_prefix_match_if (query, IsOdd ()), trie.longest_prefix_match_if (query, IsOdd ()),
+                             "Longest prefix match differs for " << query);
+      NS_TEST_ASSERT_MSG_EQ (index.deepest_prefix_match (query), trie.deepest_prefix_match (query),
+                             "Deepest prefix match differs for " << query);
+      if (!index.may_contain_prefix (query))
+        {
+          NS_TEST_ASSERT_MSG_EQ (trie.deepest_prefix_match (query), trie.end (),
+                                 "Index reports no entries under " << query);
+        }
+    }
+
+  trie.clear ();
+  NS_TEST_ASSERT_MSG_EQ (index.size (), 0, "Index should be empty after clear");
+}
+
+}
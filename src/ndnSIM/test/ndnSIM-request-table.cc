@@ -0,0 +1,117 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-request-table.h"
+
+#include "ns3/random-variable.h"
+#include "ns3/simulator.h"
+
+#include "../utils/ndn-request-table.h"
+
+#include <map>
+
+namespace ns3
+{
+
+void
+RequestTableTest::DoRun ()
+{
+  typedef ndn::RequestTable RequestTable;
+
+  // records with the same sequence number and queues
+  {
+    RequestTable table;
+    uint32_t a = table.Insert (5);
+    uint32_t b = table.Insert (3);
+    uint32_t c = table.Insert (5);
+    NS_TEST_ASSERT_MSG_EQ (table.GetSize (), 3, "");
+    NS_TEST_ASSERT_MSG_EQ (table.Find (5), a, "");
+    NS_TEST_ASSERT_MSG_EQ (table.Get (a).nextSameSeq, c, "");
+    NS_TEST_ASSERT_MSG_EQ (table.Find (4), RequestTable::NONE, "");
+
+    table.Sent (c, Seconds (1));
+    table.Sent (a, Seconds (2));
+    table.Sent (b, Seconds (3));
+    table.Sent (c, Seconds (4)); // already in the timeout queue, moved to the end
+    NS_TEST_ASSERT_MSG_EQ (table.GetTimeoutFront (), a, "timeout queue should be ordered by the last transmission");
+    NS_TEST_ASSERT_MSG_EQ (table.Get (c).firstSent, Seconds (1), "");
+    NS_TEST_ASSERT_MSG_EQ (table.Get (c).lastSent, Seconds (4), "");
+    NS_TEST_ASSERT_MSG_EQ (table.Get (c).sendCount, 2, "");
+
+    table.ScheduleRetx (c);
+    table.ScheduleRetx (b);
+    NS_TEST_ASSERT_MSG_EQ (table.GetTimeoutFront (), a, "");
+    NS_TEST_ASSERT_MSG_EQ (table.GetRetxFront (), b, "retransmission queue should be ordered by sequence number");
+    NS_TEST_ASSERT_MSG_EQ (table.GetQueue (c), RequestTable::QUEUE_RETX, "");
+
+    table.Erase (b);
+    NS_TEST_ASSERT_MSG_EQ (table.GetRetxFront (), c, "");
+    table.Erase (a);
+    NS_TEST_ASSERT_MSG_EQ (table.GetTimeoutFront (), RequestTable::NONE, "");
+    NS_TEST_ASSERT_MSG_EQ (table.Find (5), c, "");
+    NS_TEST_ASSERT_MSG_EQ (table.Get (c).nextSameSeq, RequestTable::NONE, "");
+
+    table.Unqueue (c);
+    NS_TEST_ASSERT_MSG_EQ (table.GetRetxFront (), RequestTable::NONE, "");
+    NS_TEST_ASSERT_MSG_EQ (table.GetSize (), 1, "");
+  }
+
+  // random sequence of operations, compared with std::multimap
+  {
+    RequestTable table;
+    std::multimap<uint32_t, uint32_t> reference; // seq -> request
+
+    UniformVariable rand (0, 1);
+    for (uint32_t i = 0; i < 50000; i++)
+      {
+        uint32_t seq = rand.GetInteger (0, 2000);
+        if (rand.GetValue () < 0.55)
+          {
+            reference.insert (std::make_pair (seq, table.Insert (seq)));
+          }
+        else if (reference.find (seq) != reference.end ())
+          {
+            std::multimap<uint32_t, uint32_t>::iterator item = reference.find (seq);
+            NS_TEST_ASSERT_MSG_EQ (table.Find (seq), item->second, "the oldest request should be found first");
+            table.Erase (item->second);
+            reference.erase (item);
+          }
+        else
+          {
+            NS_TEST_ASSERT_MSG_EQ (table.Find (seq), RequestTable::NONE, "");
+          }
+      }
+
+    NS_TEST_ASSERT_MSG_EQ (table.GetSize (), reference.size (), "");
+    for (std::multimap<uint32_t, uint32_t>::iterator item = reference.begin (); item != reference.end (); )
+      {
+        uint32_t request = table.Find (item->first);
+        for (std::multimap<uint32_t, uint32_t>::iterator end = reference.upper_bound (item->first); item != end; item++)
+          {
+            NS_TEST_ASSERT_MSG_EQ (request, item->second, "");
+            NS_TEST_ASSERT_MSG_EQ (table.Get (request).seq, item->first, "");
+            request = table.Get (request).nextSameSeq;
+          }
+        NS_TEST_ASSERT_MSG_EQ (request, RequestTable::NONE, "");
+      }
+  }
+}
+
+}
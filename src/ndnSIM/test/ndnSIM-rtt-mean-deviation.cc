@@ -0,0 +1,67 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-rtt-mean-deviation.h"
+
+#include "ns3/simulator.h"
+
+#include "../utils/ndn-rtt-mean-deviation.h"
+
+namespace ns3
+{
+
+void
+RttMeanDeviationTest::Ack (Ptr<ndn::RttEstimator> rtt, uint32_t seq, Time expectedRtt)
+{
+  NS_TEST_EXPECT_MSG_EQ (rtt->AckSeq (SequenceNumber32 (seq)), expectedRtt, "Unexpected RTT sample for " << seq);
+}
+
+void
+RttMeanDeviationTest::DoRun ()
+{
+  Ptr<ndn::RttEstimator> rtt = CreateObject<ndn::RttMeanDeviation> ();
+
+  // sequence numbers are sent and acknowledged in arbitrary order
+  Simulator::Schedule (Seconds (0), &ndn::RttEstimator::SentSeq, rtt, SequenceNumber32 (7), 1);
+  Simulator::Schedule (Seconds (0), &ndn::RttEstimator::SentSeq, rtt, SequenceNumber32 (3), 1);
+  Simulator::Schedule (Seconds (0), &ndn::RttEstimator::SentSeq, rtt, SequenceNumber32 (9), 1);
+  Simulator::Schedule (Seconds (1), &ndn::RttEstimator::SentSeq, rtt, SequenceNumber32 (3), 1);
+
+  Simulator::Schedule (Seconds (2), &RttMeanDeviationTest::Ack, this, rtt, 9, Seconds (2));
+  // retransmitted, sample is ignored (Karn's algorithm)
+  Simulator::Schedule (Seconds (3), &RttMeanDeviationTest::Ack, this, rtt, 3, Seconds (0));
+  // already acknowledged
+  Simulator::Schedule (Seconds (3), &RttMeanDeviationTest::Ack, this, rtt, 9, Seconds (0));
+  // acknowledgement of 9 does not acknowledge 7
+  Simulator::Schedule (Seconds (4), &RttMeanDeviationTest::Ack, this, rtt, 7, Seconds (4));
+
+  // sample after the history is cleared
+  Simulator::Schedule (Seconds (5), &ndn::RttEstimator::SentSeq, rtt, SequenceNumber32 (1), 1);
+  Simulator::Schedule (Seconds (5), &ndn::RttEstimator::ClearSent, rtt);
+  Simulator::Schedule (Seconds (6), &RttMeanDeviationTest::Ack, this, rtt, 1, Seconds (0));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // first sample sets estimate, second one moves it by gain (0.125)
+  NS_TEST_ASSERT_MSG_EQ_TOL (rtt->GetCurrentEstimate ().ToDouble (Time::S), 2.25, 0.001, "");
+}
+
+}
@@ -0,0 +1,51 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_TEST_RTT_MEAN_DEVIATION_H
+#define NDNSIM_TEST_RTT_MEAN_DEVIATION_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+namespace ndn {
+class RttEstimator;
+}
+
+class RttMeanDeviationTest : public TestCase
+{
+public:
+  RttMeanDeviationTest ()
+    : TestCase ("RTT estimator with out-of-order acknowledgements test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  Ack (Ptr<ndn::RttEstimator> rtt, uint32_t seq, Time expectedRtt);
+};
+
+}
+
+#endif // NDNSIM_TEST_RTT_MEAN_DEVIATION_H
@@ -128,6 +128,27 @@ DataSerializationTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (source->GetFreshness (), target->GetFreshness (), "source/target freshness failed");
   NS_TEST_ASSERT_MSG_EQ (source->GetTimestamp (), target->GetTimestamp (), "source/target timestamp failed");
   NS_TEST_ASSERT_MSG_EQ (source->GetSignature (), target->GetSignature (), "source/target signature failed");
+
+  // overlays share everything, except per-transmission state
+  FwHopCountTag hopCountTag;
+  hopCountTag.Increment ();
+  target->GetPayload ()->AddPacketTag (hopCountTag);
+
+  Ptr<Data> overlay = target->CreateOverlay ();
+  NS_TEST_ASSERT_MSG_EQ (overlay->GetName (), target->GetName (), "overlay name failed");
+  NS_TEST_ASSERT_MSG_EQ (overlay->GetPayload (), target->GetPayload (), "overlay should share payload");
+  NS_TEST_ASSERT_MSG_EQ (overlay->GetWire (), target->GetWire (), "overlay should share wire format");
+
+  NS_TEST_ASSERT_MSG_EQ (Wire::FromData (overlay)->PeekPacketTag (hopCountTag), false,
+                         "overlay should not carry tags of the original");
+
+  overlay->SetTimeSinceBirth (5);
+  overlay->SetHopCountTag (FwHopCountTag ());
+  Ptr<Packet> overlayPacket = Wire::FromData (overlay);
+  NS_TEST_ASSERT_MSG_EQ (overlayPacket->PeekPacketTag (hopCountTag), true, "overlay hop count tag failed");
+  NS_TEST_ASSERT_MSG_EQ (hopCountTag.Get (), 0, "overlay hop count tag failed");
+  NS_TEST_ASSERT_MSG_EQ (target->GetTimeSinceBirth (), 0, "original should not be modified");
+  NS_TEST_ASSERT_MSG_EQ (Wire::ToData (overlayPacket)->GetTimeSinceBirth (), 5, "overlay TSB failed");
 }
 
 }
@@ -0,0 +1,184 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-spring-mobility.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include "ns3/spring-mobility-model.h"
+
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.SpringMobilityTest");
+
+namespace ns3 {
+
+namespace {
+
+// must be the same as parameters of SpringMobilityModel
+const double COLOUMB_K = 200;
+const double NODE_MASS = 10;
+const double NODE_CHARGE = 2;
+const double SPRING_NORMAL_LENGTH = 10;
+const double SPRING_CONSTANT = 0.2;
+const double DAMPING_FACTOR = 0.8;
+const double STEP = 0.05;
+
+/**
+ * Straightforward implementation of the model: every node is updated in turn, using already
+ * updated positions of the preceding nodes, and all pairs of nodes are visited
+ */
+class Reference
+{
+public:
+  Reference (const std::vector<Vector> &positions, const std::vector<std::vector<uint32_t> > &springs)
+    : m_position (positions)
+    , m_velocity (positions.size (), Vector (0, 0, 0))
+    , m_springs (springs)
+  {
+  }
+
+  void
+  Step ()
+  {
+    for (uint32_t index = 0; index < m_position.size (); index++)
+      {
+        Vector force (0.0, 0.0, 0.0);
+        for (uint32_t node = 0; node < m_position.size (); node++)
+          {
+            if (node == index) continue;
+
+            double distance = CalculateDistance (m_position[index], m_position[node]);
+            if (distance < 0.1) continue;
+
+            Vector direction = (m_position[index] - m_position[node]) / distance;
+            force += direction * COLOUMB_K * NODE_CHARGE * NODE_CHARGE / distance / distance;
+          }
+
+        for (uint32_t spring = 0; spring < m_springs[index].size (); spring++)
+          {
+            const Vector &other = m_position[m_springs[index][spring]];
+            double distance = CalculateDistance (m_position[index], other);
+            Vector direction = (other - m_position[index]) / distance;
+            force += direction * (- SPRING_NORMAL_LENGTH + distance) / SPRING_CONSTANT;
+          }
+
+        m_velocity[index] = (m_velocity[index] + force * STEP) * DAMPING_FACTOR;
+        m_position[index] += m_velocity[index] * STEP;
+      }
+  }
+
+  double
+  GetKineticEnergy () const
+  {
+    double energy = 0;
+    for (uint32_t index = 0; index < m_velocity.size (); index++)
+      {
+        double velocity = CalculateDistance (m_velocity[index], Vector (0, 0, 0));
+        energy += NODE_MASS * velocity * velocity;
+      }
+    return energy;
+  }
+
+  const Vector &
+  GetPosition (uint32_t index) const
+  {
+    return m_position[index];
+  }
+
+private:
+  std::vector<Vector> m_position;
+  std::vector<Vector> m_velocity;
+  std::vector<std::vector<uint32_t> > m_springs;
+};
+
+}
+
+void
+SpringMobilityTest::DoRun ()
+{
+  const uint32_t nodeCount = 40;
+  const uint32_t stepCount = 20;
+
+  NodeContainer nodes;
+  nodes.Create (nodeCount);
+
+  // ring with random chords, nodes placed at random in 200x200 square
+  UniformVariable rand (0, 1);
+  std::vector<std::vector<uint32_t> > springs (nodeCount);
+  std::vector<Vector> positions;
+  for (uint32_t i = 0; i < nodeCount; i++)
+    {
+      uint32_t next = (i + 1) % nodeCount;
+      springs[i].push_back (next);
+      springs[next].push_back (i);
+
+      uint32_t chord = rand.GetInteger (0, nodeCount - 1);
+      if (chord != i && chord != next)
+        {
+          springs[i].push_back (chord);
+          springs[chord].push_back (i);
+        }
+
+      positions.push_back (Vector (rand.GetValue () * 200, rand.GetValue () * 200, 0));
+    }
+
+  std::vector<Ptr<SpringMobilityModel> > models;
+  for (uint32_t i = 0; i < nodeCount; i++)
+    {
+      Ptr<SpringMobilityModel> model = CreateObject<SpringMobilityModel> ();
+      model->SetAttribute ("Theta", DoubleValue (0.0));
+      nodes.Get (i)->AggregateObject (model);
+      models.push_back (model);
+    }
+
+  for (uint32_t i = 0; i < nodeCount; i++)
+    {
+      for (uint32_t spring = 0; spring < springs[i].size (); spring++)
+        {
+          models[i]->AddSpring (models[springs[i][spring]]);
+        }
+      models[i]->SetPosition (positions[i]);
+    }
+
+  Reference reference (positions, springs);
+  for (uint32_t step = 0; step < stepCount; step++)
+    {
+      reference.Step ();
+      // otherwise the model stops moving nodes earlier
+      NS_TEST_ASSERT_MSG_GT (reference.GetKineticEnergy (), 100.0, "Nodes should not stabilize during the test");
+    }
+
+  Simulator::Stop (Seconds (STEP * stepCount + STEP / 2));
+  Simulator::Run ();
+
+  for (uint32_t i = 0; i < nodeCount; i++)
+    {
+      Vector position = models[i]->GetPosition ();
+      NS_TEST_EXPECT_MSG_NE (position.x, positions[i].x, "Node " << i << " should move");
+      NS_TEST_EXPECT_MSG_EQ (position.x, reference.GetPosition (i).x, "Node " << i);
+      NS_TEST_EXPECT_MSG_EQ (position.y, reference.GetPosition (i).y, "Node " << i);
+      NS_TEST_EXPECT_MSG_EQ (position.z, reference.GetPosition (i).z, "Node " << i);
+    }
+
+  Simulator::Destroy ();
+}
+
+}
@@ -25,6 +25,27 @@
 #include "ndnSIM-pit.h"
 #include "ndnSIM-fib-entry.h"
 #include "ndnSIM-api.h"
+#include "ndnSIM-prefix-hash.h"
+#include "ndnSIM-name.h"
+#include "ndnSIM-name-table.h"
+#include "ndnSIM-binary-trace.h"
+#include "ndnSIM-log-histogram.h"
+#include "ndnSIM-limits.h"
+#include "ndnSIM-ccnb-parser.h"
+#include "ndnSIM-decoded-packet-cache.h"
+#include "ndnSIM-global-routing-update.h"
+#include "ndnSIM-global-routing-parallel.h"
+#include "ndnSIM-lfu-policy.h"
+#include "ndnSIM-tiny-lfu-policy.h"
+#include "ndnSIM-request-table.h"
+#include "ndnSIM-rtt-mean-deviation.h"
+#include "ndnSIM-cs-hop-count.h"
+#include "ndnSIM-consumer-retx-check.h"
+#include "ndnSIM-fib-face-ranking.h"
+#include "ndnSIM-fw-batch.h"
+#ifdef NS3_NDNSIM_WITH_MOBILITY
+#include "ndnSIM-spring-mobility.h"
+#endif
 
 namespace ns3
 {
@@ -41,7 +62,29 @@ public:
     AddTestCase (new DataSerializationTest (), TestCase::QUICK);
     AddTestCase (new FibEntryTest (), TestCase::QUICK);
     AddTestCase (new PitTest (), TestCase::QUICK);
+    AddTestCase (new PitTest ("40ms"), TestCase::QUICK);
     AddTestCase (new ApiTest (), TestCase::QUICK);
+    AddTestCase (new PrefixHashTest (), TestCase::QUICK);
+    AddTestCase (new NameTest (), TestCase::QUICK);
+    AddTestCase (new NameTableTest (), TestCase::QUICK);
+    AddTestCase (new BinaryTraceTest (), TestCase::QUICK);
+    AddTestCase (new LogHistogramTest (), TestCase::QUICK);
+    AddTestCase (new LimitsLazyRateTest (), TestCase::QUICK);
+    AddTestCase (new CcnbStreamParserTest (), TestCase::QUICK);
+    AddTestCase (new DecodedPacketCacheTest (), TestCase::QUICK);
+    AddTestCase (new GlobalRoutingUpdateTest (), TestCase::QUICK);
+    AddTestCase (new GlobalRoutingParallelTest (), TestCase::QUICK);
+    AddTestCase (new LfuPolicyTest (), TestCase::QUICK);
+    AddTestCase (new TinyLfuPolicyTest (), TestCase::QUICK);
+    AddTestCase (new RequestTableTest (), TestCase::QUICK);
+    AddTestCase (new RttMeanDeviationTest (), TestCase::QUICK);
+    AddTestCase (new CsHopCountTest (), TestCase::QUICK);
+    AddTestCase (new ConsumerRetxCheckTest (), TestCase::QUICK);
+    AddTestCase (new FibFaceRankingTest (), TestCase::QUICK);
+    AddTestCase (new FwBatchTest (), TestCase::QUICK);
+#ifdef NS3_NDNSIM_WITH_MOBILITY
+    AddTestCase (new SpringMobilityTest (), TestCase::QUICK);
+#endif
   }
 };
 
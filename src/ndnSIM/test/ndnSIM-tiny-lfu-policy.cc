@@ -0,0 +1,210 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-tiny-lfu-policy.h"
+
+#include "ns3/ndn-name.h"
+#include "ns3/random-variable.h"
+
+#include "../utils/trie/trie-with-policy.h"
+#include "../utils/trie/lru-policy.h"
+#include "../utils/trie/multi-policy.h"
+#include "../utils/trie/tiny-lfu-admission-policy.h"
+#include "../utils/trie/w-tiny-lfu-policy.h"
+
+#include <boost/lexical_cast.hpp>
+
+using namespace ns3::ndn::ndnSIM;
+
+namespace ns3
+{
+
+/// @cond include_hidden
+namespace {
+
+class Payload : public SimpleRefCount<Payload>
+{
+};
+
+typedef trie_with_policy<ndn::Name,
+                         smart_pointer_payload_traits<Payload>,
+                         multi_policy_traits< boost::mpl::vector2< lru_policy_traits,
+                                                                   tiny_lfu_admission_policy_traits > > > admission_trie;
+
+typedef trie_with_policy<ndn::Name,
+                         smart_pointer_payload_traits<Payload>,
+                         w_tiny_lfu_policy_traits> w_tiny_lfu_trie;
+
+ndn::Name
+MakeName (uint32_t id)
+{
+  ndn::Name name;
+  name.append (boost::lexical_cast<std::string> (id));
+  return name;
+}
+
+template<class Trie>
+std::string
+GetOrder (const Trie &trie)
+{
+  std::string order;
+  for (typename Trie::policy_container::const_iterator item = trie.getPolicy ().begin ();
+       item != trie.getPolicy ().end ();
+       item++)
+    {
+      order += boost::lexical_cast<std::string> (item->key ()) + " ";
+    }
+  return order;
+}
+
+}
+/// @endcond
+
+void
+TinyLfuPolicyTest::DoRun ()
+{
+  // count-min sketch
+  {
+    detail::count_min_sketch sketch (16);
+    for (uint32_t i = 0; i < 5; i++)
+      sketch.increment (1);
+    NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (sketch.estimate (1)), 5, "");
+    NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (sketch.estimate (2)), 0, "");
+
+    for (uint32_t i = 0; i < 20; i++)
+      sketch.increment (2);
+    NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (sketch.estimate (2)), 15, "counters should saturate");
+
+    // after 10 * width increments all counters are halved
+    for (uint32_t i = 0; sketch.estimate (2) == 15 && i < 10 * sketch.width (); i++)
+      sketch.increment (1000 + i);
+    NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (sketch.estimate (2)), 7, "counters should be aged");
+    NS_TEST_ASSERT_MSG_EQ ((sketch.estimate (1) <= 5), true, "counters should be aged");
+
+    sketch.clear ();
+    NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (sketch.estimate (2)), 0, "");
+  }
+
+  Ptr<Payload> payload = Create<Payload> ();
+
+  // LRU with TinyLFU admission
+  {
+    admission_trie trie;
+    trie.getPolicy ().set_max_size (3);
+
+    for (uint32_t id = 1; id <= 3; id++)
+      trie.insert (MakeName (id), payload);
+    for (uint32_t i = 0; i < 2; i++)
+      for (uint32_t id = 1; id <= 3; id++)
+        trie.getPolicy ().lookup (trie.find_exact (MakeName (id)));
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "1 2 3 ", "");
+
+    // 4 is not admitted until it becomes more popular than 1 (3 requests)
+    for (uint32_t i = 0; i < 3; i++)
+      {
+        NS_TEST_ASSERT_MSG_EQ (trie.insert (MakeName (4), payload).first, trie.end (), "");
+        NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "1 2 3 ", "");
+      }
+
+    NS_TEST_ASSERT_MSG_NE (trie.insert (MakeName (4), payload).first, trie.end (), "");
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "2 3 4 ", "");
+
+    trie.erase (MakeName (3));
+    NS_TEST_ASSERT_MSG_NE (trie.insert (MakeName (5), payload).first, trie.end (), "should be admitted if there is space");
+    NS_TEST_ASSERT_MSG_EQ (GetOrder (trie), "2 4 5 ", "");
+  }
+
+  // W-TinyLFU: popular items survive a scan
+  {
+    w_tiny_lfu_trie trie;
+    trie.getPolicy ().set_max_size (10);
+
+    for (uint32_t id = 1; id <= 10; id++)
+      trie.insert (MakeName (id), payload);
+    for (uint32_t i = 0; i < 3; i++)
+      for (uint32_t id = 1; id <= 5; id++)
+        trie.getPolicy ().lookup (trie.find_exact (MakeName (id)));
+
+    for (uint32_t id = 1000; id < 1100; id++)
+      {
+        trie.insert (MakeName (id), payload);
+        NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 10, "");
+      }
+
+    for (uint32_t id = 1; id <= 5; id++)
+      NS_TEST_ASSERT_MSG_NE (trie.find_exact (MakeName (id)), trie.end (), "item " << id << " should stay in the cache");
+    NS_TEST_ASSERT_MSG_NE (trie.find_exact (MakeName (1099)), trie.end (), "new item should be in the window");
+    NS_TEST_ASSERT_MSG_EQ (trie.find_exact (MakeName (1098)), trie.end (), "");
+  }
+
+  // W-TinyLFU: random sequence of operations keeps segments consistent
+  {
+    const uint32_t maxSize = 200;
+    w_tiny_lfu_trie trie;
+    trie.getPolicy ().set_max_size (maxSize);
+
+    UniformVariable rand (0, 1);
+    for (uint32_t i = 0; i < 20000; i++)
+      {
+        uint32_t id = static_cast<uint32_t> (1000 * rand.GetValue () * rand.GetValue ());
+        uint32_t op = rand.GetInteger (0, 9);
+
+        if (op == 0)
+          trie.erase (MakeName (id));
+        else
+          {
+            w_tiny_lfu_trie::iterator item = trie.find_exact (MakeName (id));
+            if (item != trie.end ())
+              trie.getPolicy ().lookup (item);
+            else
+              trie.insert (MakeName (id), payload);
+          }
+
+        NS_TEST_ASSERT_MSG_EQ ((trie.getPolicy ().size () <= maxSize), true, "at step " << i);
+      }
+
+    // refill the cache after erasures
+    for (uint32_t id = 5000; id < 5000 + maxSize; id++)
+      trie.insert (MakeName (id), payload);
+
+    // segments should go in order: probation, protected, window
+    uint32_t segment = w_tiny_lfu_policy_traits::PROBATION;
+    uint32_t protectedSize = 0;
+    uint32_t windowSize = 0;
+    for (w_tiny_lfu_trie::policy_container::iterator item = trie.getPolicy ().begin ();
+         item != trie.getPolicy ().end ();
+         item++)
+      {
+        uint32_t itemSegment = w_tiny_lfu_trie::policy_container::policy_base::get_segment (&(*item));
+        NS_TEST_ASSERT_MSG_EQ ((itemSegment >= segment), true, "");
+        segment = itemSegment;
+
+        if (segment == w_tiny_lfu_policy_traits::PROTECTED)
+          protectedSize ++;
+        else if (segment == w_tiny_lfu_policy_traits::WINDOW)
+          windowSize ++;
+      }
+    NS_TEST_ASSERT_MSG_EQ (windowSize, 2, "");
+    NS_TEST_ASSERT_MSG_EQ ((protectedSize <= (maxSize - 2) * 4 / 5), true, "");
+    NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), maxSize, "");
+  }
+}
+
+}
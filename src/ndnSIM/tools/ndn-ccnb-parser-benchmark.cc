@@ -0,0 +1,140 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of CCNb decoding throughput: single-pass stream parser vs. syntax tree parser with visitors
+//
+//     ./waf --run="ndn-ccnb-parser-benchmark --packets=1000 --rounds=1000"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/ndnSIM/model/wire/ccnb.h"
+
+#include <boost/lexical_cast.hpp>
+
+using namespace ns3;
+using namespace std;
+
+static Buffer
+ToBuffer (Ptr<const Packet> packet)
+{
+  std::vector<uint8_t> bytes (packet->GetSize ());
+  packet->CopyData (&bytes[0], bytes.size ());
+
+  Buffer buffer;
+  buffer.AddAtStart (bytes.size ());
+  buffer.Begin ().Write (&bytes[0], bytes.size ());
+  return buffer;
+}
+
+/**
+ * Interests and Data as generated by ndn::ConsumerCbr and ndn::Producer (sequence number as
+ * the last component, random nonce, 2s lifetime, 1024-byte virtual payload)
+ */
+static void
+CreatePackets (uint32_t count, const std::string &prefix, std::vector<Buffer> &interests, std::vector<Buffer> &data)
+{
+  UniformVariable rand (0, std::numeric_limits<uint32_t>::max ());
+
+  for (uint32_t seq = 0; seq < count; seq++)
+    {
+      Ptr<ndn::Name> name = Create<ndn::Name> (boost::lexical_cast<ndn::Name> (prefix));
+      name->appendSeqNum (seq);
+
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetNonce (rand.GetValue ());
+      interest->SetName (name);
+      interest->SetInterestLifetime (Seconds (2.0));
+      interests.push_back (ToBuffer (ndn::wire::ccnb::Interest::ToWire (interest)));
+
+      Ptr<ndn::Data> contentObject = Create<ndn::Data> (Create<Packet> (1024));
+      contentObject->SetName (name);
+      contentObject->SetTimestamp (MilliSeconds (1000 + 7 * seq));
+      contentObject->SetFreshness (Seconds (10));
+      contentObject->SetSignature (rand.GetValue ());
+      data.push_back (ToBuffer (ndn::wire::ccnb::Data::ToWire (contentObject)));
+    }
+}
+
+template<class Header, class Decoded>
+static void
+RunBenchmark (const std::string &type, const std::string &parser, const std::vector<Buffer> &packets, uint32_t rounds)
+{
+  bool stream = (parser == "Stream");
+
+  uint64_t checksum = 0;
+  SystemWallClockMs timer;
+  timer.Start ();
+  for (uint32_t round = 0; round < rounds; round++)
+    {
+      for (std::vector<Buffer>::const_iterator packet = packets.begin (); packet != packets.end (); packet++)
+        {
+          Ptr<Decoded> decoded = Create<Decoded> ();
+          Header header (decoded);
+          if (stream)
+            checksum += header.DeserializeStream (packet->Begin ());
+          else
+            checksum += header.DeserializeSyntaxTree (packet->Begin ());
+          checksum += decoded->GetName ().size ();
+        }
+    }
+  int64_t time = timer.End ();
+
+  uint64_t decodes = static_cast<uint64_t> (rounds) * packets.size ();
+  std::cout << type << "\t"
+            << parser << "\t"
+            << decodes << "\t"
+            << time << "\t"
+            << (time > 0 ? static_cast<double> (decodes) * 1000 / time : 0) << "\t"
+            << static_cast<double> (checksum) / decodes << "\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t packets = 1000;
+  uint32_t rounds = 1000;
+  std::string prefix = "/com/example/video/segment";
+
+  CommandLine cmd;
+  cmd.AddValue ("packets", "Number of different Interests and Data packets", packets);
+  cmd.AddValue ("rounds", "Number of times each packet is decoded by each parser", rounds);
+  cmd.AddValue ("prefix", "Name prefix of the packets (sequence number is appended)", prefix);
+  cmd.Parse (argc, argv);
+
+  std::vector<Buffer> interests;
+  std::vector<Buffer> data;
+  CreatePackets (packets, prefix, interests, data);
+
+  std::cout << "Type" << "\t"
+            << "Parser" << "\t"
+            << "Decodes" << "\t"
+            << "TimeMs" << "\t"
+            << "DecodesPerSecond" << "\t"
+            << "Checksum" << "\n";
+
+  RunBenchmark<ndn::wire::ccnb::Interest, ndn::Interest> ("Interest", "SyntaxTree", interests, rounds);
+  RunBenchmark<ndn::wire::ccnb::Interest, ndn::Interest> ("Interest", "Stream", interests, rounds);
+  RunBenchmark<ndn::wire::ccnb::Data, ndn::Data> ("Data", "SyntaxTree", data, rounds);
+  RunBenchmark<ndn::wire::ccnb::Data, ndn::Data> ("Data", "Stream", data, rounds);
+
+  return 0;
+}
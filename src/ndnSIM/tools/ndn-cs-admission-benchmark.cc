@@ -0,0 +1,125 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Hit ratios of content stores with and without TinyLFU admission for Zipf-Mandelbrot requests
+//
+//     ./waf --run="ndn-cs-admission-benchmark --contents=100000 --cacheSize=1000 --requests=1000000"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.h"
+
+#include <boost/lexical_cast.hpp>
+#include <vector>
+
+using namespace ns3;
+using namespace std;
+
+/**
+ * Content store-like usage: lookup for every request, Add on a miss (as if Data was fetched upstream)
+ */
+void
+RunBenchmark (const std::string &policy, uint32_t cacheSize, const std::vector<uint32_t> &requests)
+{
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::ndn::cs::" + policy);
+  factory.Set ("MaxSize", StringValue (boost::lexical_cast<std::string> (cacheSize)));
+  Ptr<ndn::ContentStore> cs = factory.Create<ndn::ContentStore> ();
+
+  uint64_t hits = 0;
+  uint64_t added = 0;
+  SystemWallClockMs timer;
+  timer.Start ();
+
+  for (std::vector<uint32_t>::const_iterator request = requests.begin (); request != requests.end (); request++)
+    {
+      Ptr<ndn::Name> name = Create<ndn::Name> ("/prefix");
+      name->appendSeqNum (*request);
+
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetName (name);
+      if (cs->Lookup (interest) != 0)
+        {
+          hits ++;
+          continue;
+        }
+
+      Ptr<ndn::Data> data = Create<ndn::Data> ();
+      data->SetName (name);
+      if (cs->Add (data))
+        added ++;
+    }
+
+  int64_t elapsed = timer.End ();
+
+  std::cout << policy << "\t"
+            << cacheSize << "\t"
+            << requests.size () << "\t"
+            << static_cast<double> (hits) / requests.size () << "\t"
+            << added << "\t"
+            << elapsed << "\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t contents = 100000;
+  uint32_t cacheSize = 1000;
+  uint32_t requests = 1000000;
+  double q = 0.7;
+  double s = 0.8;
+
+  CommandLine cmd;
+  cmd.AddValue ("contents", "Number of distinct names", contents);
+  cmd.AddValue ("cacheSize", "MaxSize of the content stores", cacheSize);
+  cmd.AddValue ("requests", "Number of requests", requests);
+  cmd.AddValue ("q", "Zipf-Mandelbrot q parameter", q);
+  cmd.AddValue ("s", "Zipf-Mandelbrot s parameter", s);
+  cmd.Parse (argc, argv);
+
+  // request sequence (same for all content stores)
+  Ptr<ndn::ConsumerZipfMandelbrot> consumer = CreateObject<ndn::ConsumerZipfMandelbrot> ();
+  consumer->SetAttribute ("NumberOfContents", UintegerValue (contents));
+  consumer->SetAttribute ("q", DoubleValue (q));
+  consumer->SetAttribute ("s", DoubleValue (s));
+
+  std::vector<uint32_t> sequence (requests);
+  for (uint32_t i = 0; i < requests; i++)
+    {
+      sequence[i] = consumer->GetNextSeq ();
+    }
+
+  std::cout << "ContentStore" << "\t"
+            << "CacheSize" << "\t"
+            << "Requests" << "\t"
+            << "HitRatio" << "\t"
+            << "Added" << "\t"
+            << "TimeMs" << "\n";
+
+  RunBenchmark ("Lru", cacheSize, sequence);
+  RunBenchmark ("Lfu", cacheSize, sequence);
+  RunBenchmark ("Lru::TinyLfu", cacheSize, sequence);
+  RunBenchmark ("Lfu::TinyLfu", cacheSize, sequence);
+  RunBenchmark ("WTinyLfu", cacheSize, sequence);
+
+  return 0;
+}
@@ -0,0 +1,273 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of LFU cache replacement: constant-time frequency buckets (lfu_policy_traits) vs.
+// the former implementation with items ordered in a multiset by frequency
+//
+//     ./waf --run="ndn-lfu-policy-benchmark --requests=2000000 --catalog-factor=4 --policy=Buckets"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/random-variable.h"
+
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.h"
+#include "ns3/ndnSIM/utils/trie/lfu-policy.h"
+
+#include <boost/intrusive/set.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace ns3;
+using namespace std;
+
+/**
+ * Former LFU policy, which keeps items in a multiset ordered by frequency (O(log n) per lookup)
+ */
+struct multiset_lfu_policy_traits
+{
+  static std::string GetName () { return "LfuMultiset"; }
+
+  struct policy_hook_type : public boost::intrusive::set_member_hook<> { double frequency; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    static double& get_order (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->frequency;
+    }
+
+    static const double& get_order (typename Container::const_iterator item)
+    {
+      return static_cast<const policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->frequency;
+    }
+
+    template<class Key>
+    struct MemberHookLess
+    {
+      bool operator () (const Key &a, const Key &b) const
+      {
+        return get_order (&a) < get_order (&b);
+      }
+    };
+
+    typedef boost::intrusive::multiset< Container,
+                                        boost::intrusive::compare< MemberHookLess< Container > >,
+                                        Hook > policy_container;
+
+    class type : public policy_container
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        lookup (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        get_order (item) = 0;
+
+        if (max_size_ != 0 && policy_container::size () >= max_size_)
+          {
+            base_.erase (&(*policy_container::begin ()));
+          }
+
+        policy_container::insert (*item);
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        policy_container::erase (policy_container::s_iterator_to (*item));
+        get_order (item) += 1;
+        policy_container::insert (*item);
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      Base &base_;
+      size_t max_size_;
+    };
+  };
+};
+
+class Payload : public SimpleRefCount<Payload>
+{
+};
+
+static ndn::Name
+MakeName (uint32_t id)
+{
+  ndn::Name name;
+  name.append ("prefix").appendSeqNum (id);
+  return name;
+}
+
+/**
+ * Content store-like usage: lookup of the exact name, insertion on a miss
+ */
+template<class PolicyTraits>
+static void
+RunBenchmark (const std::string &label, uint32_t cacheSize, const std::vector<uint32_t> &requests)
+{
+  typedef ndn::ndnSIM::trie_with_policy<ndn::Name,
+                                        ndn::ndnSIM::smart_pointer_payload_traits<Payload>,
+                                        PolicyTraits> cache_trie;
+
+  Ptr<Payload> payload = Create<Payload> ();
+  cache_trie cache;
+  cache.getPolicy ().set_max_size (cacheSize);
+
+  uint64_t hits = 0;
+  SystemWallClockMs timer;
+  timer.Start ();
+
+  for (std::vector<uint32_t>::const_iterator request = requests.begin (); request != requests.end (); request++)
+    {
+      ndn::Name name = MakeName (*request);
+      typename cache_trie::iterator item = cache.find_exact (name);
+      if (item != cache.end ())
+        {
+          cache.getPolicy ().lookup (item);
+          hits ++;
+        }
+      else
+        {
+          cache.insert (name, payload);
+        }
+    }
+
+  int64_t elapsed = timer.End ();
+
+  std::cout << label << "\t"
+            << cacheSize << "\t"
+            << requests.size () << "\t"
+            << static_cast<double> (hits) / requests.size () << "\t"
+            << elapsed << "\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t requests = 2000000;
+  uint32_t catalogFactor = 4;
+  uint32_t minSize = 1000;
+  uint32_t maxSize = 1000000;
+  double alpha = 0.8;
+  std::string policy = "both";
+
+  CommandLine cmd;
+  cmd.AddValue ("requests", "Number of requests for each cache size", requests);
+  cmd.AddValue ("catalog-factor", "Number of distinct names relative to the cache size", catalogFactor);
+  cmd.AddValue ("min-size", "Smallest cache size", minSize);
+  cmd.AddValue ("max-size", "Largest cache size (sizes are increased 10 times each step)", maxSize);
+  cmd.AddValue ("alpha", "Zipf parameter for name popularity", alpha);
+  cmd.AddValue ("policy", "Policy to benchmark (Multiset, Buckets, or both). Runs in the same process affect "
+                "each other's memory layout, so for timing it is better to run each policy separately", policy);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Policy" << "\t"
+            << "CacheSize" << "\t"
+            << "Requests" << "\t"
+            << "HitRatio" << "\t"
+            << "TimeMs" << "\n";
+
+  for (uint32_t cacheSize = minSize; cacheSize <= maxSize; cacheSize *= 10)
+    {
+      uint32_t catalog = cacheSize * catalogFactor;
+
+      // Zipf-distributed request sequence (same for both policies)
+      std::vector<double> cdf (catalog);
+      double sum = 0;
+      for (uint32_t i = 0; i < catalog; i++)
+        {
+          sum += 1.0 / std::pow (static_cast<double> (i + 1), alpha);
+          cdf[i] = sum;
+        }
+
+      UniformVariable rand (0, sum);
+      std::vector<uint32_t> sequence (requests);
+      for (uint32_t i = 0; i < requests; i++)
+        {
+          sequence[i] = std::min<uint32_t> (std::lower_bound (cdf.begin (), cdf.end (), rand.GetValue ()) - cdf.begin (),
+                                            catalog - 1);
+        }
+
+      if (policy == "both" || policy == "Multiset")
+        RunBenchmark<multiset_lfu_policy_traits> ("Multiset", cacheSize, sequence);
+      if (policy == "both" || policy == "Buckets")
+        RunBenchmark<ndn::ndnSIM::lfu_policy_traits> ("Buckets", cacheSize, sequence);
+
+      if (cacheSize > maxSize / 10)
+        break; // avoid overflow
+    }
+
+  return 0;
+}
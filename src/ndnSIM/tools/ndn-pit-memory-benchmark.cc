@@ -0,0 +1,147 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Memory usage of PIT entries and their incoming/outgoing face records and nonces
+//
+//     ./waf --run="ndn-pit-memory-benchmark --entries=200000 --incoming=2 --outgoing=1 --nonces=2"
+//
+// Memory is measured as the change of the resident set size (utils/mem-usage.h), so the
+// number of entries should be large enough to amortize page granularity.
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.h"
+
+#include <vector>
+
+using namespace ns3;
+using namespace std;
+
+// run from inside the simulation, when Time objects are no longer tracked by the simulator
+static void
+Measure (Ptr<Node> node, uint32_t entries, uint32_t incoming, uint32_t outgoing, uint32_t nonces)
+{
+  uint32_t faces = std::max<uint32_t> (1, std::max (incoming, outgoing));
+  Ptr<ndn::L3Protocol> ndn = node->GetObject<ndn::L3Protocol> ();
+  Ptr<ndn::Pit> pit = node->GetObject<ndn::Pit> ();
+
+  std::vector< Ptr<ndn::Interest> > interests (entries);
+  for (uint32_t i = 0; i < entries; i++)
+    {
+      Ptr<ndn::Name> name = Create<ndn::Name> ("/prefix");
+      name->appendSeqNum (i);
+
+      interests[i] = Create<ndn::Interest> ();
+      interests[i]->SetName (name);
+      interests[i]->SetInterestLifetime (Seconds (1000.0));
+    }
+
+  int64_t memBefore = MemUsage::Get ();
+  SystemWallClockMs timer;
+  timer.Start ();
+
+  std::vector< Ptr<ndn::pit::Entry> > pitEntries (entries);
+  for (uint32_t i = 0; i < entries; i++)
+    {
+      pitEntries[i] = pit->Create (interests[i]);
+    }
+
+  int64_t memEntries = MemUsage::Get ();
+  int64_t timeEntries = timer.End ();
+  timer.Start ();
+
+  for (uint32_t i = 0; i < entries; i++)
+    {
+      for (uint32_t face = 0; face < incoming; face++)
+        pitEntries[i]->AddIncoming (ndn->GetFace (face));
+      for (uint32_t face = 0; face < outgoing; face++)
+        pitEntries[i]->AddOutgoing (ndn->GetFace (face));
+      for (uint32_t nonce = 0; nonce < nonces; nonce++)
+        pitEntries[i]->AddSeenNonce (i + nonce);
+    }
+
+  // typical forwarding strategy lookups
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < entries; i++)
+    {
+      if (pitEntries[i]->IsNonceSeen (i + nonces))
+        found ++;
+      if (pitEntries[i]->GetOutgoing ().find (ndn->GetFace (0)) != pitEntries[i]->GetOutgoing ().end ())
+        found ++;
+      if (pitEntries[i]->GetIncoming ().find (ndn->GetFace (faces - 1)) != pitEntries[i]->GetIncoming ().end ())
+        found ++;
+    }
+
+  int64_t memRecords = MemUsage::Get ();
+  int64_t timeRecords = timer.End ();
+
+  std::cout << "sizeof (pit::Entry)" << "\t" << sizeof (ndn::pit::Entry) << "\n"
+            << "Entries" << "\t" << pit->GetSize () << "\n"
+            << "BytesPerEntry" << "\t" << static_cast<double> (memEntries - memBefore) / entries << "\n"
+            << "RecordBytesPerEntry" << "\t" << static_cast<double> (memRecords - memEntries) / entries << "\n"
+            << "TotalBytesPerEntry" << "\t" << static_cast<double> (memRecords - memBefore) / entries << "\n"
+            << "CreateTimeMs" << "\t" << timeEntries << "\n"
+            << "RecordsAndLookupsTimeMs" << "\t" << timeRecords << "\n"
+            << "Found" << "\t" << found << "\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t entries = 200000;
+  uint32_t incoming = 2;
+  uint32_t outgoing = 1;
+  uint32_t nonces = 2;
+
+  CommandLine cmd;
+  cmd.AddValue ("entries", "Number of PIT entries", entries);
+  cmd.AddValue ("incoming", "Number of incoming face records per entry", incoming);
+  cmd.AddValue ("outgoing", "Number of outgoing face records per entry", outgoing);
+  cmd.AddValue ("nonces", "Number of seen nonces per entry", nonces);
+  cmd.Parse (argc, argv);
+
+  // one node connected to enough neighbors to have the requested number of distinct faces
+  uint32_t faces = std::max<uint32_t> (1, std::max (incoming, outgoing));
+  NodeContainer nodes;
+  nodes.Create (faces + 1);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 1; i <= faces; i++)
+    {
+      p2p.Install (nodes.Get (0), nodes.Get (i));
+    }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetPit ("ns3::ndn::pit::Persistent", "MaxSize", "0");
+  ndnHelper.Install (nodes);
+
+  ndn::StackHelper::AddRoute (nodes.Get (0), "/", nodes.Get (0)->GetObject<ndn::L3Protocol> ()->GetFace (0), 0);
+
+  Simulator::Schedule (Seconds (0.0), Measure, nodes.Get (0), entries, incoming, outgoing, nonces);
+  Simulator::Stop (Seconds (0.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return 0;
+}
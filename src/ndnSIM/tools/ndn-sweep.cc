@@ -0,0 +1,383 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Parallel parameter sweep over an already built simulation scenario
+//
+//     ./waf --run="ndn-sweep --program=build/scratch/probcache --output=simulations/sweep
+//                            --grid=protocol=Betweeness,Probcache,CEE;mandelbrot=0.5,1.2;frequency=20,40,60
+//                            --subdirs=simulations/agg,simulations/delay,simulations/cs"
+//
+// Every combination of grid values (times the number of replications) is run as a separate
+// process with --name=value arguments (i.e., both CommandLine values and Config attributes,
+// such as ns3::ndn::ConsumerCbr::Frequency, can be swept) and a distinct --RngRun.  Processes
+// are started inside their own run directories (<output>/run-<N>), so trace files with relative
+// names end up in per-run directories.  For the same reason, input files (e.g., topologies) should
+// be passed to the scenario with absolute paths (e.g., using --args).  Standard output and error
+// of each run are saved as stdout.txt and stderr.txt, and <output>/manifest.txt lists all runs
+// with their parameters.
+
+#include "ns3/core-module.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <iomanip>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+using namespace ns3;
+using namespace std;
+
+struct Dimension
+{
+  string name;
+  vector<string> values;
+};
+
+struct Run
+{
+  uint32_t id;
+  uint32_t rngRun;
+  string directory;
+  vector<string> values; // one value per dimension
+  int status;
+  int64_t timeMs;
+};
+
+static int64_t
+NowMs ()
+{
+  struct timeval tv;
+  gettimeofday (&tv, 0);
+  return static_cast<int64_t> (tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
+// create directory with all parents (mkdir -p)
+static bool
+MakeDirectories (const string &path)
+{
+  string current;
+  vector<string> parts;
+  boost::split (parts, path, boost::is_any_of ("/"));
+  if (!path.empty () && path[0] == '/')
+    current = "/";
+
+  for (vector<string>::iterator part = parts.begin (); part != parts.end (); part++)
+    {
+      if (part->empty ())
+        continue;
+
+      current += *part + "/";
+      if (mkdir (current.c_str (), 0755) != 0 && errno != EEXIST)
+        return false;
+    }
+  return true;
+}
+
+static vector<Dimension>
+ParseGrid (const string &grid)
+{
+  vector<Dimension> dimensions;
+
+  vector<string> items;
+  boost::split (items, grid, boost::is_any_of (";"));
+  for (vector<string>::iterator item = items.begin (); item != items.end (); item++)
+    {
+      boost::trim (*item);
+      if (item->empty ())
+        continue;
+
+      size_t pos = item->find ('=');
+      if (pos == string::npos || pos == 0)
+        throw std::invalid_argument ("Grid item should be in form name=value1,value2,... (got " + *item + ")");
+
+      Dimension dimension;
+      dimension.name = item->substr (0, pos);
+      string values = item->substr (pos + 1);
+      boost::split (dimension.values, values, boost::is_any_of (","));
+      dimensions.push_back (dimension);
+    }
+
+  return dimensions;
+}
+
+// start run in its directory, returns pid of the child process
+static pid_t
+StartRun (const string &program, const vector<string> &args, const Run &run)
+{
+  pid_t pid = fork ();
+  if (pid != 0)
+    return pid; // parent (or error)
+
+  // child
+  if (chdir (run.directory.c_str ()) != 0)
+    _exit (127);
+
+  int out = open ("stdout.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  int err = open ("stderr.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (out < 0 || err < 0)
+    _exit (127);
+  dup2 (out, STDOUT_FILENO);
+  dup2 (err, STDERR_FILENO);
+  close (out);
+  close (err);
+
+  vector<char*> argv;
+  argv.push_back (const_cast<char*> (program.c_str ()));
+  for (vector<string>::const_iterator arg = args.begin (); arg != args.end (); arg++)
+    {
+      argv.push_back (const_cast<char*> (arg->c_str ()));
+    }
+  argv.push_back (0);
+
+  execv (program.c_str (), &argv.front ());
+  cerr << "ERROR: cannot execute " << program << ": " << strerror (errno) << endl;
+  _exit (127);
+}
+
+int
+main (int argc, char *argv[])
+{
+  string program = "";
+  string grid = "";
+  string extraArgs = "";
+  string output = "sweep";
+  string subdirs = "";
+  uint32_t jobs = 0;
+  uint32_t replications = 1;
+  uint32_t firstRun = 1;
+
+  CommandLine cmd;
+  cmd.AddValue ("program", "Path to the built simulation scenario (e.g., build/scratch/probcache)", program);
+  cmd.AddValue ("grid", "Sweep grid: name=value1,value2,...;name2=value1,... (names are CommandLine values or Config attributes)", grid);
+  cmd.AddValue ("args", "Space-separated extra arguments passed to every run", extraArgs);
+  cmd.AddValue ("output", "Directory where per-run directories and the manifest are created", output);
+  cmd.AddValue ("subdirs", "Comma-separated list of directories to create inside each run directory", subdirs);
+  cmd.AddValue ("jobs", "Maximum number of simultaneously running simulations (0 means number of cores)", jobs);
+  cmd.AddValue ("replications", "Number of runs with different RngRun for each point of the grid", replications);
+  cmd.AddValue ("firstRun", "RngRun value of the first run (each next run gets the next value)", firstRun);
+  cmd.Parse (argc, argv);
+
+  if (program == "")
+    {
+      cerr << "ERROR: program needs to be specified" << endl;
+      cerr << endl;
+
+      cmd.PrintHelp (cerr);
+      return 1;
+    }
+
+  char resolved [PATH_MAX];
+  if (realpath (program.c_str (), resolved) == 0 || access (resolved, X_OK) != 0)
+    {
+      cerr << "ERROR: " << program << " is not an executable program" << endl;
+      return 1;
+    }
+  program = resolved;
+
+  vector<Dimension> dimensions;
+  try
+    {
+      dimensions = ParseGrid (grid);
+    }
+  catch (std::invalid_argument &error)
+    {
+      cerr << "ERROR: " << error.what () << endl;
+      return 1;
+    }
+
+  if (jobs == 0)
+    {
+      long cores = sysconf (_SC_NPROCESSORS_ONLN);
+      jobs = cores > 0 ? static_cast<uint32_t> (cores) : 1;
+    }
+
+  vector<string> fixedArgs;
+  boost::split (fixedArgs, extraArgs, boost::is_any_of (" "), boost::token_compress_on);
+  fixedArgs.erase (std::remove (fixedArgs.begin (), fixedArgs.end (), ""), fixedArgs.end ());
+
+  vector<string> runSubdirs;
+  boost::split (runSubdirs, subdirs, boost::is_any_of (","), boost::token_compress_on);
+  runSubdirs.erase (std::remove (runSubdirs.begin (), runSubdirs.end (), ""), runSubdirs.end ());
+
+  // enumerate all points of the grid (last dimension changes fastest)
+  uint32_t points = 1;
+  for (vector<Dimension>::iterator dimension = dimensions.begin (); dimension != dimensions.end (); dimension++)
+    {
+      points *= dimension->values.size ();
+    }
+
+  vector<Run> runs;
+  for (uint32_t point = 0; point < points; point++)
+    {
+      for (uint32_t replication = 0; replication < replications; replication++)
+        {
+          Run run;
+          run.id = runs.size () + 1;
+          run.rngRun = firstRun + runs.size ();
+          run.status = -1;
+          run.timeMs = 0;
+
+          ostringstream directory;
+          directory << output << "/run-" << setfill ('0') << setw (4) << run.id;
+          run.directory = directory.str ();
+
+          uint32_t index = point;
+          run.values.resize (dimensions.size ());
+          for (size_t i = dimensions.size (); i > 0; i--)
+            {
+              const Dimension &dimension = dimensions[i-1];
+              run.values[i-1] = dimension.values[index % dimension.values.size ()];
+              index /= dimension.values.size ();
+            }
+
+          runs.push_back (run);
+        }
+    }
+
+  for (vector<Run>::iterator run = runs.begin (); run != runs.end (); run++)
+    {
+      bool ok = MakeDirectories (run->directory);
+      for (vector<string>::iterator subdir = runSubdirs.begin (); ok && subdir != runSubdirs.end (); subdir++)
+        {
+          ok = MakeDirectories (run->directory + "/" + *subdir);
+        }
+
+      if (!ok)
+        {
+          cerr << "ERROR: cannot create directory " << run->directory << ": " << strerror (errno) << endl;
+          return 1;
+        }
+    }
+
+  cout << "Running " << runs.size () << " simulations, up to " << jobs << " at a time" << endl;
+
+  map<pid_t, size_t> running; // pid -> index in runs
+  size_t next = 0;
+  size_t finished = 0;
+  size_t failed = 0;
+  while (finished < runs.size ())
+    {
+      while (next < runs.size () && running.size () < jobs)
+        {
+          Run &run = runs[next];
+
+          vector<string> args;
+          for (size_t i = 0; i < dimensions.size (); i++)
+            {
+              args.push_back ("--" + dimensions[i].name + "=" + run.values[i]);
+            }
+          args.push_back ("--RngRun=" + boost::lexical_cast<string> (run.rngRun));
+          args.insert (args.end (), fixedArgs.begin (), fixedArgs.end ());
+
+          run.timeMs = NowMs ();
+          pid_t pid = StartRun (program, args, run);
+          if (pid < 0)
+            {
+              cerr << "ERROR: cannot start a new process: " << strerror (errno) << endl;
+              return 1;
+            }
+          running[pid] = next;
+          next ++;
+        }
+
+      int status = 0;
+      pid_t pid = waitpid (-1, &status, 0);
+      if (pid < 0)
+        {
+          if (errno == EINTR)
+            continue;
+
+          cerr << "ERROR: waitpid failed: " << strerror (errno) << endl;
+          return 1;
+        }
+
+      map<pid_t, size_t>::iterator child = running.find (pid);
+      if (child == running.end ())
+        continue;
+
+      Run &run = runs[child->second];
+      running.erase (child);
+      finished ++;
+
+      run.timeMs = NowMs () - run.timeMs;
+      run.status = WIFEXITED (status) ? WEXITSTATUS (status) : 128 + WTERMSIG (status);
+      if (run.status != 0)
+        failed ++;
+
+      cout << "[" << finished << "/" << runs.size () << "] " << run.directory
+           << (run.status == 0 ? " done" : " FAILED") << " in " << run.timeMs << " ms" << endl;
+    }
+
+  string manifestName = output + "/manifest.txt";
+  ofstream manifest (manifestName.c_str (), ios::trunc);
+  if (!manifest.is_open () || !manifest.good ())
+    {
+      cerr << "ERROR: cannot write " << manifestName << endl;
+      return 1;
+    }
+
+  manifest << "Run" << "\t"
+           << "RngRun" << "\t"
+           << "Directory" << "\t"
+           << "ExitStatus" << "\t"
+           << "TimeMs";
+  for (vector<Dimension>::iterator dimension = dimensions.begin (); dimension != dimensions.end (); dimension++)
+    {
+      manifest << "\t" << dimension->name;
+    }
+  manifest << "\n";
+
+  for (vector<Run>::iterator run = runs.begin (); run != runs.end (); run++)
+    {
+      manifest << run->id << "\t"
+               << run->rngRun << "\t"
+               << run->directory << "\t"
+               << run->status << "\t"
+               << run->timeMs;
+      for (vector<string>::iterator value = run->values.begin (); value != run->values.end (); value++)
+        {
+          manifest << "\t" << *value;
+        }
+      manifest << "\n";
+    }
+
+  if (failed > 0)
+    {
+      cerr << failed << " of " << runs.size () << " simulations failed, see stderr.txt in their run directories" << endl;
+      return 1;
+    }
+
+  return 0;
+}
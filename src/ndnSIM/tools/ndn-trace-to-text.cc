@@ -0,0 +1,86 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Conversion of binary traces (written by tracers when trace file name ends with .bin or
+// .bin.gz) to the tab-separated text traces
+//
+//     ./waf --run="ndn-trace-to-text --input=aggregate-trace.bin.gz --output=aggregate-trace.txt"
+//
+// Output has exactly the same layout as the text output of the corresponding tracer.
+
+#include "ns3/core-module.h"
+#include "ns3/ndn-binary-trace.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+int
+main (int argc, char *argv[])
+{
+  string input;
+  string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary trace file (.bin or .bin.gz)", input);
+  cmd.AddValue ("output", "Text trace file (if -, then standard output is used)", output);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      cerr << "ERROR: input file needs to be specified" << endl;
+      cerr << endl;
+      cmd.PrintHelp (cerr);
+      return 1;
+    }
+
+  ndn::BinaryTraceReader reader (input);
+  if (!reader.IsOpen ())
+    {
+      cerr << "ERROR: " << input << " cannot be opened or is not a binary trace file" << endl;
+      return 1;
+    }
+
+  bool ok;
+  if (output != "-")
+    {
+      ofstream os (output.c_str (), ios_base::out | ios_base::trunc);
+      if (!os.is_open ())
+        {
+          cerr << "ERROR: " << output << " cannot be opened for writing" << endl;
+          return 1;
+        }
+      ok = reader.PrintText (os);
+    }
+  else
+    {
+      ok = reader.PrintText (cout);
+    }
+
+  if (!ok)
+    {
+      cerr << "ERROR: " << input << " is truncated or corrupted" << endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of PIT-like create/erase cycles in trie_with_policy with different node allocators
+//
+//     ./waf --run="ndn-trie-allocator-benchmark --cycles=1000000 --catalog=10000 --window=1000"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/random-variable.h"
+
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.h"
+#include "ns3/ndnSIM/utils/trie/persistent-policy.h"
+#include "ns3/ndnSIM/utils/trie/free-list-allocator.h"
+
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace ns3;
+using namespace std;
+
+static uint64_t g_allocations = 0;
+
+void *
+operator new (size_t size)
+{
+  g_allocations ++;
+  void *ptr = malloc (size);
+  if (ptr == 0)
+    throw std::bad_alloc ();
+  return ptr;
+}
+
+void
+operator delete (void *ptr) throw ()
+{
+  free (ptr);
+}
+
+class Payload : public SimpleRefCount<Payload>
+{
+};
+
+template<class AllocatorTraits>
+void
+RunBenchmark (const std::string &label,
+              const std::vector<ndn::Name> &names, const std::vector<uint32_t> &requests, uint32_t window)
+{
+  typedef ndn::ndnSIM::trie_with_policy<ndn::Name,
+                                        ndn::ndnSIM::smart_pointer_payload_traits<Payload>,
+                                        ndn::ndnSIM::persistent_policy_traits,
+                                        AllocatorTraits> pit_trie;
+
+  Ptr<Payload> payload = Create<Payload> ();
+  pit_trie pit;
+  pit.getPolicy ().set_max_size (0);
+
+  std::deque<typename pit_trie::iterator> outstanding;
+
+  uint64_t allocations = g_allocations;
+  SystemWallClockMs timer;
+  timer.Start ();
+
+  for (std::vector<uint32_t>::const_iterator request = requests.begin (); request != requests.end (); request++)
+    {
+      std::pair<typename pit_trie::iterator, bool> item = pit.insert (names[*request], payload);
+      if (item.second)
+        outstanding.push_back (item.first);
+
+      if (outstanding.size () > window)
+        {
+          pit.erase (outstanding.front ());
+          outstanding.pop_front ();
+        }
+    }
+  while (!outstanding.empty ())
+    {
+      pit.erase (outstanding.front ());
+      outstanding.pop_front ();
+    }
+
+  int64_t elapsed = timer.End ();
+  allocations = g_allocations - allocations;
+
+  std::cout << label << "\t"
+            << requests.size () << "\t"
+            << allocations << "\t"
+            << static_cast<double> (allocations) / requests.size () << "\t"
+            << elapsed << "\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t cycles = 1000000;
+  uint32_t catalog = 10000;
+  uint32_t window = 1000;
+  double alpha = 0.7;
+
+  CommandLine cmd;
+  cmd.AddValue ("cycles", "Number of PIT create attempts", cycles);
+  cmd.AddValue ("catalog", "Number of distinct names", catalog);
+  cmd.AddValue ("window", "Maximum number of simultaneously pending entries", window);
+  cmd.AddValue ("alpha", "Zipf parameter for name popularity", alpha);
+  cmd.Parse (argc, argv);
+
+  std::vector<ndn::Name> names (catalog);
+  for (uint32_t i = 0; i < catalog; i++)
+    {
+      names[i].append ("prefix").appendSeqNum (i);
+    }
+
+  // Zipf-distributed request sequence (same for all allocators)
+  std::vector<double> cdf (catalog);
+  double sum = 0;
+  for (uint32_t i = 0; i < catalog; i++)
+    {
+      sum += 1.0 / std::pow (static_cast<double> (i + 1), alpha);
+      cdf[i] = sum;
+    }
+
+  UniformVariable rand (0, sum);
+  std::vector<uint32_t> requests (cycles);
+  for (uint32_t i = 0; i < cycles; i++)
+    {
+      requests[i] = std::min<uint32_t> (std::lower_bound (cdf.begin (), cdf.end (), rand.GetValue ()) - cdf.begin (),
+                                        catalog - 1);
+    }
+
+  std::cout << "Allocator" << "\t"
+            << "Cycles" << "\t"
+            << "Allocations" << "\t"
+            << "AllocationsPerCycle" << "\t"
+            << "TimeMs" << "\n";
+
+  RunBenchmark<ndn::ndnSIM::heap_allocator_traits> ("Heap", names, requests, window);
+  RunBenchmark<ndn::ndnSIM::free_list_allocator_traits> ("FreeList", names, requests, window);
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+// Benchmark of content index samplers in ConsumerZipfMandelbrot for different catalog sizes
+//
+//     ./waf --run="ndn-zipf-sampler-benchmark --draws=1000000 --maxContents=10000000"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.h"
+
+using namespace ns3;
+using namespace std;
+
+void
+RunBenchmark (const std::string &sampler, uint32_t contents, uint32_t draws)
+{
+  Ptr<ndn::ConsumerZipfMandelbrot> consumer = CreateObject<ndn::ConsumerZipfMandelbrot> ();
+  consumer->SetAttribute ("NumberOfContents", UintegerValue (contents));
+  consumer->SetAttribute ("Sampler", StringValue (sampler));
+
+  SystemWallClockMs timer;
+  timer.Start ();
+  consumer->GetNextSeq (); // builds sampler tables
+  int64_t buildTime = timer.End ();
+
+  uint64_t checksum = 0;
+  timer.Start ();
+  for (uint32_t i = 0; i < draws; i++)
+    {
+      checksum += consumer->GetNextSeq ();
+    }
+  int64_t drawTime = timer.End ();
+
+  std::cout << sampler << "\t"
+            << contents << "\t"
+            << draws << "\t"
+            << buildTime << "\t"
+            << drawTime << "\t"
+            << (drawTime > 0 ? static_cast<double> (draws) * 1000 / drawTime : 0) << "\t"
+            << static_cast<double> (checksum) / draws << "\n";
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t draws = 1000000;
+  uint32_t maxContents = 10000000;
+  uint32_t maxLinearContents = 100000;
+
+  CommandLine cmd;
+  cmd.AddValue ("draws", "Number of draws for each sampler and catalog size", draws);
+  cmd.AddValue ("maxContents", "Largest catalog size (catalog sizes are powers of 10, starting from 100)", maxContents);
+  cmd.AddValue ("maxLinearContents", "Largest catalog size for the linear sampler (it is too slow for large catalogs)", maxLinearContents);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Sampler" << "\t"
+            << "Contents" << "\t"
+            << "Draws" << "\t"
+            << "BuildTimeMs" << "\t"
+            << "DrawTimeMs" << "\t"
+            << "DrawsPerSecond" << "\t"
+            << "MeanIndex" << "\n";
+
+  for (uint64_t contents = 100; contents <= maxContents; contents *= 10)
+    {
+      if (contents <= maxLinearContents)
+        RunBenchmark ("Linear", contents, draws);
+      RunBenchmark ("BinarySearch", contents, draws);
+      RunBenchmark ("Alias", contents, draws);
+    }
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-limits-lazy-rate.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.Limits.LazyRate");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (LimitsLazyRate);
+
+TypeId
+LimitsLazyRate::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::Limits::LazyRate")
+    .SetGroupName ("Ndn")
+    .SetParent <Limits> ()
+    .AddConstructor <LimitsLazyRate> ()
+    ;
+  return tid;
+}
+
+LimitsLazyRate::LimitsLazyRate ()
+  : m_bucketMax (0)
+  , m_bucketLeak (1)
+  , m_bucket (0)
+{
+}
+
+void
+LimitsLazyRate::DoDispose ()
+{
+  m_slotEvent.Cancel ();
+
+  super::DoDispose ();
+}
+
+void
+LimitsLazyRate::SetLimits (double rate, double delay)
+{
+  LeakBucket ();
+
+  super::SetLimits (rate, delay);
+
+  // maximum allowed burst
+  m_bucketMax = GetMaxRate () * GetMaxDelay ();
+
+  // amount of packets allowed every second (leak rate)
+  m_bucketLeak = GetMaxRate ();
+
+  ScheduleSlotNotification ();
+}
+
+void
+LimitsLazyRate::UpdateCurrentLimit (double limit)
+{
+  NS_ASSERT_MSG (limit >= 0.0, "Limit should be greater or equal to zero");
+
+  // leak with the old rate up to now
+  LeakBucket ();
+
+  m_bucketLeak = std::min (limit, GetMaxRate ());
+  m_bucketMax  = m_bucketLeak * GetMaxDelay ();
+
+  ScheduleSlotNotification ();
+}
+
+bool
+LimitsLazyRate::IsBelowLimit ()
+{
+  if (!IsEnabled ()) return true;
+
+  LeakBucket ();
+  return (m_bucketMax - m_bucket >= 1.0);
+}
+
+void
+LimitsLazyRate::BorrowLimit ()
+{
+  if (!IsEnabled ()) return;
+
+  LeakBucket ();
+
+  NS_ASSERT_MSG (m_bucketMax - m_bucket >= 1.0, "Should not be possible, unless we IsBelowLimit was not checked correctly");
+  m_bucket += 1;
+
+  ScheduleSlotNotification ();
+}
+
+void
+LimitsLazyRate::ReturnLimit ()
+{
+  // do nothing
+}
+
+void
+LimitsLazyRate::LeakBucket ()
+{
+  Time now = Simulator::Now ();
+  if (now == m_lastLeak)
+    return;
+
+  m_bucket = std::max (0.0, m_bucket - m_bucketLeak * (now - m_lastLeak).ToDouble (Time::S));
+  m_lastLeak = now;
+}
+
+void
+LimitsLazyRate::ScheduleSlotNotification ()
+{
+  m_slotEvent.Cancel ();
+
+  if (m_bucketMax < 1.0 || m_bucketLeak <= 0)
+    return; // no slot even in the empty bucket, or bucket will never leak (notification will be scheduled when rate is updated)
+
+  double deficit = m_bucket - (m_bucketMax - 1.0);
+  if (deficit <= 0)
+    return; // bucket is not full
+
+  // round up, so the bucket is leaked enough by the time of the event
+  Time delay = NanoSeconds (static_cast<int64_t> (std::ceil (deficit / m_bucketLeak * 1e9)));
+  m_slotEvent = Simulator::Schedule (delay, &LimitsLazyRate::NotifySlotAvailable, this);
+}
+
+void
+LimitsLazyRate::NotifySlotAvailable ()
+{
+  LeakBucket ();
+
+  if (m_bucketMax - m_bucket >= 1.0)
+    {
+      this->FireAvailableSlotCallback ();
+    }
+  else
+    {
+      // rounding errors
+      ScheduleSlotNotification ();
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
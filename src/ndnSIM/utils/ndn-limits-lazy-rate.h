@@ -0,0 +1,142 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_LIMITS_LAZY_RATE_H_
+#define	_NDN_LIMITS_LAZY_RATE_H_
+
+#include "ndn-limits.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-fw
+ * \brief Structure to manage limits for outstanding interests, using token bucket that is
+ *        leaked on demand
+ *
+ * Semantics is the same as for LimitsRate, but instead of periodic leakage events, the
+ * bucket is leaked according to the simulation time elapsed since the last access (in
+ * IsBelowLimit, BorrowLimit, and UpdateCurrentLimit).  An event is scheduled only when
+ * the bucket becomes full, to notify about the next available slot.  Nothing is scheduled
+ * while the face is idle.
+ */
+class LimitsLazyRate :
+    public Limits
+{
+public:
+  typedef Limits super;
+
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * \brief Constructor
+   */
+  LimitsLazyRate ();
+
+  virtual
+  ~LimitsLazyRate () { }
+
+  virtual void
+  SetLimits (double rate, double delay);
+
+  virtual
+  double
+  GetMaxLimit () const
+  {
+    return GetMaxRate ();
+  }
+
+  /**
+   * @brief Check if Interest limit is reached (token bucket is not empty)
+   */
+  virtual bool
+  IsBelowLimit ();
+
+  /**
+   * @brief Get token from the bucket
+   */
+  virtual void
+  BorrowLimit ();
+
+  /**
+   * @brief Does nothing (token bucket leakage is time-dependent only)
+   */
+  virtual void
+  ReturnLimit ();
+
+  /**
+   * @brief Update normalized amount that should be leaked every second (token bucket leak rate) and leak rate
+   */
+  virtual void
+  UpdateCurrentLimit (double limit);
+
+  /**
+   * @brief Get normalized amount that should be leaked every second (token bucket leak rate)
+   */
+  virtual double
+  GetCurrentLimit () const
+  {
+    return m_bucketLeak;
+  }
+
+  virtual double
+  GetCurrentLimitRate () const
+  {
+    return m_bucketLeak;
+  }
+
+protected:
+  // from Object
+  virtual void
+  DoDispose ();
+
+private:
+  /**
+   * @brief Leak bucket by the amount accumulated since the last leakage
+   */
+  void
+  LeakBucket ();
+
+  /**
+   * @brief Schedule notification about the next available slot, if bucket is full
+   */
+  void
+  ScheduleSlotNotification ();
+
+  void
+  NotifySlotAvailable ();
+
+private:
+  double m_bucketMax;   ///< \brief Maximum Interest allowance for this face (maximum tokens that can be issued at the same time)
+  double m_bucketLeak;  ///< \brief Normalized amount that should be leaked every second (token bucket leak rate)
+  double m_bucket;      ///< \brief Value representing current size of the Interest allowance for this face (current size of token bucket)
+
+  Time m_lastLeak;      ///< \brief Time when the bucket was last leaked
+  EventId m_slotEvent;  ///< \brief Notification about the next available slot (only when the bucket is full)
+};
+
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_LIMITS_LAZY_RATE_H_
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-mpi-partition.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+bool
+MpiPartition::IsLocal (Ptr<Node> node)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled () &&
+      node->GetSystemId () != MpiInterface::GetSystemId ())
+    {
+      return false;
+    }
+#endif
+
+  return true;
+}
+
+std::string
+MpiPartition::GetFileName (const std::string &file)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled () && file != "-")
+    {
+      // extension starts at the first dot of the file name (e.g., ".bin.gz"), not counting directories
+      std::string::size_type nameStart = file.rfind ('/');
+      nameStart = (nameStart == std::string::npos) ? 0 : nameStart + 1;
+      std::string::size_type extension = file.find ('.', nameStart + 1);
+      if (extension == std::string::npos)
+        extension = file.size ();
+
+      std::ostringstream os;
+      os << file.substr (0, extension) << "-rank" << MpiInterface::GetSystemId () << file.substr (extension);
+      return os.str ();
+    }
+#endif
+
+  return file;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_MPI_PARTITION_H
+#define NDN_MPI_PARTITION_H
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to run scenarios using the distributed (MPI) simulator
+ *
+ * When MPI is enabled (MpiInterface::Enable), every rank (logical process) creates the whole
+ * topology, but simulates only nodes, which system id is the same as the rank (system id can
+ * be assigned when node is created or specified in the topology file for AnnotatedTopologyReader).
+ * Applications (AppHelper), FIBs (GlobalRoutingHelper), and tracers are installed only on such
+ * local nodes.
+ *
+ * If ndnSIM is compiled without MPI support or MPI is not enabled, all nodes are local.
+ */
+class MpiPartition
+{
+public:
+  /**
+   * @brief Check if node is simulated by the current rank
+   */
+  static bool
+  IsLocal (Ptr<Node> node);
+
+  /**
+   * @brief Get name of the trace file for the current rank
+   *
+   * If MPI is enabled, "-rank<N>" suffix is inserted before extension of the file (e.g.,
+   * "rate-trace.txt" becomes "rate-trace-rank1.txt" on rank 1).  Otherwise, and for "-"
+   * (standard output), the name is returned unchanged.
+   */
+  static std::string
+  GetFileName (const std::string &file);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MPI_PARTITION_H
@@ -0,0 +1,276 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-request-table.h"
+
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t RequestTable::NONE;
+
+static const uint32_t INITIAL_BITS = 4;
+
+RequestTable::RequestTable ()
+  : m_freeRecords (NONE)
+  , m_size (0)
+{
+  Clear ();
+}
+
+uint32_t
+RequestTable::Find (uint32_t seq) const
+{
+  uint32_t slot = FindSlot (seq);
+  return m_slots[slot].head;
+}
+
+uint32_t
+RequestTable::Insert (uint32_t seq)
+{
+  uint32_t request;
+  if (m_freeRecords != NONE)
+    {
+      request = m_freeRecords;
+      m_freeRecords = m_records[request].next;
+    }
+  else
+    {
+      request = m_records.size ();
+      m_records.push_back (Request ());
+    }
+
+  Request &record = m_records[request];
+  record.seq = seq;
+  record.firstSent = Time ();
+  record.lastSent = Time ();
+  record.sendCount = 0;
+  record.nextSameSeq = NONE;
+  record.prev = NONE;
+  record.next = NONE;
+  record.queue = QUEUE_NONE;
+  m_size ++;
+
+  uint32_t slot = FindSlot (seq);
+  if (m_slots[slot].head != NONE)
+    {
+      // append to the list of requests with the same sequence number
+      uint32_t last = m_slots[slot].head;
+      while (m_records[last].nextSameSeq != NONE)
+        last = m_records[last].nextSameSeq;
+      m_records[last].nextSameSeq = request;
+      return request;
+    }
+
+  if (2 * (m_usedSlots + 1) > m_slots.size ())
+    {
+      Rehash (m_bits + 1);
+      slot = FindSlot (seq);
+    }
+
+  m_slots[slot].seq = seq;
+  m_slots[slot].head = request;
+  m_usedSlots ++;
+
+  return request;
+}
+
+void
+RequestTable::Erase (uint32_t request)
+{
+  Unqueue (request);
+
+  Request &record = m_records[request];
+  uint32_t slot = FindSlot (record.seq);
+  NS_ASSERT (m_slots[slot].head != NONE);
+
+  if (m_slots[slot].head == request)
+    {
+      m_slots[slot].head = record.nextSameSeq;
+      if (m_slots[slot].head == NONE)
+        EraseSlot (slot);
+    }
+  else
+    {
+      uint32_t previous = m_slots[slot].head;
+      while (m_records[previous].nextSameSeq != request)
+        previous = m_records[previous].nextSameSeq;
+      m_records[previous].nextSameSeq = record.nextSameSeq;
+    }
+
+  record.next = m_freeRecords;
+  m_freeRecords = request;
+  m_size --;
+}
+
+void
+RequestTable::Clear ()
+{
+  m_records.clear ();
+  m_freeRecords = NONE;
+  m_size = 0;
+
+  m_bits = INITIAL_BITS;
+  Slot empty = { 0, NONE };
+  m_slots.assign (1 << m_bits, empty);
+  m_usedSlots = 0;
+
+  for (uint32_t queue = 0; queue < 3; queue++)
+    {
+      m_queues[queue].head = NONE;
+      m_queues[queue].tail = NONE;
+    }
+}
+
+void
+RequestTable::Sent (uint32_t request, const Time &now)
+{
+  Request &record = m_records[request];
+  if (record.sendCount == 0)
+    record.firstSent = now;
+  record.lastSent = now;
+  record.sendCount ++;
+
+  Unqueue (request);
+
+  // transmission times do not decrease, so the queue stays ordered by lastSent
+  Queue &queue = m_queues[QUEUE_TIMEOUT];
+  record.queue = QUEUE_TIMEOUT;
+  record.prev = queue.tail;
+  record.next = NONE;
+  if (queue.tail != NONE)
+    m_records[queue.tail].next = request;
+  else
+    queue.head = request;
+  queue.tail = request;
+}
+
+void
+RequestTable::ScheduleRetx (uint32_t request)
+{
+  Request &record = m_records[request];
+  if (record.queue == QUEUE_RETX)
+    return;
+
+  Unqueue (request);
+
+  // find position from the end, as new requests usually have the largest sequence numbers
+  Queue &queue = m_queues[QUEUE_RETX];
+  uint32_t previous = queue.tail;
+  while (previous != NONE && m_records[previous].seq > record.seq)
+    previous = m_records[previous].prev;
+
+  record.queue = QUEUE_RETX;
+  record.prev = previous;
+  if (previous != NONE)
+    {
+      record.next = m_records[previous].next;
+      m_records[previous].next = request;
+    }
+  else
+    {
+      record.next = queue.head;
+      queue.head = request;
+    }
+
+  if (record.next != NONE)
+    m_records[record.next].prev = request;
+  else
+    queue.tail = request;
+}
+
+void
+RequestTable::Unqueue (uint32_t request)
+{
+  Request &record = m_records[request];
+  if (record.queue == QUEUE_NONE)
+    return;
+
+  Queue &queue = m_queues[record.queue];
+  if (record.prev != NONE)
+    m_records[record.prev].next = record.next;
+  else
+    queue.head = record.next;
+
+  if (record.next != NONE)
+    m_records[record.next].prev = record.prev;
+  else
+    queue.tail = record.prev;
+
+  record.queue = QUEUE_NONE;
+  record.prev = NONE;
+  record.next = NONE;
+}
+
+uint32_t
+RequestTable::FindSlot (uint32_t seq) const
+{
+  uint32_t mask = m_slots.size () - 1;
+  uint32_t slot = GetHome (seq);
+  while (m_slots[slot].head != NONE && m_slots[slot].seq != seq)
+    slot = (slot + 1) & mask;
+  return slot;
+}
+
+void
+RequestTable::EraseSlot (uint32_t slot)
+{
+  // backward shift deletion: move up entries that cannot be found after the slot becomes empty
+  uint32_t mask = m_slots.size () - 1;
+  uint32_t next = slot;
+  while (true)
+    {
+      next = (next + 1) & mask;
+      if (m_slots[next].head == NONE)
+        break;
+
+      uint32_t home = GetHome (m_slots[next].seq);
+      bool between = (slot <= next) ? (slot < home && home <= next) : (slot < home || home <= next);
+      if (!between)
+        {
+          m_slots[slot] = m_slots[next];
+          slot = next;
+        }
+    }
+
+  m_slots[slot].head = NONE;
+  m_usedSlots --;
+}
+
+void
+RequestTable::Rehash (uint32_t bits)
+{
+  std::vector<Slot> slots;
+  slots.swap (m_slots);
+
+  m_bits = bits;
+  Slot empty = { 0, NONE };
+  m_slots.assign (1 << m_bits, empty);
+
+  for (std::vector<Slot>::const_iterator item = slots.begin (); item != slots.end (); item++)
+    {
+      if (item->head != NONE)
+        m_slots[FindSlot (item->seq)] = *item;
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
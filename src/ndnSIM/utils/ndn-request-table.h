@@ -0,0 +1,225 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_REQUEST_TABLE_H
+#define NDN_REQUEST_TABLE_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Table of outstanding requests of a consumer application
+ *
+ * Each request (Interest that has been sent and may be retransmitted until Data is received)
+ * has one record, identified by request id.  Records are kept in a pool (ids are reused after
+ * records are erased) and indexed by sequence number in a flat open-addressing hash table.
+ * Several records may have the same sequence number (e.g., when ConsumerZipfMandelbrot requests
+ * the same content again before the previous request is satisfied).
+ *
+ * Records can be placed in one of two intrusive queues: timeout queue (in the order of the last
+ * transmission, which is also the order of timeouts) and retransmission queue (ordered by
+ * sequence number).  All operations, except placing a record into the retransmission queue,
+ * take constant time.
+ */
+class RequestTable
+{
+public:
+  /**
+   * @brief Invalid request id
+   */
+  static const uint32_t NONE = 0xFFFFFFFF;
+
+  /**
+   * @brief Queue, in which the request is
+   */
+  enum QueueType
+    {
+      QUEUE_NONE,
+      QUEUE_TIMEOUT,
+      QUEUE_RETX
+    };
+
+  /**
+   * @brief Record of the outstanding request
+   */
+  struct Request
+  {
+    uint32_t seq;        ///< @brief sequence number
+    Time firstSent;      ///< @brief time when Interest has been sent for the first time
+    Time lastSent;       ///< @brief time when Interest has been sent for the last time
+    uint32_t sendCount;  ///< @brief number of times Interest has been sent
+    uint32_t nextSameSeq; ///< @brief next request with the same sequence number (or NONE)
+
+  private:
+    friend class RequestTable;
+    uint32_t prev;
+    uint32_t next; // also links free records
+    uint8_t queue;
+  };
+
+  RequestTable ();
+
+  /**
+   * @brief Get the first (oldest) request with the sequence number (NONE if there is no such request)
+   *
+   * Other requests with the same sequence number can be iterated using Request::nextSameSeq
+   */
+  uint32_t
+  Find (uint32_t seq) const;
+
+  /**
+   * @brief Create a new record (Interest is not yet sent) and return its request id
+   */
+  uint32_t
+  Insert (uint32_t seq);
+
+  /**
+   * @brief Remove the record from the table and queues
+   */
+  void
+  Erase (uint32_t request);
+
+  /**
+   * @brief Remove all records
+   */
+  void
+  Clear ();
+
+  /**
+   * @brief Get record of the request
+   */
+  inline Request &
+  Get (uint32_t request)
+  {
+    return m_records[request];
+  }
+
+  inline const Request &
+  Get (uint32_t request) const
+  {
+    return m_records[request];
+  }
+
+  /**
+   * @brief Get number of records
+   */
+  inline size_t
+  GetSize () const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Record transmission of Interest for the request and place it at the end of the timeout queue
+   *
+   * If the request is already in the timeout queue, it is moved to the end, so the queue stays ordered by lastSent
+   */
+  void
+  Sent (uint32_t request, const Time &now);
+
+  /**
+   * @brief Get queue, in which the request is
+   */
+  inline QueueType
+  GetQueue (uint32_t request) const
+  {
+    return static_cast<QueueType> (m_records[request].queue);
+  }
+
+  /**
+   * @brief Get the first request in the timeout queue (NONE if the queue is empty)
+   */
+  inline uint32_t
+  GetTimeoutFront () const
+  {
+    return m_queues[QUEUE_TIMEOUT].head;
+  }
+
+  /**
+   * @brief Get request with the smallest sequence number in the retransmission queue
+   *        (NONE if the queue is empty)
+   */
+  inline uint32_t
+  GetRetxFront () const
+  {
+    return m_queues[QUEUE_RETX].head;
+  }
+
+  /**
+   * @brief Move the request to the retransmission queue (from the timeout queue, if it is there)
+   */
+  void
+  ScheduleRetx (uint32_t request);
+
+  /**
+   * @brief Remove the request from the queue, in which it is
+   */
+  void
+  Unqueue (uint32_t request);
+
+private:
+  uint32_t
+  FindSlot (uint32_t seq) const;
+
+  void
+  EraseSlot (uint32_t slot);
+
+  void
+  Rehash (uint32_t bits);
+
+  inline uint32_t
+  GetHome (uint32_t seq) const
+  {
+    return (seq * 0x9E3779B1u) >> (32 - m_bits);
+  }
+
+private:
+  struct Slot
+  {
+    uint32_t seq;
+    uint32_t head; // first request with the sequence number, NONE for an empty slot
+  };
+
+  struct Queue
+  {
+    uint32_t head;
+    uint32_t tail;
+  };
+
+  std::vector<Request> m_records;
+  uint32_t m_freeRecords; // list of free records, linked through Request::next
+  size_t m_size;
+
+  std::vector<Slot> m_slots; // power of two, at most half full
+  uint32_t m_bits;
+  size_t m_usedSlots;
+
+  Queue m_queues[3]; // indexed by QueueType (QUEUE_NONE is not used)
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TABLE_H
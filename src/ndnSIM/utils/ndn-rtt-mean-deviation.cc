@@ -70,6 +70,7 @@ RttMeanDeviation::RttMeanDeviation() :
 
 RttMeanDeviation::RttMeanDeviation (const RttMeanDeviation& c)
   : RttEstimator (c), m_gain (c.m_gain), m_gain2 (c.m_gain2), m_variance (c.m_variance)
+  , m_sentHistory (c.m_sentHistory)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -127,6 +128,7 @@ void RttMeanDeviation::Reset ()
   NS_LOG_FUNCTION (this);
   // Reset to initial state
   m_variance = Seconds (0);
+  m_sentHistory.clear ();
   RttEstimator::Reset ();
 }
 
@@ -138,50 +140,45 @@ void RttMeanDeviation::Gain (double g)
 }
 
 void RttMeanDeviation::SentSeq (SequenceNumber32 seq, uint32_t size)
-{ 
+{
   NS_LOG_FUNCTION (this << seq << size);
 
-  RttHistory_t::iterator i;
-  for (i = m_history.begin (); i != m_history.end (); ++i)
-  {
-      if (seq == i->seq)
-      { // Found it
-          i->retx = true;
-          break;
-      }
-  }
-
   // Note that a particular sequence has been sent
-  if (i == m_history.end())
-      m_history.push_back (RttHistory (seq, size, Simulator::Now () ));
+  std::pair<SentHistory::iterator, bool> sent =
+    m_sentHistory.insert (SentHistory::value_type (seq.GetValue (), RttHistory (seq, size, Simulator::Now ())));
+
+  if (!sent.second)
+    { // This is a retransmit, its RTT sample is ambiguous
+      sent.first->second.retx = true;
+    }
 }
 
 Time RttMeanDeviation::AckSeq (SequenceNumber32 ackSeq)
 {
   NS_LOG_FUNCTION (this << ackSeq);
   // An ack has been received, calculate rtt and log this measurement
-  // Note we use a linear search (O(n)) for this since for the common
-  // case the ack'ed packet will be at the head of the list
   Time m = Seconds (0.0);
-  if (m_history.size () == 0) return (m);    // No pending history, just exit
-
-  for (RttHistory_t::iterator i = m_history.begin (); i != m_history.end (); ++i)
-  {
-      if (ackSeq == i->seq)
-      { // Found it
-          if (!i->retx) {
-              m = Simulator::Now () - i->time;// Elapsed time
-              Measurement (m);                // Log the measurement
-              ResetMultiplier ();             // Reset multiplier on valid measurement
-          }
-          m_history.erase(i);
-          break;
-      }
-  }
+
+  SentHistory::iterator i = m_sentHistory.find (ackSeq.GetValue ());
+  if (i == m_sentHistory.end ()) return (m); // No pending history, just exit
+
+  if (!i->second.retx)
+    { // Ok to use this sample
+      m = Simulator::Now () - i->second.time; // Elapsed time
+      Measurement (m);                        // Log the measurement
+      ResetMultiplier ();                     // Reset multiplier on valid measurement
+    }
+  m_sentHistory.erase (i);
 
   return m;
 }
 
+void RttMeanDeviation::ClearSent ()
+{
+  NS_LOG_FUNCTION (this);
+  m_sentHistory.clear ();
+  RttEstimator::ClearSent ();
+}
+
 } // namespace ndn
 } // namespace ns3
-
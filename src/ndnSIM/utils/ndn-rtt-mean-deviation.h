@@ -31,6 +31,8 @@
 
 #include <ns3/ndnSIM/utils/ndn-rtt-estimator.h>
 
+#include <boost/unordered_map.hpp>
+
 namespace ns3 {
 namespace ndn {
 
@@ -43,6 +45,11 @@ namespace ndn {
  * by Van Jacobson and Michael J. Karels, in
  * "Congestion Avoidance and Control", SIGCOMM 88, Appendix A
  *
+ * Unlike TCP, NDN Data packets do not acknowledge all previous sequence numbers, and sequence
+ * numbers may be requested in any order (e.g., by ConsumerZipfMandelbrot).  Therefore, each
+ * AckSeq acknowledges exactly one sequence number.  Outstanding samples are kept in a hash
+ * table indexed by sequence number, so SentSeq and AckSeq take constant time.  Samples of
+ * retransmitted sequence numbers are ignored (Karn's algorithm).
  */
 class RttMeanDeviation : public RttEstimator {
 public:
@@ -55,6 +62,7 @@ public:
 
   void SentSeq (SequenceNumber32 seq, uint32_t size);
   Time AckSeq (SequenceNumber32 ackSeq);
+  void ClearSent ();
   void Measurement (Time measure);
   Time RetransmitTimeout ();
   Ptr<RttEstimator> Copy () const;
@@ -65,6 +73,9 @@ private:
   double       m_gain;       // Filter gain
   double       m_gain2;      // Filter gain
   Time         m_variance;   // Current variance
+
+  typedef boost::unordered_map<uint32_t, RttHistory> SentHistory;
+  SentHistory  m_sentHistory; // Outstanding samples, indexed by sequence number
 };
 
 } // namespace ndn
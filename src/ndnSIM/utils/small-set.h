@@ -0,0 +1,235 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_SMALL_SET_H_
+#define NDNSIM_SMALL_SET_H_
+
+#include <new>
+#include <utility>
+#include <functional>
+#include <cstddef>
+
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Sorted set container optimized for a small number of elements
+ *
+ * Interface is a subset of std::set.  Elements are kept sorted in a contiguous array,
+ * the first InlineSize of which are stored inside the container object itself, so sets
+ * with up to InlineSize elements do not use heap at all.  All lookups are linear scans.
+ *
+ * Unlike std::set, insert and erase operations invalidate iterators to the other elements.
+ */
+template<class T, size_t InlineSize, class Compare = std::less<T> >
+class small_set
+{
+public:
+  typedef T value_type;
+  typedef T key_type;
+  typedef size_t size_type;
+  typedef const T* const_iterator;
+  typedef const T* iterator; ///< @brief same as in std::set, elements cannot be modified through iterators
+
+  small_set ()
+    : data_ (inline_data ())
+    , size_ (0)
+    , capacity_ (InlineSize)
+  {
+  }
+
+  small_set (const small_set &other)
+    : data_ (inline_data ())
+    , size_ (0)
+    , capacity_ (InlineSize)
+  {
+    reserve (other.size_);
+    for (const_iterator item = other.begin (); item != other.end (); item++)
+      {
+        new (data_ + size_) T (*item);
+        size_ ++;
+      }
+  }
+
+  ~small_set ()
+  {
+    clear ();
+    if (data_ != inline_data ())
+      ::operator delete (data_);
+  }
+
+  small_set &
+  operator = (const small_set &other)
+  {
+    if (this != &other)
+      {
+        clear ();
+        reserve (other.size_);
+        for (const_iterator item = other.begin (); item != other.end (); item++)
+          {
+            new (data_ + size_) T (*item);
+            size_ ++;
+          }
+      }
+    return *this;
+  }
+
+  inline iterator
+  begin () const { return data_; }
+
+  inline iterator
+  end () const { return data_ + size_; }
+
+  inline size_type
+  size () const { return size_; }
+
+  inline bool
+  empty () const { return size_ == 0; }
+
+  inline iterator
+  find (const key_type &key) const
+  {
+    size_type pos = lower_bound_pos (key);
+    if (pos < size_ && !compare_ (key, data_[pos]))
+      return data_ + pos;
+    else
+      return end ();
+  }
+
+  inline size_type
+  count (const key_type &key) const
+  {
+    return find (key) != end () ? 1 : 0;
+  }
+
+  std::pair<iterator, bool>
+  insert (const value_type &value)
+  {
+    size_type pos = lower_bound_pos (value);
+    if (pos < size_ && !compare_ (value, data_[pos]))
+      return std::make_pair (data_ + pos, false);
+
+    reserve (size_ + 1);
+    if (pos == size_)
+      {
+        new (data_ + size_) T (value);
+      }
+    else
+      {
+        // shift tail by one element
+        new (data_ + size_) T (data_[size_ - 1]);
+        for (size_type i = size_ - 1; i > pos; i--)
+          {
+            data_[i] = data_[i - 1];
+          }
+        data_[pos] = value;
+      }
+    size_ ++;
+
+    return std::make_pair (data_ + pos, true);
+  }
+
+  void
+  erase (iterator item)
+  {
+    size_type pos = item - data_;
+    for (size_type i = pos; i + 1 < size_; i++)
+      {
+        data_[i] = data_[i + 1];
+      }
+    size_ --;
+    data_[size_].~T ();
+  }
+
+  size_type
+  erase (const key_type &key)
+  {
+    iterator item = find (key);
+    if (item == end ())
+      return 0;
+
+    erase (item);
+    return 1;
+  }
+
+  void
+  clear ()
+  {
+    for (size_type i = 0; i < size_; i++)
+      {
+        data_[i].~T ();
+      }
+    size_ = 0;
+  }
+
+private:
+  inline T *
+  inline_data () { return reinterpret_cast<T*> (&inline_); }
+
+  inline size_type
+  lower_bound_pos (const key_type &key) const
+  {
+    size_type pos = 0;
+    while (pos < size_ && compare_ (data_[pos], key))
+      pos ++;
+    return pos;
+  }
+
+  void
+  reserve (size_type capacity)
+  {
+    if (capacity <= capacity_)
+      return;
+
+    size_type newCapacity = capacity_ * 2;
+    if (newCapacity < capacity)
+      newCapacity = capacity;
+
+    T *newData = static_cast<T*> (::operator new (newCapacity * sizeof (T)));
+    for (size_type i = 0; i < size_; i++)
+      {
+        new (newData + i) T (data_[i]);
+        data_[i].~T ();
+      }
+
+    if (data_ != inline_data ())
+      ::operator delete (data_);
+
+    data_ = newData;
+    capacity_ = newCapacity;
+  }
+
+private:
+  T *data_;
+  size_type size_;
+  size_type capacity_;
+  typename boost::aligned_storage<sizeof (T) * InlineSize, boost::alignment_of<T>::value>::type inline_;
+  Compare compare_;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // NDNSIM_SMALL_SET_H_
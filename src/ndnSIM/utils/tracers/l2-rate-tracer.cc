@@ -27,6 +27,7 @@
 #include "ns3/node-list.h"
 #include "ns3/node.h"
 #include "ns3/log.h"
+#include "ns3/ndn-mpi-partition.h"
 
 #include <boost/lexical_cast.hpp>
 #include <fstream>
@@ -55,16 +56,17 @@ L2RateTracer::Destroy ()
 void
 L2RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
+  std::string traceFile = ndn::MpiPartition::GetFileName (file);
   std::list<Ptr<L2RateTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
+  if (traceFile != "-")
     {
       boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      os->open (traceFile.c_str (), std::ios_base::out | std::ios_base::trunc);
 
       if (!os->is_open ())
         {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+          NS_LOG_ERROR ("File " << traceFile << " cannot be opened for writing. Tracing disabled");
           return;
         }
 
@@ -79,6 +81,9 @@ L2RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seco
        node != NodeList::End ();
        node++)
     {
+      if (!ndn::MpiPartition::IsLocal (*node))
+        continue;
+
       NS_LOG_DEBUG ("Node: " << lexical_cast<string> ((*node)->GetId ()));
 
       Ptr<L2RateTracer> trace = Create<L2RateTracer> (outputStream, *node);
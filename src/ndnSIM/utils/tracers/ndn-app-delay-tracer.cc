@@ -19,6 +19,7 @@
  */
 
 #include "ndn-app-delay-tracer.h"
+#include "ndn-binary-trace.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -31,11 +32,13 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/ndn-mpi-partition.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.AppDelayTracer");
 
@@ -46,12 +49,6 @@ namespace ndn {
 
 static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer> > > > g_tracers;
 
-template<class T>
-static inline void
-NullDeleter (T *ptr)
-{
-}
-
 void
 AppDelayTracer::Destroy ()
 {
@@ -64,39 +61,28 @@ AppDelayTracer::InstallAll (const std::string &file)
   using namespace boost;
   using namespace std;
 
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<AppDelayTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   for (NodeList::Iterator node = NodeList::Begin ();
        node != NodeList::End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<AppDelayTracer> trace = Install (*node, outputStream);
+      trace->m_writer = writer;
       tracers.push_back (trace);
     }
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -108,39 +94,28 @@ AppDelayTracer::Install (const NodeContainer &nodes, const std::string &file)
   using namespace boost;
   using namespace std;
 
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<AppDelayTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   for (NodeContainer::Iterator node = nodes.Begin ();
        node != nodes.End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<AppDelayTracer> trace = Install (*node, outputStream);
+      trace->m_writer = writer;
       tracers.push_back (trace);
     }
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -152,34 +127,23 @@ AppDelayTracer::Install (Ptr<Node> node, const std::string &file)
   using namespace boost;
   using namespace std;
 
+  if (!MpiPartition::IsLocal (node))
+    return; // node is simulated by another rank
+
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<AppDelayTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   Ptr<AppDelayTracer> trace = Install (node, outputStream);
+  trace->m_writer = writer;
   tracers.push_back (trace);
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -253,9 +217,43 @@ AppDelayTracer::PrintHeader (std::ostream &os) const
      << "HopCount"  << "";
 }
 
+void
+AppDelayTracer::PrintHeader (BinaryTraceWriter &writer) const
+{
+  writer.AddColumn ("Time",      BINARY_TRACE_DOUBLE);
+  writer.AddColumn ("Node",      BINARY_TRACE_STRING);
+  writer.AddColumn ("AppId",     BINARY_TRACE_UINT32);
+  writer.AddColumn ("SeqNo",     BINARY_TRACE_UINT32);
+
+  writer.AddColumn ("Type",      BINARY_TRACE_STRING);
+  writer.AddColumn ("DelayS",    BINARY_TRACE_DOUBLE);
+  writer.AddColumn ("DelayUS",   BINARY_TRACE_DOUBLE);
+  writer.AddColumn ("RetxCount", BINARY_TRACE_UINT32);
+  writer.AddColumn ("HopCount",  BINARY_TRACE_INT32);
+
+  std::ostringstream header;
+  PrintHeader (header);
+  writer.WriteHeader ("AppDelayTracer", header.str ());
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
 {
+  if (m_writer)
+    {
+      *m_writer << Simulator::Now ().ToDouble (Time::S)
+                << m_node
+                << app->GetId ()
+                << seqno
+                << "LastDelay"
+                << delay.ToDouble (Time::S)
+                << delay.ToDouble (Time::US)
+                << 1
+                << hopCount;
+      m_writer->EndRecord ();
+      return;
+    }
+
   *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
         << m_node << "\t"
         << app->GetId () << "\t"
@@ -270,6 +268,21 @@ AppDelayTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno
 void
 AppDelayTracer::FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount)
 {
+  if (m_writer)
+    {
+      *m_writer << Simulator::Now ().ToDouble (Time::S)
+                << m_node
+                << app->GetId ()
+                << seqno
+                << "FullDelay"
+                << delay.ToDouble (Time::S)
+                << delay.ToDouble (Time::US)
+                << retxCount
+                << hopCount;
+      m_writer->EndRecord ();
+      return;
+    }
+
   *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
         << m_node << "\t"
         << app->GetId () << "\t"
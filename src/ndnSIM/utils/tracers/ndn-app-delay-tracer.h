@@ -39,6 +39,7 @@ class Packet;
 namespace ndn {
 
 class App;
+class BinaryTraceWriter;
 
 /**
  * @ingroup ndn-tracers
@@ -134,6 +135,14 @@ public:
    */
   void
   PrintHeader (std::ostream &os) const;
+
+  /**
+   * @brief Define columns and write header of the binary trace
+   *
+   * @param writer reference to the binary trace writer
+   */
+  void
+  PrintHeader (BinaryTraceWriter &writer) const;
   
 private:
   void
@@ -150,6 +159,7 @@ private:
   Ptr<Node> m_nodePtr;
 
   boost::shared_ptr<std::ostream> m_os;
+  boost::shared_ptr<BinaryTraceWriter> m_writer; ///< @brief if set, records are written in binary format instead of m_os
 };
 
 } // namespace ndn
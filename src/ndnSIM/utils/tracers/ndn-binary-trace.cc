@@ -0,0 +1,524 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-binary-trace.h"
+
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef NS3_NDNSIM_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE ("ndn.BinaryTrace");
+
+namespace ns3 {
+namespace ndn {
+
+static const char BINARY_TRACE_MAGIC[8] = { 'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E' };
+static const uint32_t BINARY_TRACE_VERSION = 1;
+
+static const uint8_t BINARY_TRACE_CHUNK_STRING = 'S';
+static const uint8_t BINARY_TRACE_CHUNK_BLOCK  = 'B';
+
+static inline bool
+EndsWith (const std::string &value, const std::string &suffix)
+{
+  return value.size () >= suffix.size () &&
+    value.compare (value.size () - suffix.size (), suffix.size (), suffix) == 0;
+}
+
+template<class T>
+static inline void
+NullDeleter (T *ptr)
+{
+}
+
+static inline uint32_t
+ColumnWidth (BinaryTraceColumnType type)
+{
+  return type == BINARY_TRACE_DOUBLE ? sizeof (double) : sizeof (uint32_t);
+}
+
+bool
+BinaryTraceWriter::IsBinaryTraceFile (const std::string &file)
+{
+  return EndsWith (file, ".bin") || EndsWith (file, ".bin.gz");
+}
+
+bool
+BinaryTraceWriter::IsCompressionSupported ()
+{
+#ifdef NS3_NDNSIM_WITH_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+BinaryTraceWriter::BinaryTraceWriter (const std::string &file, uint32_t blockSize/* = 8192*/)
+  : m_file (0)
+  , m_compressed (EndsWith (file, ".gz"))
+  , m_blockSize (blockSize)
+  , m_records (0)
+  , m_column (0)
+{
+  if (m_compressed)
+    {
+#ifdef NS3_NDNSIM_WITH_ZLIB
+      m_file = gzopen (file.c_str (), "wb");
+#else
+      NS_LOG_ERROR ("ndnSIM is compiled without zlib, compressed trace " << file << " cannot be written");
+#endif
+    }
+  else
+    {
+      m_file = std::fopen (file.c_str (), "wb");
+    }
+}
+
+BinaryTraceWriter::~BinaryTraceWriter ()
+{
+  if (m_file == 0)
+    return;
+
+  Flush ();
+
+#ifdef NS3_NDNSIM_WITH_ZLIB
+  if (m_compressed)
+    {
+      gzclose (static_cast<gzFile> (m_file));
+      return;
+    }
+#endif
+  std::fclose (static_cast<FILE*> (m_file));
+}
+
+bool
+BinaryTraceWriter::IsOpen () const
+{
+  return m_file != 0;
+}
+
+void
+BinaryTraceWriter::Write (const void *buffer, uint32_t size)
+{
+  if (size == 0)
+    return;
+
+#ifdef NS3_NDNSIM_WITH_ZLIB
+  if (m_compressed)
+    {
+      gzwrite (static_cast<gzFile> (m_file), buffer, size);
+      return;
+    }
+#endif
+  std::fwrite (buffer, 1, size, static_cast<FILE*> (m_file));
+}
+
+void
+BinaryTraceWriter::WriteString (const std::string &value)
+{
+  uint32_t size = value.size ();
+  Write (&size, sizeof (size));
+  Write (value.c_str (), size);
+}
+
+void
+BinaryTraceWriter::AddColumn (const std::string &name, BinaryTraceColumnType type)
+{
+  NS_ASSERT_MSG (m_records == 0 && m_column == 0, "Columns should be added before any record");
+
+  m_names.push_back (name);
+  m_types.push_back (type);
+  m_columns.push_back (std::vector<char> ());
+  m_columns.back ().reserve (m_blockSize * ColumnWidth (type));
+}
+
+void
+BinaryTraceWriter::WriteHeader (const std::string &type, const std::string &textHeader)
+{
+  Write (BINARY_TRACE_MAGIC, sizeof (BINARY_TRACE_MAGIC));
+  Write (&BINARY_TRACE_VERSION, sizeof (BINARY_TRACE_VERSION));
+
+  WriteString (type);
+  WriteString (textHeader);
+
+  uint32_t columns = m_types.size ();
+  Write (&columns, sizeof (columns));
+  for (uint32_t i = 0; i < columns; i++)
+    {
+      uint8_t columnType = m_types[i];
+      Write (&columnType, sizeof (columnType));
+      WriteString (m_names[i]);
+    }
+}
+
+uint32_t
+BinaryTraceWriter::Intern (const std::string &value)
+{
+  std::map<std::string, uint32_t>::iterator item = m_dictionary.find (value);
+  if (item != m_dictionary.end ())
+    return item->second;
+
+  uint32_t id = m_dictionary.size ();
+  m_dictionary.insert (std::make_pair (value, id));
+  m_newStrings.push_back (value);
+  return id;
+}
+
+template<class T>
+void
+BinaryTraceWriter::Append (const T &value)
+{
+  std::vector<char> &column = m_columns[m_column];
+  column.insert (column.end (),
+                 reinterpret_cast<const char*> (&value),
+                 reinterpret_cast<const char*> (&value) + sizeof (value));
+  m_column ++;
+}
+
+#define APPEND_NUMBER(value)                                            \
+  NS_ASSERT_MSG (m_column < m_types.size (), "Too many values in the record"); \
+  switch (m_types[m_column])                                            \
+    {                                                                   \
+    case BINARY_TRACE_DOUBLE:                                           \
+      Append<double> (value);                                           \
+      break;                                                            \
+    case BINARY_TRACE_UINT32:                                           \
+      Append<uint32_t> (static_cast<uint32_t> (value));                 \
+      break;                                                            \
+    case BINARY_TRACE_INT32:                                            \
+      Append<int32_t> (static_cast<int32_t> (value));                   \
+      break;                                                            \
+    default:                                                            \
+      NS_FATAL_ERROR ("Numeric value for string column " << m_names[m_column]); \
+    }                                                                   \
+  return *this;
+
+BinaryTraceWriter &
+BinaryTraceWriter::operator << (double value)
+{
+  APPEND_NUMBER (value);
+}
+
+BinaryTraceWriter &
+BinaryTraceWriter::operator << (uint32_t value)
+{
+  APPEND_NUMBER (value);
+}
+
+BinaryTraceWriter &
+BinaryTraceWriter::operator << (int32_t value)
+{
+  APPEND_NUMBER (value);
+}
+
+BinaryTraceWriter &
+BinaryTraceWriter::operator << (const std::string &value)
+{
+  NS_ASSERT_MSG (m_column < m_types.size (), "Too many values in the record");
+  NS_ASSERT_MSG (m_types[m_column] == BINARY_TRACE_STRING,
+                 "String value for numeric column " << m_names[m_column]);
+
+  Append<uint32_t> (Intern (value));
+  return *this;
+}
+
+BinaryTraceWriter &
+BinaryTraceWriter::operator << (const char *value)
+{
+  return *this << std::string (value);
+}
+
+void
+BinaryTraceWriter::EndRecord ()
+{
+  NS_ASSERT_MSG (m_column == m_types.size (), "Not all values of the record are specified");
+
+  m_column = 0;
+  m_records ++;
+  if (m_records >= m_blockSize)
+    {
+      Flush ();
+    }
+}
+
+void
+BinaryTraceWriter::Flush ()
+{
+  NS_ASSERT_MSG (m_column == 0, "Cannot flush incomplete record");
+
+  for (std::vector<std::string>::iterator value = m_newStrings.begin ();
+       value != m_newStrings.end ();
+       value++)
+    {
+      Write (&BINARY_TRACE_CHUNK_STRING, sizeof (BINARY_TRACE_CHUNK_STRING));
+      WriteString (*value);
+    }
+  m_newStrings.clear ();
+
+  if (m_records == 0)
+    return;
+
+  Write (&BINARY_TRACE_CHUNK_BLOCK, sizeof (BINARY_TRACE_CHUNK_BLOCK));
+  Write (&m_records, sizeof (m_records));
+  for (std::vector< std::vector<char> >::iterator column = m_columns.begin ();
+       column != m_columns.end ();
+       column++)
+    {
+      Write (&(*column)[0], column->size ());
+      column->clear ();
+    }
+  m_records = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+BinaryTraceReader::BinaryTraceReader (const std::string &file)
+  : m_file (0)
+  , m_valid (false)
+{
+#ifdef NS3_NDNSIM_WITH_ZLIB
+  // zlib transparently reads both compressed and uncompressed files
+  m_file = gzopen (file.c_str (), "rb");
+#else
+  if (EndsWith (file, ".gz"))
+    {
+      NS_LOG_ERROR ("ndnSIM is compiled without zlib, compressed trace " << file << " cannot be read");
+      return;
+    }
+  m_file = std::fopen (file.c_str (), "rb");
+#endif
+
+  if (m_file != 0)
+    {
+      m_valid = ReadHeader ();
+    }
+}
+
+BinaryTraceReader::~BinaryTraceReader ()
+{
+  if (m_file == 0)
+    return;
+
+#ifdef NS3_NDNSIM_WITH_ZLIB
+  gzclose (static_cast<gzFile> (m_file));
+#else
+  std::fclose (static_cast<FILE*> (m_file));
+#endif
+}
+
+bool
+BinaryTraceReader::IsOpen () const
+{
+  return m_valid;
+}
+
+const std::string &
+BinaryTraceReader::GetType () const
+{
+  return m_type;
+}
+
+bool
+BinaryTraceReader::Read (void *buffer, uint32_t size)
+{
+  if (size == 0)
+    return true;
+
+#ifdef NS3_NDNSIM_WITH_ZLIB
+  return gzread (static_cast<gzFile> (m_file), buffer, size) == static_cast<int> (size);
+#else
+  return std::fread (buffer, 1, size, static_cast<FILE*> (m_file)) == size;
+#endif
+}
+
+bool
+BinaryTraceReader::ReadString (std::string &value)
+{
+  uint32_t size;
+  if (!Read (&size, sizeof (size)))
+    return false;
+
+  value.resize (size);
+  return size == 0 || Read (&value[0], size);
+}
+
+bool
+BinaryTraceReader::ReadHeader ()
+{
+  char magic[sizeof (BINARY_TRACE_MAGIC)];
+  uint32_t version;
+  if (!Read (magic, sizeof (magic)) ||
+      std::memcmp (magic, BINARY_TRACE_MAGIC, sizeof (magic)) != 0 ||
+      !Read (&version, sizeof (version)) ||
+      version != BINARY_TRACE_VERSION)
+    {
+      NS_LOG_ERROR ("Not a binary trace file (or unsupported version of the format)");
+      return false;
+    }
+
+  uint32_t columns;
+  if (!ReadString (m_type) ||
+      !ReadString (m_textHeader) ||
+      !Read (&columns, sizeof (columns)))
+    return false;
+
+  for (uint32_t i = 0; i < columns; i++)
+    {
+      uint8_t type;
+      std::string name;
+      if (!Read (&type, sizeof (type)) || !ReadString (name) || type > BINARY_TRACE_STRING)
+        return false;
+
+      m_types.push_back (static_cast<BinaryTraceColumnType> (type));
+    }
+
+  return true;
+}
+
+bool
+BinaryTraceReader::PrintText (std::ostream &os)
+{
+  if (!m_valid)
+    return false;
+
+  os << m_textHeader << "\n";
+
+  std::vector< std::vector<char> > columns (m_types.size ());
+  uint8_t chunk;
+  while (Read (&chunk, sizeof (chunk)))
+    {
+      if (chunk == BINARY_TRACE_CHUNK_STRING)
+        {
+          m_dictionary.push_back (std::string ());
+          if (!ReadString (m_dictionary.back ()))
+            return false;
+          continue;
+        }
+      else if (chunk != BINARY_TRACE_CHUNK_BLOCK)
+        return false;
+
+      uint32_t records;
+      if (!Read (&records, sizeof (records)))
+        return false;
+
+      for (uint32_t i = 0; i < m_types.size (); i++)
+        {
+          columns[i].resize (records * ColumnWidth (m_types[i]));
+          if (!Read (&columns[i][0], columns[i].size ()))
+            return false;
+        }
+
+      for (uint32_t record = 0; record < records; record++)
+        {
+          for (uint32_t i = 0; i < m_types.size (); i++)
+            {
+              if (i > 0)
+                os << "\t";
+
+              const char *value = &columns[i][record * ColumnWidth (m_types[i])];
+              switch (m_types[i])
+                {
+                case BINARY_TRACE_DOUBLE:
+                  {
+                    double number;
+                    std::memcpy (&number, value, sizeof (number));
+                    os << number;
+                    break;
+                  }
+                case BINARY_TRACE_UINT32:
+                  {
+                    uint32_t number;
+                    std::memcpy (&number, value, sizeof (number));
+                    os << number;
+                    break;
+                  }
+                case BINARY_TRACE_INT32:
+                  {
+                    int32_t number;
+                    std::memcpy (&number, value, sizeof (number));
+                    os << number;
+                    break;
+                  }
+                case BINARY_TRACE_STRING:
+                  {
+                    uint32_t id;
+                    std::memcpy (&id, value, sizeof (id));
+                    if (id >= m_dictionary.size ())
+                      return false;
+                    os << m_dictionary[id];
+                    break;
+                  }
+                }
+            }
+          os << "\n";
+        }
+    }
+
+  return true;
+}
+
+bool
+OpenTraceOutput (const std::string &file,
+                 boost::shared_ptr<std::ostream> &outputStream,
+                 boost::shared_ptr<BinaryTraceWriter> &writer)
+{
+  if (BinaryTraceWriter::IsBinaryTraceFile (file))
+    {
+      writer = boost::shared_ptr<BinaryTraceWriter> (new BinaryTraceWriter (file));
+      if (!writer->IsOpen ())
+        {
+          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+          return false;
+        }
+    }
+  else if (file != "-")
+    {
+      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
+      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+
+      if (!os->is_open ())
+        {
+          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+          return false;
+        }
+
+      outputStream = os;
+    }
+  else
+    {
+      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
+    }
+
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
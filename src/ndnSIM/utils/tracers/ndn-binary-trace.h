@@ -0,0 +1,273 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_BINARY_TRACE_H
+#define NDN_BINARY_TRACE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+
+#include <stdint.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Column types of the binary trace records
+ */
+enum BinaryTraceColumnType
+  {
+    BINARY_TRACE_DOUBLE = 0,
+    BINARY_TRACE_UINT32 = 1,
+    BINARY_TRACE_INT32  = 2,
+    BINARY_TRACE_STRING = 3 ///< @brief string, stored as an index in the dictionary of the file
+  };
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writer of binary (columnar) trace files, an alternative to the tab-separated text output of tracers
+ *
+ * The file starts with a header that defines the type of the trace, header line of the equivalent
+ * text trace, and schema of records (name and type of each column).  Records are buffered
+ * column by column and written in blocks of blockSize records.  Strings are written only once to
+ * the dictionary of the file and referenced by their index afterwards.  Values are written in
+ * the host byte order.
+ *
+ * If file name ends with ".gz", the whole file is compressed with zlib (if ndnSIM is compiled
+ * with zlib support).
+ *
+ * The binary trace can be converted to the text trace using BinaryTraceReader or ndn-trace-to-text tool.
+ */
+class BinaryTraceWriter
+{
+public:
+  /**
+   * @brief Check if traces should be written to the file in the binary format (i.e., if file
+   *        name ends with ".bin" or ".bin.gz")
+   */
+  static bool
+  IsBinaryTraceFile (const std::string &file);
+
+  /**
+   * @brief Check if ndnSIM is compiled with zlib, i.e., if compressed binary traces can be written
+   */
+  static bool
+  IsCompressionSupported ();
+
+  /**
+   * @brief Open the binary trace file for writing
+   *
+   * @param file Name of the file
+   * @param blockSize Number of records buffered before they are written to the file
+   */
+  BinaryTraceWriter (const std::string &file, uint32_t blockSize = 8192);
+
+  /**
+   * @brief Write all buffered records and close the file
+   */
+  ~BinaryTraceWriter ();
+
+  /**
+   * @brief Check if the file was successfully opened
+   */
+  bool
+  IsOpen () const;
+
+  /**
+   * @brief Add column to the schema of the records (should be called before WriteHeader)
+   */
+  void
+  AddColumn (const std::string &name, BinaryTraceColumnType type);
+
+  /**
+   * @brief Write header of the file
+   *
+   * @param type Name of the trace type (e.g., name of the tracer)
+   * @param textHeader Header line of the equivalent text trace
+   */
+  void
+  WriteHeader (const std::string &type, const std::string &textHeader);
+
+  /**
+   * @brief Get index of the string in the dictionary (string is added to the dictionary if necessary)
+   */
+  uint32_t
+  Intern (const std::string &value);
+
+  /**
+   * @brief Append value of the next column of the current record
+   *
+   * Numeric values are converted to the type of the column
+   */
+  BinaryTraceWriter &
+  operator << (double value);
+
+  BinaryTraceWriter &
+  operator << (uint32_t value);
+
+  BinaryTraceWriter &
+  operator << (int32_t value);
+
+  BinaryTraceWriter &
+  operator << (const std::string &value);
+
+  BinaryTraceWriter &
+  operator << (const char *value);
+
+  /**
+   * @brief Finish the current record (all columns should be already appended)
+   */
+  void
+  EndRecord ();
+
+  /**
+   * @brief Write all buffered records to the file
+   */
+  void
+  Flush ();
+
+private:
+  template<class T>
+  void
+  Append (const T &value);
+
+  void
+  Write (const void *buffer, uint32_t size);
+
+  void
+  WriteString (const std::string &value);
+
+private:
+  void *m_file;
+  bool m_compressed;
+
+  uint32_t m_blockSize;
+  uint32_t m_records;
+  uint32_t m_column;
+
+  std::vector<BinaryTraceColumnType> m_types;
+  std::vector<std::string> m_names;
+  std::vector< std::vector<char> > m_columns;
+
+  std::map<std::string, uint32_t> m_dictionary;
+  std::vector<std::string> m_newStrings; ///< @brief dictionary entries that are not yet written to the file
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of the binary trace files, written by BinaryTraceWriter
+ */
+class BinaryTraceReader
+{
+public:
+  /**
+   * @brief Open the binary trace file and read its header
+   */
+  BinaryTraceReader (const std::string &file);
+
+  ~BinaryTraceReader ();
+
+  /**
+   * @brief Check if the file was successfully opened and has a valid header
+   */
+  bool
+  IsOpen () const;
+
+  /**
+   * @brief Get name of the trace type
+   */
+  const std::string &
+  GetType () const;
+
+  /**
+   * @brief Write all records of the file in the layout of the equivalent text trace
+   *
+   * @returns false if the file is truncated or corrupted
+   */
+  bool
+  PrintText (std::ostream &os);
+
+private:
+  bool
+  Read (void *buffer, uint32_t size);
+
+  bool
+  ReadString (std::string &value);
+
+  bool
+  ReadHeader ();
+
+private:
+  void *m_file;
+  bool m_valid;
+
+  std::string m_type;
+  std::string m_textHeader;
+  std::vector<BinaryTraceColumnType> m_types;
+  std::vector<std::string> m_dictionary;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Open the output of a tracer in the format selected by the file name
+ *
+ * If the file name ends with ".bin" or ".bin.gz", a BinaryTraceWriter is created.  Otherwise, the file
+ * is opened as a text trace, or std::cout is used if the file name is "-".
+ *
+ * @param file Name of the file
+ * @param outputStream Set to the text output stream (if text trace is selected)
+ * @param writer Set to the binary trace writer (if binary trace is selected)
+ * @returns false if the file cannot be opened for writing
+ */
+bool
+OpenTraceOutput (const std::string &file,
+                 boost::shared_ptr<std::ostream> &outputStream,
+                 boost::shared_ptr<BinaryTraceWriter> &writer);
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Write header of the trace to the output opened by OpenTraceOutput
+ */
+template<class Tracer>
+void
+PrintTraceHeader (const Tracer &tracer,
+                  const boost::shared_ptr<std::ostream> &outputStream,
+                  const boost::shared_ptr<BinaryTraceWriter> &writer)
+{
+  if (writer)
+    {
+      tracer.PrintHeader (*writer);
+    }
+  else
+    {
+      tracer.PrintHeader (*outputStream);
+      *outputStream << "\n";
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_H
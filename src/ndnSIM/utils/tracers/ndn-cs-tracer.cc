@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cs-tracer.h"
+#include "ndn-binary-trace.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -33,10 +34,12 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/ndn-mpi-partition.h"
 
 #include <boost/lexical_cast.hpp>
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.CsTracer");
 
@@ -47,12 +50,6 @@ namespace ndn {
 
 static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<CsTracer> > > > g_tracers;
 
-template<class T>
-static inline void
-NullDeleter (T *ptr)
-{
-}
-
 void
 CsTracer::Destroy ()
 {
@@ -64,40 +61,29 @@ CsTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds
 {
   using namespace boost;
   using namespace std;
+  std::string traceFile = MpiPartition::GetFileName (file);
   
   std::list<Ptr<CsTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   for (NodeList::Iterator node = NodeList::Begin ();
        node != NodeList::End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<CsTracer> trace = Install (*node, outputStream, averagingPeriod);
+      trace->m_writer = writer;
       tracers.push_back (trace);
     }
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -109,39 +95,28 @@ CsTracer::Install (const NodeContainer &nodes, const std::string &file, Time ave
   using namespace boost;
   using namespace std;
 
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<CsTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   for (NodeContainer::Iterator node = nodes.Begin ();
        node != nodes.End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<CsTracer> trace = Install (*node, outputStream, averagingPeriod);
+      trace->m_writer = writer;
       tracers.push_back (trace);
     }
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -153,34 +128,23 @@ CsTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod
   using namespace boost;
   using namespace std;
 
+  if (!MpiPartition::IsLocal (node))
+    return; // node is simulated by another rank
+
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<CsTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   Ptr<CsTracer> trace = Install (node, outputStream, averagingPeriod);
+  trace->m_writer = writer;
   tracers.push_back (trace);
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -253,7 +217,14 @@ CsTracer::SetAveragingPeriod (const Time &period)
 void
 CsTracer::PeriodicPrinter ()
 {
-  Print (*m_os);
+  if (m_writer)
+    {
+      Print (*m_writer);
+    }
+  else
+    {
+      Print (*m_os);
+    }
   Reset ();
   
   m_printEvent = Simulator::Schedule (m_period, &CsTracer::PeriodicPrinter, this);
@@ -292,6 +263,35 @@ CsTracer::Print (std::ostream &os) const
   PRINTER ("CacheMisses", m_cacheMisses);
 }
 
+void
+CsTracer::PrintHeader (BinaryTraceWriter &writer) const
+{
+  writer.AddColumn ("Time",    BINARY_TRACE_DOUBLE);
+  writer.AddColumn ("Node",    BINARY_TRACE_STRING);
+  writer.AddColumn ("Type",    BINARY_TRACE_STRING);
+  writer.AddColumn ("Packets", BINARY_TRACE_DOUBLE);
+
+  std::ostringstream header;
+  PrintHeader (header);
+  writer.WriteHeader ("CsTracer", header.str ());
+}
+
+#define BINARY_PRINTER(printName, fieldName)            \
+  writer << time.ToDouble (Time::S)                     \
+         << m_node                                      \
+         << printName                                   \
+         << m_stats.fieldName;                          \
+  writer.EndRecord ();
+
+void
+CsTracer::Print (BinaryTraceWriter &writer) const
+{
+  Time time = Simulator::Now ();
+
+  BINARY_PRINTER ("CacheHits",   m_cacheHits);
+  BINARY_PRINTER ("CacheMisses", m_cacheMisses);
+}
+
 void 
 CsTracer::CacheHits (Ptr<const Interest>, Ptr<const Data>)
 {
@@ -42,6 +42,7 @@ namespace ndn {
 
 class Interest;
 class Data;
+class BinaryTraceWriter;
 
 typedef Interest InterestHeader;
 typedef Data DataHeader;
@@ -167,6 +168,22 @@ public:
    */
   void
   Print (std::ostream &os) const;
+
+  /**
+   * @brief Define columns and write header of the binary trace
+   *
+   * @param writer reference to the binary trace writer
+   */
+  void
+  PrintHeader (BinaryTraceWriter &writer) const;
+
+  /**
+   * @brief Write current trace data to the binary trace
+   *
+   * @param writer reference to the binary trace writer
+   */
+  void
+  Print (BinaryTraceWriter &writer) const;
   
 private:
   void
@@ -193,6 +210,7 @@ private:
   Ptr<Node> m_nodePtr;
 
   boost::shared_ptr<std::ostream> m_os;
+  boost::shared_ptr<BinaryTraceWriter> m_writer; ///< @brief if set, records are written in binary format instead of m_os
 
   Time m_period;
   EventId m_printEvent;
@@ -19,6 +19,7 @@
  */
 
 #include "ndn-l3-aggregate-tracer.h"
+#include "ndn-binary-trace.h"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -33,8 +34,11 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/ndn-mpi-partition.h"
+
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.L3AggregateTracer");
 
@@ -43,12 +47,6 @@ namespace ndn {
 
 static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<L3AggregateTracer> > > > g_tracers;
 
-template<class T>
-static inline void
-NullDeleter (T *ptr)
-{
-}
-
 void
 L3AggregateTracer::Destroy ()
 {
@@ -61,39 +59,28 @@ L3AggregateTracer::InstallAll (const std::string &file, Time averagingPeriod/* =
   using namespace boost;
   using namespace std;
 
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<L3AggregateTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   for (NodeList::Iterator node = NodeList::Begin ();
        node != NodeList::End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<L3AggregateTracer> trace = Install (*node, outputStream, averagingPeriod);
+      trace->m_writer = writer;
       tracers.push_back (trace);
     }
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -105,39 +92,28 @@ L3AggregateTracer::Install (const NodeContainer &nodes, const std::string &file,
   using namespace boost;
   using namespace std;
 
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<L3AggregateTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   for (NodeContainer::Iterator node = nodes.Begin ();
        node != nodes.End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<L3AggregateTracer> trace = Install (*node, outputStream, averagingPeriod);
+      trace->m_writer = writer;
       tracers.push_back (trace);
     }
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -149,34 +125,23 @@ L3AggregateTracer::Install (Ptr<Node> node, const std::string &file, Time averag
   using namespace boost;
   using namespace std;
 
+  if (!MpiPartition::IsLocal (node))
+    return; // node is simulated by another rank
+
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<L3AggregateTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  boost::shared_ptr<BinaryTraceWriter> writer;
+  if (!OpenTraceOutput (traceFile, outputStream, writer))
+    return;
 
   Ptr<L3AggregateTracer> trace = Install (node, outputStream, averagingPeriod);
+  trace->m_writer = writer;
   tracers.push_back (trace);
 
   if (tracers.size () > 0)
     {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      PrintTraceHeader (*tracers.front (), outputStream, writer);
     }
 
   g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -225,7 +190,14 @@ L3AggregateTracer::SetAveragingPeriod (const Time &period)
 void
 L3AggregateTracer::PeriodicPrinter ()
 {
-  Print (*m_os);
+  if (m_writer)
+    {
+      Print (*m_writer);
+    }
+  else
+    {
+      Print (*m_os);
+    }
   Reset ();
 
   m_printEvent = Simulator::Schedule (m_period, &L3AggregateTracer::PeriodicPrinter, this);
@@ -314,6 +286,77 @@ L3AggregateTracer::Print (std::ostream &os) const
   }
 }
 
+void
+L3AggregateTracer::PrintHeader (BinaryTraceWriter &writer) const
+{
+  writer.AddColumn ("Time",      BINARY_TRACE_DOUBLE);
+
+  writer.AddColumn ("Node",      BINARY_TRACE_STRING);
+  writer.AddColumn ("FaceId",    BINARY_TRACE_INT32);
+  writer.AddColumn ("FaceDescr", BINARY_TRACE_STRING);
+
+  writer.AddColumn ("Type",      BINARY_TRACE_STRING);
+  writer.AddColumn ("Packets",   BINARY_TRACE_DOUBLE);
+  writer.AddColumn ("Kilobytes", BINARY_TRACE_DOUBLE);
+
+  std::ostringstream header;
+  PrintHeader (header);
+  writer.WriteHeader ("L3AggregateTracer", header.str ());
+}
+
+#define BINARY_PRINTER(printName, fieldName)            \
+  writer << time.ToDouble (Time::S)                     \
+         << m_node                                      \
+         << faceId                                      \
+         << faceDescr                                   \
+         << printName                                   \
+         << STATS(0).fieldName                          \
+         << STATS(1).fieldName / 1024.0;                \
+  writer.EndRecord ();
+
+void
+L3AggregateTracer::Print (BinaryTraceWriter &writer) const
+{
+  Time time = Simulator::Now ();
+
+  for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats> >::iterator stats = m_stats.begin ();
+       stats != m_stats.end ();
+       stats++)
+    {
+      if (!stats->first)
+        continue;
+
+      int32_t faceId = stats->first->GetId ();
+      std::ostringstream os;
+      os << *stats->first;
+      std::string faceDescr = os.str ();
+
+      BINARY_PRINTER ("InInterests",   m_inInterests);
+      BINARY_PRINTER ("OutInterests",  m_outInterests);
+      BINARY_PRINTER ("DropInterests", m_dropInterests);
+
+      BINARY_PRINTER ("InNacks",   m_inNacks);
+      BINARY_PRINTER ("OutNacks",  m_outNacks);
+      BINARY_PRINTER ("DropNacks", m_dropNacks);
+
+      BINARY_PRINTER ("InData",   m_inData);
+      BINARY_PRINTER ("OutData",  m_outData);
+      BINARY_PRINTER ("DropData", m_dropData);
+    }
+
+  {
+    std::map<Ptr<const Face>, boost::tuple<Stats, Stats> >::iterator stats = m_stats.find (Ptr<const Face> (0));
+    if (stats != m_stats.end ())
+      {
+        int32_t faceId = -1;
+        std::string faceDescr = "all";
+
+        BINARY_PRINTER ("SatisfiedInterests", m_satisfiedInterests);
+        BINARY_PRINTER ("TimedOutInterests", m_timedOutInterests);
+      }
+  }
+}
+
 void
 L3AggregateTracer::OutInterests  (Ptr<const Interest> interest, Ptr<const Face> face)
 {
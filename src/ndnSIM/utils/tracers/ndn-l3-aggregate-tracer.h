@@ -35,6 +35,8 @@
 namespace ns3 {
 namespace ndn {
 
+class BinaryTraceWriter;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer tracer for aggregate packet counts
@@ -124,14 +126,27 @@ public:
   static Ptr<L3AggregateTracer>
   Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (0.5));
 
-protected:
   // from L3Tracer
   virtual void
   PrintHeader (std::ostream &os) const;
 
+  /**
+   * @brief Define columns and write header of the binary trace
+   */
+  void
+  PrintHeader (BinaryTraceWriter &writer) const;
+
+protected:
+  // from L3Tracer
   virtual void
   Print (std::ostream &os) const;
 
+  /**
+   * @brief Write current trace data to the binary trace
+   */
+  void
+  Print (BinaryTraceWriter &writer) const;
+
   virtual void
   OutInterests  (Ptr<const Interest>, Ptr<const Face>);
 
@@ -178,6 +193,7 @@ protected:
 
 protected:
   boost::shared_ptr<std::ostream> m_os;
+  boost::shared_ptr<BinaryTraceWriter> m_writer; ///< @brief if set, records are written in binary format instead of m_os
 
   Time m_period;
   EventId m_printEvent;
@@ -25,6 +25,7 @@
 #include "ns3/callback.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/ndn-mpi-partition.h"
 #include "ns3/node-list.h"
 
 #include "ns3/ndn-app.h"
@@ -61,16 +62,17 @@ L3RateTracer::Destroy ()
 void
 L3RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<L3RateTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
+  if (traceFile != "-")
     {
       boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      os->open (traceFile.c_str (), std::ios_base::out | std::ios_base::trunc);
 
       if (!os->is_open ())
         {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+          NS_LOG_ERROR ("File " << traceFile << " cannot be opened for writing. Tracing disabled");
           return;
         }
 
@@ -85,6 +87,9 @@ L3RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seco
        node != NodeList::End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
       tracers.push_back (trace);
     }
@@ -105,16 +110,17 @@ L3RateTracer::Install (const NodeContainer &nodes, const std::string &file, Time
   using namespace boost;
   using namespace std;
 
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<L3RateTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
+  if (traceFile != "-")
     {
       boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      os->open (traceFile.c_str (), std::ios_base::out | std::ios_base::trunc);
 
       if (!os->is_open ())
         {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+          NS_LOG_ERROR ("File " << traceFile << " cannot be opened for writing. Tracing disabled");
           return;
         }
 
@@ -129,6 +135,9 @@ L3RateTracer::Install (const NodeContainer &nodes, const std::string &file, Time
        node != nodes.End ();
        node++)
     {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
       Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
       tracers.push_back (trace);
     }
@@ -149,16 +158,20 @@ L3RateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPe
   using namespace boost;
   using namespace std;
 
+  if (!MpiPartition::IsLocal (node))
+    return; // node is simulated by another rank
+
+  std::string traceFile = MpiPartition::GetFileName (file);
   std::list<Ptr<L3RateTracer> > tracers;
   boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
+  if (traceFile != "-")
     {
       boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      os->open (traceFile.c_str (), std::ios_base::out | std::ios_base::trunc);
 
       if (!os->is_open ())
         {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+          NS_LOG_ERROR ("File " << traceFile << " cannot be opened for writing. Tracing disabled");
           return;
         }
 
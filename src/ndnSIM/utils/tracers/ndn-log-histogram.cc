@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-log-histogram.h"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+LogHistogram::LogHistogram (uint32_t precisionBits/* = 7*/)
+  : m_bits (precisionBits)
+  , m_count (0)
+  , m_sum (0)
+  , m_min (0)
+  , m_max (0)
+{
+  NS_ASSERT_MSG (precisionBits >= 1 && precisionBits < 32, "Invalid precision of the histogram");
+}
+
+uint32_t
+LogHistogram::GetIndex (uint64_t value) const
+{
+  uint64_t subBuckets = static_cast<uint64_t> (1) << m_bits;
+  if (value < subBuckets)
+    return value;
+
+  uint64_t halfBuckets = subBuckets >> 1;
+  uint32_t shift = 1;
+  while ((value >> shift) >= subBuckets)
+    shift ++;
+
+  return subBuckets + (shift - 1) * halfBuckets + ((value >> shift) - halfBuckets);
+}
+
+uint64_t
+LogHistogram::GetValue (uint32_t index) const
+{
+  uint64_t subBuckets = static_cast<uint64_t> (1) << m_bits;
+  if (index < subBuckets)
+    return index;
+
+  uint64_t halfBuckets = subBuckets >> 1;
+  uint32_t shift = (index - subBuckets) / halfBuckets + 1;
+  uint64_t mantissa = halfBuckets + (index - subBuckets) % halfBuckets;
+
+  // middle of the bucket
+  return (mantissa << shift) + ((static_cast<uint64_t> (1) << shift) >> 1);
+}
+
+void
+LogHistogram::Add (uint64_t value)
+{
+  uint32_t index = GetIndex (value);
+  if (index >= m_counts.size ())
+    {
+      m_counts.resize (index + 1, 0);
+    }
+
+  if (m_count == 0 || value < m_min)
+    m_min = value;
+  if (value > m_max)
+    m_max = value;
+
+  m_counts[index] ++;
+  m_count ++;
+  m_sum += value;
+}
+
+void
+LogHistogram::Reset ()
+{
+  std::fill (m_counts.begin (), m_counts.end (), 0);
+  m_count = 0;
+  m_sum = 0;
+  m_min = 0;
+  m_max = 0;
+}
+
+uint64_t
+LogHistogram::GetCount () const
+{
+  return m_count;
+}
+
+double
+LogHistogram::GetMean () const
+{
+  if (m_count == 0)
+    return 0;
+
+  return static_cast<double> (m_sum) / m_count;
+}
+
+uint64_t
+LogHistogram::GetMin () const
+{
+  return m_min;
+}
+
+uint64_t
+LogHistogram::GetMax () const
+{
+  return m_max;
+}
+
+uint64_t
+LogHistogram::GetPercentile (double percentile) const
+{
+  if (m_count == 0)
+    return 0;
+
+  uint64_t rank = static_cast<uint64_t> (std::ceil (percentile / 100.0 * m_count));
+  if (rank == 0)
+    rank = 1;
+
+  uint64_t seen = 0;
+  for (uint32_t index = 0; index < m_counts.size (); index++)
+    {
+      seen += m_counts[index];
+      if (seen >= rank)
+        {
+          return std::max (m_min, std::min (GetValue (index), m_max));
+        }
+    }
+
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_LOG_HISTOGRAM_H
+#define NDN_LOG_HISTOGRAM_H
+
+#include <vector>
+
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram with logarithmic buckets (similar to HdrHistogram), suitable for streaming
+ *        estimation of percentiles of values spanning several orders of magnitude (e.g., delays)
+ *
+ * Values smaller than 2^precisionBits are counted exactly.  Larger values are counted in buckets
+ * of 2^(precisionBits-1) linear sub-buckets per power of two, so the relative error of the
+ * reported percentiles does not exceed 2^-(precisionBits-1) (1.6% with the default precision).
+ * Memory is allocated only up to the bucket of the largest added value.
+ */
+class LogHistogram
+{
+public:
+  /**
+   * @brief Create histogram with the given precision
+   */
+  LogHistogram (uint32_t precisionBits = 7);
+
+  /**
+   * @brief Add value to the histogram
+   */
+  void
+  Add (uint64_t value);
+
+  /**
+   * @brief Remove all values from the histogram (allocated buckets are kept)
+   */
+  void
+  Reset ();
+
+  /**
+   * @brief Get number of values added to the histogram
+   */
+  uint64_t
+  GetCount () const;
+
+  /**
+   * @brief Get exact mean of the added values (0 if histogram is empty)
+   */
+  double
+  GetMean () const;
+
+  /**
+   * @brief Get exact minimum of the added values (0 if histogram is empty)
+   */
+  uint64_t
+  GetMin () const;
+
+  /**
+   * @brief Get exact maximum of the added values (0 if histogram is empty)
+   */
+  uint64_t
+  GetMax () const;
+
+  /**
+   * @brief Get estimation of the percentile
+   *
+   * @param percentile Percentile, from 0 to 100
+   * @returns value, such that at least percentile percents of the added values are less than or
+   *          equal to it (up to the precision of the histogram), 0 if histogram is empty
+   */
+  uint64_t
+  GetPercentile (double percentile) const;
+
+private:
+  uint32_t
+  GetIndex (uint64_t value) const;
+
+  uint64_t
+  GetValue (uint32_t index) const;
+
+private:
+  uint32_t m_bits;
+  std::vector<uint32_t> m_counts;
+
+  uint64_t m_count;
+  uint64_t m_sum;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOG_HISTOGRAM_H
@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-stats-tracer.h"
+#include "ns3/node.h"
+#include "ns3/config.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+
+#include "ns3/ndn-app.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+#include "ns3/ndn-content-store.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+#include "ns3/ndn-mpi-partition.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <cmath>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.StatsTracer");
+
+using namespace std;
+
+namespace ns3 {
+namespace ndn {
+
+static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<StatsTracer> > > > g_tracers;
+
+template<class T>
+static inline void
+NullDeleter (T *ptr)
+{
+}
+
+void
+StatsTracer::Destroy ()
+{
+  g_tracers.clear ();
+}
+
+void
+StatsTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (1.0)*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin ();
+       node != NodeList::End ();
+       node++)
+    {
+      nodes.Add (*node);
+    }
+
+  Install (nodes, file, averagingPeriod);
+}
+
+void
+StatsTracer::Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod/* = Seconds (1.0)*/)
+{
+  std::string traceFile = MpiPartition::GetFileName (file);
+  std::list<Ptr<StatsTracer> > tracers;
+  boost::shared_ptr<std::ostream> outputStream;
+  if (traceFile != "-")
+    {
+      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
+      os->open (traceFile.c_str (), std::ios_base::out | std::ios_base::trunc);
+
+      if (!os->is_open ())
+        {
+          NS_LOG_ERROR ("File " << traceFile << " cannot be opened for writing. Tracing disabled");
+          return;
+        }
+
+      outputStream = os;
+    }
+  else
+    {
+      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
+    }
+
+  for (NodeContainer::Iterator node = nodes.Begin ();
+       node != nodes.End ();
+       node++)
+    {
+      if (!MpiPartition::IsLocal (*node))
+        continue;
+
+      Ptr<StatsTracer> trace = Install (*node, outputStream, averagingPeriod);
+      tracers.push_back (trace);
+    }
+
+  if (tracers.size () > 0)
+    {
+      tracers.front ()->PrintHeader (*outputStream);
+      *outputStream << "\n";
+    }
+
+  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+}
+
+void
+StatsTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (1.0)*/)
+{
+  Install (NodeContainer (node), file, averagingPeriod);
+}
+
+Ptr<StatsTracer>
+StatsTracer::Install (Ptr<Node> node,
+                      boost::shared_ptr<std::ostream> outputStream,
+                      Time averagingPeriod/* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG ("Node: " << node->GetId ());
+
+  Ptr<StatsTracer> trace = Create<StatsTracer> (outputStream, node);
+  trace->SetAveragingPeriod (averagingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+StatsTracer::StatsTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr (node)
+  , m_os (os)
+  , m_cacheHits (0)
+  , m_cacheMisses (0)
+{
+  m_node = boost::lexical_cast<string> (m_nodePtr->GetId ());
+
+  Connect ();
+
+  string name = Names::FindName (node);
+  if (!name.empty ())
+    {
+      m_node = name;
+    }
+}
+
+StatsTracer::~StatsTracer ()
+{
+};
+
+void
+StatsTracer::Connect ()
+{
+  string node = boost::lexical_cast<string> (m_nodePtr->GetId ());
+  Config::ConnectWithoutContext ("/NodeList/"+node+"/ApplicationList/*/LastRetransmittedInterestDataDelay",
+                                 MakeCallback (&StatsTracer::LastRetransmittedInterestDataDelay, this));
+
+  Config::ConnectWithoutContext ("/NodeList/"+node+"/ApplicationList/*/FirstInterestDataDelay",
+                                 MakeCallback (&StatsTracer::FirstInterestDataDelay, this));
+
+  Ptr<ContentStore> cs = m_nodePtr->GetObject<ContentStore> ();
+  if (cs != 0)
+    {
+      cs->TraceConnectWithoutContext ("CacheHits",   MakeCallback (&StatsTracer::CacheHits,   this));
+      cs->TraceConnectWithoutContext ("CacheMisses", MakeCallback (&StatsTracer::CacheMisses, this));
+    }
+}
+
+void
+StatsTracer::SetAveragingPeriod (const Time &period)
+{
+  m_period = period;
+  m_printEvent.Cancel ();
+  m_printEvent = Simulator::Schedule (m_period, &StatsTracer::PeriodicPrinter, this);
+}
+
+void
+StatsTracer::PeriodicPrinter ()
+{
+  Print (*m_os);
+  Reset ();
+
+  m_printEvent = Simulator::Schedule (m_period, &StatsTracer::PeriodicPrinter, this);
+}
+
+void
+StatsTracer::Reset ()
+{
+  for (std::map<uint32_t, stats::AppStats>::iterator app = m_apps.begin ();
+       app != m_apps.end ();
+       app++)
+    {
+      app->second.Reset ();
+    }
+
+  m_cacheHits = 0;
+  m_cacheMisses = 0;
+}
+
+void
+StatsTracer::PrintHeader (std::ostream &os) const
+{
+  os << "Time" << "\t"
+     << "Node" << "\t"
+     << "AppId" << "\t"
+
+     << "Type" << "\t"
+     << "Samples" << "\t"
+     << "Mean" << "\t"
+     << "P50" << "\t"
+     << "P90" << "\t"
+     << "P99" << "\t"
+     << "Max";
+}
+
+static inline uint32_t
+HopCountPercentile (const std::vector<uint64_t> &hopCounts, uint64_t samples, double percentile)
+{
+  uint64_t rank = static_cast<uint64_t> (std::ceil (percentile / 100.0 * samples));
+  if (rank == 0)
+    rank = 1;
+
+  uint64_t seen = 0;
+  for (uint32_t hops = 0; hops < hopCounts.size (); hops++)
+    {
+      seen += hopCounts[hops];
+      if (seen >= rank)
+        return hops;
+    }
+  return hopCounts.size () - 1;
+}
+
+#define DELAY_PRINTER(printName, histogram)                             \
+  os << time.ToDouble (Time::S) << "\t"                                 \
+  << m_node << "\t"                                                     \
+  << app->first << "\t"                                                 \
+  << printName << "\t"                                                  \
+  << histogram.GetCount () << "\t"                                      \
+  << histogram.GetMean () / 1e9 << "\t"                                 \
+  << histogram.GetPercentile (50) / 1e9 << "\t"                         \
+  << histogram.GetPercentile (90) / 1e9 << "\t"                         \
+  << histogram.GetPercentile (99) / 1e9 << "\t"                         \
+  << histogram.GetMax () / 1e9 << "\n";
+
+void
+StatsTracer::Print (std::ostream &os) const
+{
+  Time time = Simulator::Now ();
+
+  for (std::map<uint32_t, stats::AppStats>::const_iterator app = m_apps.begin ();
+       app != m_apps.end ();
+       app++)
+    {
+      if (app->second.m_fullDelay.GetCount () == 0)
+        continue;
+
+      DELAY_PRINTER ("LastDelay", app->second.m_lastDelay);
+      DELAY_PRINTER ("FullDelay", app->second.m_fullDelay);
+
+      const std::vector<uint64_t> &hopCounts = app->second.m_hopCounts;
+      uint64_t samples = 0;
+      uint64_t sum = 0;
+      uint32_t max = 0;
+      for (uint32_t hops = 0; hops < hopCounts.size (); hops++)
+        {
+          samples += hopCounts[hops];
+          sum += hops * hopCounts[hops];
+          if (hopCounts[hops] > 0)
+            max = hops;
+        }
+
+      if (samples == 0)
+        continue;
+
+      os << time.ToDouble (Time::S) << "\t"
+         << m_node << "\t"
+         << app->first << "\t"
+         << "HopCount" << "\t"
+         << samples << "\t"
+         << static_cast<double> (sum) / samples << "\t"
+         << HopCountPercentile (hopCounts, samples, 50) << "\t"
+         << HopCountPercentile (hopCounts, samples, 90) << "\t"
+         << HopCountPercentile (hopCounts, samples, 99) << "\t"
+         << max << "\n";
+    }
+
+  if (m_nodePtr->GetObject<ContentStore> () != 0)
+    {
+      uint64_t lookups = m_cacheHits + m_cacheMisses;
+
+      os << time.ToDouble (Time::S) << "\t"
+         << m_node << "\t"
+         << "-1" << "\t"
+         << "CacheHitRatio" << "\t"
+         << lookups << "\t";
+      if (lookups > 0)
+        {
+          os << static_cast<double> (m_cacheHits) / lookups;
+        }
+      else
+        {
+          os << "NA";
+        }
+      os << "\tNA\tNA\tNA\tNA\n";
+    }
+}
+
+void
+StatsTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
+{
+  m_apps[app->GetId ()].m_lastDelay.Add (std::max<int64_t> (0, delay.GetNanoSeconds ()));
+}
+
+void
+StatsTracer::FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount)
+{
+  stats::AppStats &stats = m_apps[app->GetId ()];
+  stats.m_fullDelay.Add (std::max<int64_t> (0, delay.GetNanoSeconds ()));
+
+  if (hopCount >= 0)
+    {
+      if (static_cast<uint32_t> (hopCount) >= stats.m_hopCounts.size ())
+        {
+          stats.m_hopCounts.resize (hopCount + 1, 0);
+        }
+      stats.m_hopCounts[hopCount] ++;
+    }
+}
+
+void
+StatsTracer::CacheHits (Ptr<const Interest>, Ptr<const Data>)
+{
+  m_cacheHits ++;
+}
+
+void
+StatsTracer::CacheMisses (Ptr<const Interest>)
+{
+  m_cacheMisses ++;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_STATS_TRACER_H
+#define NDN_STATS_TRACER_H
+
+#include "ndn-log-histogram.h"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <map>
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class App;
+class Interest;
+class Data;
+
+namespace stats {
+
+/// @cond include_hidden
+struct AppStats
+{
+  inline void Reset ()
+  {
+    m_lastDelay.Reset ();
+    m_fullDelay.Reset ();
+    std::fill (m_hopCounts.begin (), m_hopCounts.end (), 0);
+  }
+
+  LogHistogram m_lastDelay; // in nanoseconds
+  LogHistogram m_fullDelay; // in nanoseconds
+  std::vector<uint64_t> m_hopCounts;
+};
+/// @endcond
+
+}
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer that keeps streaming statistics of application delays, hop counts, and cache
+ *        performance, writing only per-period summaries
+ *
+ * Unlike AppDelayTracer, which writes a record for every received Data packet, this tracer
+ * aggregates delays in log-bucketed histograms (LogHistogram) and hop counts in counters for
+ * each application of the node, and cache hits and misses for the node.  At the end of each
+ * period, only summaries are written:
+ *
+ * - LastDelay, FullDelay (seconds) and HopCount for each application with received Data packets;
+ * - CacheHitRatio for the node (AppId is -1, Samples is number of cache lookups).
+ *
+ * Percentiles of delays are estimated with relative error not exceeding 1.6%, percentiles of hop
+ * counts are exact.  Mean and Max values are always exact.
+ */
+class StatsTracer : public SimpleRefCount<StatsTracer>
+{
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every second)
+   */
+  static void
+  InstallAll (const std::string &file, Time averagingPeriod = Seconds (1.0));
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every second)
+   */
+  static void
+  Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod = Seconds (1.0));
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every second)
+   */
+  static void
+  Install (Ptr<Node> node, const std::string &file, Time averagingPeriod = Seconds (1.0));
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param outputStream Smart pointer to a stream
+   * @param averagingPeriod How often data will be written into the trace file (default, every second)
+   */
+  static Ptr<StatsTracer>
+  Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (1.0));
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy ();
+
+  /**
+   * @brief Trace constructor that attaches to all applications and the content store of the node
+   * @param os    reference to the output stream
+   * @param node  pointer to the node
+   */
+  StatsTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Destructor
+   */
+  ~StatsTracer ();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader (std::ostream &os) const;
+
+  /**
+   * @brief Print summaries of the current period
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print (std::ostream &os) const;
+
+private:
+  void
+  Connect ();
+
+  void
+  LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
+
+  void
+  FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount, int32_t hopCount);
+
+  void
+  CacheHits (Ptr<const Interest>, Ptr<const Data>);
+
+  void
+  CacheMisses (Ptr<const Interest>);
+
+private:
+  void
+  SetAveragingPeriod (const Time &period);
+
+  void
+  Reset ();
+
+  void
+  PeriodicPrinter ();
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+
+  boost::shared_ptr<std::ostream> m_os;
+
+  Time m_period;
+  EventId m_printEvent;
+
+  std::map<uint32_t, stats::AppStats> m_apps;
+  uint64_t m_cacheHits;
+  uint64_t m_cacheMisses;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_STATS_TRACER_H
@@ -0,0 +1,180 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef COUNT_MIN_SKETCH_H_
+#define COUNT_MIN_SKETCH_H_
+
+#include <boost/functional/hash.hpp>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Compact approximate frequency counter (count-min sketch with 4-bit counters and aging)
+ *
+ * Frequency of a key is estimated as the minimum of 4 counters, selected by different hashes of the
+ * key.  Counters saturate at 15.  After 10 * width increments all counters are halved, so
+ * the estimates reflect recent popularity rather than the whole history (frequencies are
+ * approximately "aged" by half every sample period).
+ */
+class count_min_sketch
+{
+public:
+  static const uint32_t depth = 4;
+  static const uint8_t max_count = 15;
+
+  count_min_sketch (size_t size = 16)
+  {
+    resize (size);
+  }
+
+  /**
+   * @brief Set width of the sketch (rounded up to the power of two) and reset all counters
+   *
+   * Width should be not less than the number of cached items
+   */
+  inline void
+  resize (size_t size)
+  {
+    width_ = 16;
+    while (width_ < size)
+      width_ <<= 1;
+
+    table_.assign (depth * width_ / 2, 0);
+    sample_size_ = 10 * width_;
+    additions_ = 0;
+  }
+
+  inline size_t
+  width () const
+  {
+    return width_;
+  }
+
+  /**
+   * @brief Increment frequency of the key (specified by its hash)
+   */
+  inline void
+  increment (size_t hash)
+  {
+    bool added = false;
+    for (uint32_t row = 0; row < depth; row++)
+      {
+        size_t counter = index (hash, row);
+        uint8_t shift = (counter & 1) << 2;
+        if (((table_[counter >> 1] >> shift) & 0x0F) < max_count)
+          {
+            table_[counter >> 1] += (1 << shift);
+            added = true;
+          }
+      }
+
+    if (added && ++additions_ >= sample_size_)
+      age ();
+  }
+
+  /**
+   * @brief Get estimated frequency of the key (specified by its hash)
+   */
+  inline uint8_t
+  estimate (size_t hash) const
+  {
+    uint8_t frequency = max_count;
+    for (uint32_t row = 0; row < depth; row++)
+      {
+        size_t counter = index (hash, row);
+        uint8_t count = (table_[counter >> 1] >> ((counter & 1) << 2)) & 0x0F;
+        if (count < frequency)
+          frequency = count;
+      }
+    return frequency;
+  }
+
+  /**
+   * @brief Reset all counters
+   */
+  inline void
+  clear ()
+  {
+    table_.assign (table_.size (), 0);
+    additions_ = 0;
+  }
+
+  /**
+   * @brief Get hash of the full key of trie node (the same as Name::getPrefixHash for NDN names)
+   */
+  template<class Trie>
+  static inline size_t
+  get_hash (const Trie *node)
+  {
+    size_t hash = 0;
+    if (node->parent () != 0)
+      {
+        hash = get_hash (node->parent ());
+        boost::hash_combine (hash, boost::hash_value (node->key ()));
+      }
+    return hash;
+  }
+
+private:
+  inline size_t
+  index (size_t hash, uint32_t row) const
+  {
+    size_t seed = row;
+    boost::hash_combine (seed, hash);
+
+    // murmur3 finalizer, to make row indexes independent
+    uint32_t h = static_cast<uint32_t> (seed);
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+
+    return row * width_ + (h & (width_ - 1));
+  }
+
+  inline void
+  age ()
+  {
+    for (std::vector<uint8_t>::iterator counters = table_.begin (); counters != table_.end (); counters++)
+      {
+        *counters = (*counters >> 1) & 0x77;
+      }
+    additions_ /= 2;
+  }
+
+private:
+  std::vector<uint8_t> table_; // two 4-bit counters per byte, depth rows of width_ counters
+  size_t width_;
+  size_t sample_size_;
+  size_t additions_;
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // COUNT_MIN_SKETCH_H_
@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef FREE_LIST_ALLOCATOR_H_
+#define FREE_LIST_ALLOCATOR_H_
+
+#include <new>
+#include <cstddef>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Allocation traits that recycle trie nodes and bucket arrays through free lists
+ *
+ * Memory for single objects and small arrays (up to max_pooled_size elements) is
+ * carved from slabs of slab_bytes bytes and, when released, is kept in per-size free
+ * lists instead of being returned to the heap.  Free lists are shared between all
+ * tries of the same type, so PIT entries that are created and pruned continuously
+ * reuse the same memory without going through malloc/free.
+ *
+ * Slabs are never returned to the system; memory is bounded by the peak number of
+ * simultaneously allocated nodes.  Not thread-safe (same as the rest of the simulator).
+ */
+struct free_list_allocator_traits
+{
+  static const size_t max_pooled_size = 64;
+  static const size_t slab_bytes = 8192;
+
+  template<class T>
+  class allocator
+  {
+  public:
+    static inline T*
+    allocate (size_t n)
+    {
+      if (n == 0 || n > max_pooled_size)
+        return static_cast<T*> (::operator new (n * sizeof (T)));
+
+      free_block *&head = s_freeLists [n];
+      if (head == 0)
+        refill (n);
+
+      free_block *block = head;
+      head = block->next;
+      return reinterpret_cast<T*> (block);
+    }
+
+    static inline void
+    deallocate (T *ptr, size_t n)
+    {
+      if (ptr == 0)
+        return;
+
+      if (n == 0 || n > max_pooled_size)
+        {
+          ::operator delete (ptr);
+          return;
+        }
+
+      free_block *block = reinterpret_cast<free_block*> (ptr);
+      block->next = s_freeLists [n];
+      s_freeLists [n] = block;
+    }
+
+  private:
+    struct free_block
+    {
+      free_block *next;
+    };
+
+    static inline size_t
+    block_size (size_t n)
+    {
+      size_t size = n * sizeof (T);
+      if (size < sizeof (free_block))
+        size = sizeof (free_block);
+
+      // keep blocks aligned for both T and free_block
+      const size_t align = sizeof (void*) > sizeof (double) ? sizeof (void*) : sizeof (double);
+      return (size + align - 1) / align * align;
+    }
+
+    static void
+    refill (size_t n)
+    {
+      size_t blockSize = block_size (n);
+      size_t blocks = slab_bytes / blockSize;
+      if (blocks == 0)
+        blocks = 1;
+
+      char *slab = static_cast<char*> (::operator new (blocks * blockSize));
+      for (size_t i = 0; i < blocks; i++)
+        {
+          free_block *block = reinterpret_cast<free_block*> (slab + i * blockSize);
+          block->next = s_freeLists [n];
+          s_freeLists [n] = block;
+        }
+    }
+
+  private:
+    // POD array, zero-initialized before any dynamic initialization and never destroyed
+    static free_block *s_freeLists [max_pooled_size + 1];
+  };
+};
+
+template<class T>
+typename free_list_allocator_traits::allocator<T>::free_block *
+free_list_allocator_traits::allocator<T>::s_freeLists [free_list_allocator_traits::max_pooled_size + 1];
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // FREE_LIST_ALLOCATOR_H_
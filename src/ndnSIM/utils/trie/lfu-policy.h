@@ -22,7 +22,7 @@
 #define LFU_POLICY_H_
 
 #include <boost/intrusive/options.hpp>
-#include <boost/intrusive/set.hpp>
+#include <boost/intrusive/list.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -30,13 +30,20 @@ namespace ndnSIM {
 
 /**
  * @brief Traits for LFU replacement policy
+ *
+ * Items are kept in a single list, ordered by the number of lookups (frequency) and, for the
+ * same frequency, by the time the item got this frequency.  Items with the same frequency form a
+ * group (bucket), and buckets are linked in the order of increasing frequency.  Therefore, all
+ * operations (insert, lookup, and erase) take constant time: on lookup, item is moved to the end
+ * of the next bucket (which is created if necessary), and the least frequently used item is
+ * always at the beginning of the list.
  */
 struct lfu_policy_traits
 {
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
   static std::string GetName () { return "Lfu"; }
 
-  struct policy_hook_type : public boost::intrusive::set_member_hook<> { double frequency; };
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { void *bucket; };
 
   template<class Container>
   struct container_hook
@@ -51,36 +58,59 @@ struct lfu_policy_traits
            class Hook>
   struct policy
   {
-    static double& get_order (typename Container::iterator item)
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    /**
+     * @brief Group of items with the same frequency
+     */
+    struct bucket : public boost::intrusive::list_base_hook<>
     {
-      return static_cast<policy_hook_type*>
-        (policy_container::value_traits::to_node_ptr(*item))->frequency;
-    }
+      bucket (uint64_t frequency)
+        : frequency_ (frequency)
+        , size_ (0)
+      {
+      }
+
+      uint64_t frequency_;
+      size_t size_;
+      typename policy_container::iterator last_; ///< @brief last item of the group in the policy container
+    };
 
-    static const double& get_order (typename Container::const_iterator item)
+    typedef boost::intrusive::list< bucket > buckets_container;
+
+    struct bucket_disposer
+    {
+      void operator () (bucket *group) const { delete group; }
+    };
+
+    static bucket *
+    get_bucket (typename Container::const_iterator item)
     {
-      return static_cast<const policy_hook_type*>
-        (policy_container::value_traits::to_node_ptr(*item))->frequency;
+      return static_cast<bucket*> (static_cast<const policy_hook_type*>
+                                   (policy_container::value_traits::to_node_ptr(*item))->bucket);
     }
 
-    template<class Key>
-    struct MemberHookLess
+    static void
+    set_bucket (typename Container::iterator item, bucket *group)
     {
-      bool operator () (const Key &a, const Key &b) const
-      {
-        return get_order (&a) < get_order (&b);
-      }
-    };
+      static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->bucket = group;
+    }
 
-    typedef boost::intrusive::multiset< Container,
-                                   boost::intrusive::compare< MemberHookLess< Container > >,
-                                   Hook > policy_container;
+    /**
+     * @brief Get number of lookups of the item since it has been inserted
+     */
+    static uint64_t
+    get_frequency (typename Container::const_iterator item)
+    {
+      return get_bucket (item)->frequency_;
+    }
 
     // could be just typedef
     class type : public policy_container
     {
     public:
-      typedef policy policy_base; // to get access to get_order methods from outside
+      typedef policy policy_base; // to get access to get_frequency methods from outside
       typedef Container parent_trie;
 
       type (Base &base)
@@ -89,47 +119,96 @@ struct lfu_policy_traits
       {
       }
 
+      ~type ()
+      {
+        buckets_.clear_and_dispose (bucket_disposer ());
+        spare_buckets_.clear_and_dispose (bucket_disposer ());
+      }
+
       inline void
       update (typename parent_trie::iterator item)
       {
-        policy_container::erase (policy_container::s_iterator_to (*item));
-        get_order (item) += 1;
-        policy_container::insert (*item);
+        lookup (item);
       }
 
       inline bool
       insert (typename parent_trie::iterator item)
       {
-        get_order (item) = 0;
-
         if (max_size_ != 0 && policy_container::size () >= max_size_)
           {
             // this erases the "least frequently used item" from cache
             base_.erase (&(*policy_container::begin ()));
           }
 
-        policy_container::insert (*item);
+        bucket *group;
+        typename policy_container::iterator position;
+        if (!buckets_.empty () && buckets_.front ().frequency_ == 0)
+          {
+            group = &buckets_.front ();
+            position = group->last_;
+            position ++;
+          }
+        else
+          {
+            group = new_bucket (0);
+            buckets_.push_front (*group);
+            position = policy_container::begin ();
+          }
+
+        group->last_ = policy_container::insert (position, *item);
+        group->size_ ++;
+        set_bucket (item, group);
         return true;
       }
 
       inline void
       lookup (typename parent_trie::iterator item)
       {
-        policy_container::erase (policy_container::s_iterator_to (*item));
-        get_order (item) += 1;
-        policy_container::insert (*item);
+        bucket *group = get_bucket (item);
+        typename buckets_container::iterator next = buckets_container::s_iterator_to (*group);
+        next ++;
+        bool hasNext = (next != buckets_.end () && next->frequency_ == group->frequency_ + 1);
+
+        if (group->size_ == 1 && !hasNext)
+          {
+            // the only item in the group, position in the list does not change
+            group->frequency_ ++;
+            return;
+          }
+
+        // new position is at the end of the next group, or just after the current group
+        typename policy_container::iterator position = hasNext ? next->last_ : group->last_;
+        position ++;
+
+        bucket *nextGroup;
+        if (hasNext)
+          {
+            nextGroup = &(*next);
+          }
+        else
+          {
+            nextGroup = new_bucket (group->frequency_ + 1);
+            buckets_.insert (next, *nextGroup);
+          }
+
+        remove (item, group);
+        nextGroup->last_ = policy_container::insert (position, *item);
+        nextGroup->size_ ++;
+        set_bucket (item, nextGroup);
       }
 
       inline void
       erase (typename parent_trie::iterator item)
       {
-        policy_container::erase (policy_container::s_iterator_to (*item));
+        remove (item, get_bucket (item));
       }
 
       inline void
       clear ()
       {
         policy_container::clear ();
+        buckets_.clear_and_dispose (bucket_disposer ());
+        spare_buckets_.clear_and_dispose (bucket_disposer ());
       }
 
       inline void
@@ -147,9 +226,42 @@ struct lfu_policy_traits
     private:
       type () : base_(*((Base*)0)) { };
 
+      inline void
+      remove (typename parent_trie::iterator item, bucket *group)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to (*item);
+        if (group->size_ > 1 && group->last_ == position)
+          {
+            group->last_ --;
+          }
+        group->size_ --;
+        policy_container::erase (position);
+
+        if (group->size_ == 0)
+          {
+            // keep empty bucket for reuse, as buckets are created and removed all the time
+            buckets_.erase (buckets_container::s_iterator_to (*group));
+            spare_buckets_.push_front (*group);
+          }
+      }
+
+      inline bucket *
+      new_bucket (uint64_t frequency)
+      {
+        if (spare_buckets_.empty ())
+          return new bucket (frequency);
+
+        bucket *group = &spare_buckets_.front ();
+        spare_buckets_.pop_front ();
+        group->frequency_ = frequency;
+        return group;
+      }
+
     private:
       Base &base_;
       size_t max_size_;
+      buckets_container buckets_;
+      buckets_container spare_buckets_;
     };
   };
 };
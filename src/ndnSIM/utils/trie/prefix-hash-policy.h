@@ -0,0 +1,463 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef PREFIX_HASH_POLICY_H_
+#define PREFIX_HASH_POLICY_H_
+
+#include <vector>
+#include <stdint.h>
+#include <boost/functional/hash.hpp>
+
+#include "ns3/ndn-name.h"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for policy that maintains flat index of full-prefix hashes
+ *
+ * The policy does not limit size of the container.  Instead, for every entry in
+ * the trie it records the entry under the incrementally computed hash of its full
+ * name, and increments counters for hashes of all prefixes of the name.  The
+ * resulting open-addressing table allows exact and longest prefix matches to be
+ * done as a sequence of hash probes, without walking the trie component by component.
+ *
+ * For ndn::Name keys, the hashes cached inside the name are used directly.
+ *
+ * Whenever the flat index cannot give a definite answer (hash collisions, or entries
+ * located deeper than the requested prefix), lookups fall back to the trie.
+ */
+struct prefix_hash_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "PrefixHash"; }
+  struct policy_hook_type { };
+
+  template<class Container>
+  struct container_hook
+  {
+    struct type { };
+  };
+
+  /**
+   * @brief Incremental hash of the name prefix, extended by one component
+   */
+  template<class Key>
+  static inline size_t
+  extend_hash (size_t prefixHash, const Key &component)
+  {
+    boost::hash_combine (prefixHash, boost::hash_value (component));
+    return prefixHash;
+  }
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    // could be just typedef
+    class type
+    {
+    public:
+      typedef Container parent_trie;
+      typedef typename parent_trie::iterator iterator;
+      typedef typename parent_trie::const_iterator const_iterator;
+
+      type (Base &base)
+        : base_ (base)
+        , size_ (0)
+        , used_ (0)
+        , table_ (initial_capacity)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        collect_hashes (item);
+        while ((used_ + hashes_.size ()) * 4 > table_.size () * 3)
+          rehash (table_.size () * 2);
+
+        for (size_t i = 0; i < hashes_.size (); i++)
+          {
+            slot &entry = find_or_create (hashes_[i]);
+            entry.prefixes ++;
+            if (i + 1 == hashes_.size ())
+              {
+                entry.exact ++;
+                entry.node = item;
+              }
+          }
+        size_ ++;
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        collect_hashes (item);
+        for (size_t i = 0; i < hashes_.size (); i++)
+          {
+            size_t pos = find_slot (hashes_[i]);
+            if (pos == npos)
+              continue; // should not happen
+
+            slot &entry = table_[pos];
+            entry.prefixes --;
+            if (i + 1 == hashes_.size ())
+              {
+                entry.exact --;
+                if (entry.node == item)
+                  entry.node = 0;
+              }
+
+            if (entry.prefixes == 0)
+              remove_slot (pos);
+          }
+        size_ --;
+      }
+
+      inline void
+      clear ()
+      {
+        table_.assign (initial_capacity, slot ());
+        size_ = 0;
+        used_ = 0;
+      }
+
+      inline void
+      set_max_size (size_t) {}
+
+      inline size_t
+      get_max_size () const { return 0; }
+
+      inline size_t
+      size () const { return size_; }
+
+      /**
+       * @brief Find entry with exactly the same name as the key
+       *
+       * Equivalent to trie_with_policy::find_exact
+       */
+      template<class FullKey>
+      inline iterator
+      find_exact (const FullKey &key)
+      {
+        size_t pos = find_slot (full_hash (key));
+        if (pos == npos)
+          return 0;
+
+        const slot &entry = table_[pos];
+        if (entry.exact == 0)
+          return 0;
+
+        if (entry.exact == 1 && entry.node != 0)
+          {
+            // if the key had an entry, it would have been counted in entry.exact
+            return is_same_name (entry.node, key) ? entry.node : 0;
+          }
+
+        return base_.find_exact (key); // collision, let the trie resolve it
+      }
+
+      /**
+       * @brief Longest prefix match for entries satisfying the predicate
+       *
+       * Equivalent to trie_with_policy::longest_prefix_match_if
+       */
+      template<class FullKey, class Predicate>
+      inline iterator
+      longest_prefix_match_if (const FullKey &key, Predicate pred)
+      {
+        prefix_hashes (key);
+        for (size_t i = hashes_.size (); i > 0; i--)
+          {
+            size_t pos = find_slot (hashes_[i-1]);
+            if (pos == npos)
+              continue;
+
+            const slot &entry = table_[pos];
+            if (entry.exact == 0)
+              continue;
+
+            if (entry.exact > 1 || entry.node == 0)
+              return base_.longest_prefix_match_if (key, pred); // collision, let the trie resolve it
+
+            if (!is_same_name (entry.node, key, i-1))
+              continue;
+
+            // same as in trie::find_if, predicate is not checked for the root node
+            if (i == 1 || pred (entry.node->payload ()))
+              {
+                base_.getPolicy ().lookup (entry.node);
+                return entry.node;
+              }
+          }
+
+        return 0;
+      }
+
+      /**
+       * @brief Find entry that has at least the key as a prefix
+       *
+       * Equivalent to trie_with_policy::deepest_prefix_match.  Exact matches and
+       * definite misses are resolved using the flat index only.
+       */
+      template<class FullKey>
+      inline iterator
+      deepest_prefix_match (const FullKey &key)
+      {
+        if (key.size () == 0)
+          return base_.deepest_prefix_match (key);
+
+        size_t pos = find_slot (full_hash (key));
+        if (pos == npos)
+          return 0; // no entries under the prefix
+
+        const slot &entry = table_[pos];
+        if (entry.exact == 1 && entry.node != 0 && is_same_name (entry.node, key))
+          {
+            base_.getPolicy ().lookup (entry.node);
+            return entry.node;
+          }
+
+        return base_.deepest_prefix_match (key);
+      }
+
+      /**
+       * @brief Check whether there is at least one entry with the key as a prefix
+       *
+       * May return true falsely in case of hash collisions, never returns false falsely
+       */
+      template<class FullKey>
+      inline bool
+      may_contain_prefix (const FullKey &key) const
+      {
+        if (key.size () == 0)
+          return size_ > 0;
+
+        return find_slot (full_hash (key)) != npos;
+      }
+
+    private:
+      static const size_t initial_capacity = 64;
+      static const size_t npos = static_cast<size_t> (-1);
+
+      struct slot
+      {
+        slot () : hash (0), prefixes (0), exact (0), node (0) { }
+
+        size_t hash;
+        uint32_t prefixes; ///< @brief number of entries that have this hash for one of their prefixes (0 means empty slot)
+        uint32_t exact;    ///< @brief number of entries that have this hash for their full name
+        iterator node;     ///< @brief (last) entry that has this hash for its full name
+      };
+
+      template<class FullKey>
+      static inline size_t
+      full_hash (const FullKey &key)
+      {
+        size_t hash = 0;
+        for (typename FullKey::const_iterator component = key.begin (); component != key.end (); component++)
+          {
+            hash = prefix_hash_policy_traits::extend_hash (hash, *component);
+          }
+        return hash;
+      }
+
+      // ndn::Name keeps prefix hashes (computed the same way as extend_hash)
+      static inline size_t
+      full_hash (const Name &key)
+      {
+        return key.getPrefixHash (key.size ());
+      }
+
+      // hashes_[i] = hash of the first i components
+      template<class FullKey>
+      inline void
+      prefix_hashes (const FullKey &key)
+      {
+        hashes_.resize (1);
+        hashes_[0] = 0;
+        for (typename FullKey::const_iterator component = key.begin (); component != key.end (); component++)
+          {
+            hashes_.push_back (prefix_hash_policy_traits::extend_hash (hashes_.back (), *component));
+          }
+      }
+
+      inline void
+      prefix_hashes (const Name &key)
+      {
+        hashes_.resize (key.size () + 1);
+        for (size_t i = 0; i <= key.size (); i++)
+          {
+            hashes_[i] = key.getPrefixHash (i);
+          }
+      }
+
+      // hashes_[i] = hash of the first i components of the name of trie node
+      inline void
+      collect_hashes (const_iterator item)
+      {
+        path_.clear ();
+        for (const_iterator node = item; node->parent () != 0; node = node->parent ())
+          {
+            path_.push_back (node);
+          }
+
+        hashes_.resize (1);
+        hashes_[0] = 0;
+        for (typename std::vector<const_iterator>::reverse_iterator node = path_.rbegin (); node != path_.rend (); node++)
+          {
+            hashes_.push_back (prefix_hash_policy_traits::extend_hash (hashes_.back (), (*node)->key ()));
+          }
+      }
+
+      // check that trie node corresponds to the first `length` components of the key
+      template<class FullKey>
+      static inline bool
+      is_same_name (const_iterator node, const FullKey &key, size_t length)
+      {
+        typename FullKey::const_iterator component = key.begin () + length;
+        for (; node->parent () != 0; node = node->parent ())
+          {
+            if (component == key.begin ())
+              return false;
+
+            component --;
+            if (!(node->key () == *component))
+              return false;
+          }
+        return component == key.begin ();
+      }
+
+      template<class FullKey>
+      static inline bool
+      is_same_name (const_iterator node, const FullKey &key)
+      {
+        return is_same_name (node, key, key.size ());
+      }
+
+      inline size_t
+      find_slot (size_t hash) const
+      {
+        size_t mask = table_.size () - 1;
+        for (size_t pos = hash & mask; ; pos = (pos + 1) & mask)
+          {
+            const slot &entry = table_[pos];
+            if (entry.prefixes == 0)
+              return npos;
+            if (entry.hash == hash)
+              return pos;
+          }
+      }
+
+      inline slot &
+      find_or_create (size_t hash)
+      {
+        size_t mask = table_.size () - 1;
+        for (size_t pos = hash & mask; ; pos = (pos + 1) & mask)
+          {
+            slot &entry = table_[pos];
+            if (entry.prefixes == 0)
+              {
+                entry.hash = hash;
+                used_ ++;
+                return entry;
+              }
+            if (entry.hash == hash)
+              return entry;
+          }
+      }
+
+      // backward-shift deletion for linear probing
+      inline void
+      remove_slot (size_t pos)
+      {
+        size_t mask = table_.size () - 1;
+        size_t hole = pos;
+        for (size_t next = (pos + 1) & mask; table_[next].prefixes != 0; next = (next + 1) & mask)
+          {
+            size_t home = table_[next].hash & mask;
+            // move entry into the hole, unless its home position is cyclically in (hole, next]
+            if ((next > hole && (home <= hole || home > next)) ||
+                (next < hole && (home <= hole && home > next)))
+              {
+                table_[hole] = table_[next];
+                hole = next;
+              }
+          }
+        table_[hole] = slot ();
+        used_ --;
+      }
+
+      inline void
+      rehash (size_t capacity)
+      {
+        std::vector<slot> old (capacity);
+        old.swap (table_);
+        used_ = 0;
+
+        for (typename std::vector<slot>::const_iterator entry = old.begin (); entry != old.end (); entry++)
+          {
+            if (entry->prefixes == 0)
+              continue;
+
+            slot &newEntry = find_or_create (entry->hash);
+            newEntry.prefixes = entry->prefixes;
+            newEntry.exact = entry->exact;
+            newEntry.node = entry->node;
+          }
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      size_t size_;
+      size_t used_;
+      std::vector<slot> table_;
+
+      // scratch buffers, to avoid allocations on every operation
+      std::vector<size_t> hashes_;
+      std::vector<const_iterator> path_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // PREFIX_HASH_POLICY_H_
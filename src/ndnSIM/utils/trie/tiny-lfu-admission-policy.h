@@ -0,0 +1,148 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef TINY_LFU_ADMISSION_POLICY_H_
+#define TINY_LFU_ADMISSION_POLICY_H_
+
+#include "detail/count-min-sketch.h"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for TinyLFU admission filter, to be combined with a replacement policy using multi_policy_traits
+ *
+ * Filter keeps approximate (aged) frequencies of inserted and looked up items in a count-min
+ * sketch.  When the cache is full, a new item is admitted only if its frequency is higher than
+ * the frequency of the item that would be evicted for it.  Otherwise, insertion fails and
+ * nothing is evicted, so items requested only once do not push popular items out of the cache.
+ *
+ * The replacement policy should be the first one and the filter should be the last one in the
+ * list of policies (e.g., multi_policy_traits< boost::mpl::vector2< lru_policy_traits,
+ * tiny_lfu_admission_policy_traits > >).  Insertion is done by the policies in the reverse
+ * order, so the decision is made before anything is evicted.  The replacement policy should
+ * evict its first item (as lru_policy_traits, fifo_policy_traits, lfu_policy_traits, and
+ * random_policy_traits do).
+ */
+struct tiny_lfu_admission_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "TinyLfu"; }
+
+  struct policy_hook_type { };
+
+  template<class Container>
+  struct container_hook
+  {
+    struct type { };
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    class type
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+        , sketch_ (max_size_)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        size_t hash = detail::count_min_sketch::get_hash (item);
+        sketch_.increment (hash);
+
+        if (max_size_ == 0 || base_.getPolicy ().size () < max_size_)
+          return true;
+
+        // the first item of the replacement policy is going to be evicted
+        typename parent_trie::iterator victim = &(*base_.getPolicy ().begin ());
+        return sketch_.estimate (hash) > sketch_.estimate (detail::count_min_sketch::get_hash (victim));
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        sketch_.increment (detail::count_min_sketch::get_hash (item));
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+      }
+
+      inline void
+      clear ()
+      {
+        sketch_.clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        sketch_.resize (max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+      /**
+       * @brief Get estimated (aged) frequency of the item
+       */
+      inline uint8_t
+      get_frequency (typename parent_trie::const_iterator item) const
+      {
+        return sketch_.estimate (detail::count_min_sketch::get_hash (item));
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      detail::count_min_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // TINY_LFU_ADMISSION_POLICY_H_
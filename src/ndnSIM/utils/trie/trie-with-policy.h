@@ -27,22 +27,30 @@ namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
+/**
+ * @brief Trie with attached replacement policy
+ *
+ * AllocatorTraits controls how trie nodes and their hash buckets are allocated
+ * (e.g., heap_allocator_traits or free_list_allocator_traits)
+ */
 template<typename FullKey,
          typename PayloadTraits,
-         typename PolicyTraits
+         typename PolicyTraits,
+         typename AllocatorTraits = heap_allocator_traits
          >
 class trie_with_policy
 {
 public:
   typedef trie< FullKey,
                 PayloadTraits,
-                typename PolicyTraits::policy_hook_type > parent_trie;
+                typename PolicyTraits::policy_hook_type,
+                AllocatorTraits > parent_trie;
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
   typedef typename PolicyTraits::template policy<
-    trie_with_policy<FullKey, PayloadTraits, PolicyTraits>,
+    trie_with_policy<FullKey, PayloadTraits, PolicyTraits, AllocatorTraits>,
     parent_trie,
     typename PolicyTraits::template container_hook<parent_trie>::type >::type policy_container;
 
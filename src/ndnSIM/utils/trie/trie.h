@@ -23,11 +23,13 @@
 
 #include "ns3/ptr.h"
 
+#include <new>
+#include <algorithm>
+
 #include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
@@ -99,28 +101,59 @@ template<typename Payload, typename BasePayload>
 Payload
 non_pointer_traits<Payload, BasePayload>::empty_payload = Payload ();
 
+/////////////////////////////////////////////////////
+// Allow customization for node and bucket allocation
+//
+
+/**
+ * @brief Default allocation traits for trie nodes and hash buckets (plain heap allocation)
+ *
+ * Allocator traits should define nested template `allocator<T>`, providing static
+ * `allocate (n)` and `deallocate (ptr, n)` functions.  Only raw memory is
+ * requested from the allocator, objects are constructed and destroyed by the trie itself.
+ */
+struct heap_allocator_traits
+{
+  template<class T>
+  struct allocator
+  {
+    static inline T*
+    allocate (size_t n)
+    {
+      return static_cast<T*> (::operator new (n * sizeof (T)));
+    }
+
+    static inline void
+    deallocate (T *ptr, size_t n)
+    {
+      ::operator delete (ptr);
+    }
+  };
+};
+
 
 ////////////////////////////////////////////////////
 // forward declarations
 //
 template<typename FullKey,
          typename PayloadTraits,
-         typename PolicyHook >
+         typename PolicyHook,
+         typename AllocatorTraits = heap_allocator_traits >
 class trie;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename AllocatorTraits>
 inline std::ostream&
 operator << (std::ostream &os,
-             const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+             const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &trie_node);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename AllocatorTraits>
 bool
-operator== (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-            const trie<FullKey, PayloadTraits, PolicyHook> &b);
+operator== (const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &a,
+            const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &b);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook >
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename AllocatorTraits>
 std::size_t
-hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+hash_value (const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &trie_node);
 
 ///////////////////////////////////////////////////
 // actual definition
@@ -133,7 +166,8 @@ class trie_point_iterator;
 
 template<typename FullKey,
 	 typename PayloadTraits,
-         typename PolicyHook >
+         typename PolicyHook,
+         typename AllocatorTraits >
 class trie
 {
 public:
@@ -149,6 +183,7 @@ public:
   typedef trie_point_iterator<const trie> const_point_iterator;
 
   typedef PayloadTraits payload_traits;
+  typedef AllocatorTraits allocator_traits;
 
   inline
   trie (const Key &key, size_t bucketSize = 1, size_t bucketIncrement = 1)
@@ -156,7 +191,7 @@ public:
     , initialBucketSize_ (bucketSize)
     , bucketIncrement_ (bucketIncrement)
     , bucketSize_ (initialBucketSize_)
-    , buckets_ (new bucket_type [bucketSize_]) //cannot use normal pointer, because lifetime of buckets should be larger than lifetime of the container
+    , buckets_ (bucketSize_) //cannot use normal pointer, because lifetime of buckets should be larger than lifetime of the container
     , children_ (bucket_traits (buckets_.get (), bucketSize_))
     , payload_ (PayloadTraits::empty_payload)
     , parent_ (0)
@@ -195,11 +230,11 @@ public:
 
   // actual entry
   friend bool
-  operator== <> (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-                 const trie<FullKey, PayloadTraits, PolicyHook> &b);
+  operator== <> (const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &a,
+                 const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &b);
 
   friend std::size_t
-  hash_value <> (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+  hash_value <> (const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &trie_node);
 
   inline std::pair<iterator, bool>
   insert (const FullKey &key,
@@ -209,30 +244,7 @@ public:
 
     BOOST_FOREACH (const Key &subkey, key)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
-        if (item == trieNode->children_.end ())
-          {
-            trie *newNode = new trie (subkey, initialBucketSize_, bucketIncrement_);
-            // std::cout << "new " << newNode << "\n";
-            newNode->parent_ = trieNode;
-
-            if (trieNode->children_.size () >= trieNode->bucketSize_)
-              {
-                trieNode->bucketSize_ += trieNode->bucketIncrement_;
-                trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-                buckets_array newBuckets (new bucket_type [trieNode->bucketSize_]);
-                trieNode->children_.rehash (bucket_traits (newBuckets.get (), trieNode->bucketSize_));
-                trieNode->buckets_.swap (newBuckets);
-              }
-
-            std::pair< typename unordered_set::iterator, bool > ret =
-              trieNode->children_.insert (*newNode);
-
-            trieNode = &(*ret.first);
-          }
-        else
-          trieNode = &(*item);
+        trieNode = trieNode->insert_child (subkey, initialBucketSize_, bucketIncrement_);
       }
 
     if (trieNode->payload_ == PayloadTraits::empty_payload)
@@ -244,6 +256,58 @@ public:
       return std::make_pair (trieNode, false);
   }
 
+  /**
+   * @brief Get direct child node with the key, creating it (with empty payload) if it doesn't exist
+   */
+  inline iterator
+  insert_child (const Key &subkey)
+  {
+    return insert_child (subkey, initialBucketSize_, bucketIncrement_);
+  }
+
+  /**
+   * @brief Same as insert_child (subkey), but a new node is created with the specified hash bucket parameters
+   */
+  inline iterator
+  insert_child (const Key &subkey, size_t bucketSize, size_t bucketIncrement)
+  {
+    typename unordered_set::iterator item = children_.find (subkey);
+    if (item != children_.end ())
+      return &(*item);
+
+    trie *newNode = create_node (subkey, bucketSize, bucketIncrement);
+    // std::cout << "new " << newNode << "\n";
+    newNode->parent_ = this;
+
+    if (children_.size () >= bucketSize_)
+      {
+        bucketSize_ += bucketIncrement_;
+        bucketIncrement_ *= 2; // increase bucketIncrement exponentially
+
+        buckets_array newBuckets (bucketSize_);
+        children_.rehash (bucket_traits (newBuckets.get (), bucketSize_));
+        buckets_.swap (newBuckets);
+      }
+
+    std::pair< typename unordered_set::iterator, bool > ret =
+      children_.insert (*newNode);
+
+    return &(*ret.first);
+  }
+
+  /**
+   * @brief Get direct child node with the key (0 if there is no such child)
+   */
+  inline iterator
+  find_child (const Key &subkey)
+  {
+    typename unordered_set::iterator item = children_.find (subkey);
+    if (item == children_.end ())
+      return 0;
+    else
+      return &(*item);
+  }
+
   /**
    * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
    */
@@ -375,7 +439,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+    typedef trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> trie;
     for (typename trie::unordered_set::iterator subnode = children_.begin ();
          subnode != children_.end ();
          subnode++ )
@@ -401,7 +465,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred (payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+    typedef trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> trie;
     for (typename trie::unordered_set::iterator subnode = children_.begin ();
          subnode != children_.end ();
          subnode++ )
@@ -427,7 +491,7 @@ public:
   inline const iterator
   find_if_next_level (Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+    typedef trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> trie;
     for (typename trie::unordered_set::iterator subnode = children_.begin ();
          subnode != children_.end ();
          subnode++ )
@@ -441,6 +505,34 @@ public:
     return 0;
   }
 
+  /**
+   * @brief Find next payload satisfying the payload predicate in sub-tries of the next
+   * level children, for which the key predicate is true
+   * @param pred predicate for keys of the next level children
+   * @param payloadPred predicate for payloads
+   *
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
+   */
+  template<class Predicate, class PayloadPredicate>
+  inline const iterator
+  find_if_next_level (Predicate pred, PayloadPredicate payloadPred)
+  {
+    typedef trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> trie;
+    for (typename trie::unordered_set::iterator subnode = children_.begin ();
+         subnode != children_.end ();
+         subnode++ )
+      {
+        if (pred (subnode->key ()))
+          {
+            iterator value = subnode->find_if (payloadPred);
+            if (value != 0)
+              return value;
+          }
+      }
+
+    return 0;
+  }
+
   iterator end ()
   {
     return 0;
@@ -469,30 +561,56 @@ public:
     payload_ = payload;
   }
 
-  Key key () const
+  const Key &
+  key () const
   {
     return key_;
   }
 
+  /**
+   * @brief Get parent node (0 for the root node)
+   */
+  const_iterator
+  parent () const
+  {
+    return parent_;
+  }
+
+  iterator
+  parent ()
+  {
+    return parent_;
+  }
+
   inline void
   PrintStat (std::ostream &os) const;
 
 private:
+  typedef typename AllocatorTraits::template allocator<trie> node_allocator;
+
+  static inline trie *
+  create_node (const Key &key, size_t bucketSize, size_t bucketIncrement)
+  {
+    trie *node = node_allocator::allocate (1);
+    try
+      {
+        new (node) trie (key, bucketSize, bucketIncrement);
+      }
+    catch (...)
+      {
+        node_allocator::deallocate (node, 1);
+        throw;
+      }
+    return node;
+  }
+
   //The disposer object function
   struct trie_delete_disposer
   {
     void operator() (trie *delete_this)
     {
-      delete delete_this;
-    }
-  };
-
-  template<class D>
-  struct array_disposer
-  {
-    void operator() (D *array)
-    {
-      delete [] array;
+      delete_this->~trie ();
+      node_allocator::deallocate (delete_this, 1);
     }
   };
 
@@ -516,6 +634,52 @@ private:
   typedef typename unordered_set::bucket_type   bucket_type;
   typedef typename unordered_set::bucket_traits bucket_traits;
 
+  /**
+   * @brief Owner of the bucket array, allocated through AllocatorTraits
+   */
+  class buckets_array
+  {
+  public:
+    typedef typename AllocatorTraits::template allocator<bucket_type> bucket_allocator;
+
+    explicit
+    buckets_array (size_t size)
+      : size_ (size)
+      , buckets_ (bucket_allocator::allocate (size))
+    {
+      for (size_t i = 0; i < size_; i++)
+        new (buckets_ + i) bucket_type ();
+    }
+
+    ~buckets_array ()
+    {
+      for (size_t i = 0; i < size_; i++)
+        buckets_[i].~bucket_type ();
+      bucket_allocator::deallocate (buckets_, size_);
+    }
+
+    bucket_type *
+    get () const
+    {
+      return buckets_;
+    }
+
+    void
+    swap (buckets_array &other)
+    {
+      std::swap (size_, other.size_);
+      std::swap (buckets_, other.buckets_);
+    }
+
+  private:
+    buckets_array (const buckets_array &);
+    buckets_array &operator= (const buckets_array &);
+
+  private:
+    size_t size_;
+    bucket_type *buckets_;
+  };
+
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -532,7 +696,6 @@ private:
   size_t bucketIncrement_;
 
   size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr< bucket_type, array_disposer<bucket_type> > buckets_array;
   buckets_array buckets_;
   unordered_set children_;
 
@@ -543,12 +706,12 @@ private:
 
 
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename AllocatorTraits>
 inline std::ostream&
-operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
+operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &trie_node)
 {
   os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << std::endl;
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> trie;
 
   for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin ();
        subnode != trie_node.children_.end ();
@@ -565,9 +728,9 @@ operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook> &t
   return os;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename AllocatorTraits>
 inline void
-trie<FullKey, PayloadTraits, PolicyHook>
+trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits>
 ::PrintStat (std::ostream &os) const
 {
   os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << children_.size() << " children" << std::endl;
@@ -579,7 +742,7 @@ trie<FullKey, PayloadTraits, PolicyHook>
     }
   os << "\n";
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> trie;
   for (typename trie::unordered_set::const_iterator subnode = children_.begin ();
        subnode != children_.end ();
        subnode++ )
@@ -590,17 +753,17 @@ trie<FullKey, PayloadTraits, PolicyHook>
 }
 
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename AllocatorTraits>
 inline bool
-operator == (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-             const trie<FullKey, PayloadTraits, PolicyHook> &b)
+operator == (const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &a,
+             const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &b)
 {
   return a.key_ == b.key_;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename AllocatorTraits>
 inline std::size_t
-hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
+hash_value (const trie<FullKey, PayloadTraits, PolicyHook, AllocatorTraits> &trie_node)
 {
   return boost::hash_value (trie_node.key_);
 }
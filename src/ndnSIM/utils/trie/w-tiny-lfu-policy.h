@@ -0,0 +1,268 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef W_TINY_LFU_POLICY_H_
+#define W_TINY_LFU_POLICY_H_
+
+#include "detail/count-min-sketch.h"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for W-TinyLFU replacement policy
+ *
+ * New items are placed into a small LRU window (1% of the cache).  Items leaving the window
+ * become candidates for the main part of the cache, which uses segmented LRU: items that have
+ * been looked up in the main part are moved to the protected segment (80% of the main part),
+ * the others stay in the probation segment.  When the main part is full, TinyLFU filter decides
+ * whether the candidate or the first item of the probation segment should be evicted, based on
+ * their approximate frequencies kept in a count-min sketch (see detail::count_min_sketch).
+ *
+ * All items are kept in one list: probation segment, protected segment, and window (each in the
+ * LRU order), so the first item is always the next candidate for eviction from the main part.
+ */
+struct w_tiny_lfu_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "WTinyLfu"; }
+
+  enum segment_type { PROBATION = 0, PROTECTED = 1, WINDOW = 2 };
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { uint8_t segment; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    static uint8_t& get_segment (typename Container::iterator item)
+    {
+      return static_cast<typename policy_container::value_traits::hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->segment;
+    }
+
+    static const uint8_t& get_segment (typename Container::const_iterator item)
+    {
+      return static_cast<const typename policy_container::value_traits::hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->segment;
+    }
+
+    class type : public policy_container
+    {
+    public:
+      typedef policy policy_base; // to get access to get_segment methods from outside
+      typedef Container parent_trie;
+      typedef typename policy_container::iterator iterator;
+
+      type (Base &base)
+        : base_ (base)
+        , protected_begin_ (policy_container::end ())
+        , window_begin_ (policy_container::end ())
+        , protected_size_ (0)
+        , window_size_ (0)
+      {
+        set_max_size (100);
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        sketch_.increment (detail::count_min_sketch::get_hash (item));
+
+        link (policy_container::end (), *item, WINDOW);
+        if (max_size_ == 0 || window_size_ <= max_window_size_)
+          return true;
+
+        // the oldest item of the window becomes a candidate for the main part
+        iterator candidate = window_begin_;
+        unlink (candidate);
+        link (protected_begin_, *candidate, PROBATION);
+
+        if (policy_container::size () - window_size_ > max_main_size_)
+          {
+            iterator victim = policy_container::begin ();
+            if (victim != candidate &&
+                sketch_.estimate (detail::count_min_sketch::get_hash (&(*candidate))) >
+                sketch_.estimate (detail::count_min_sketch::get_hash (&(*victim))))
+              {
+                base_.erase (&(*victim));
+              }
+            else
+              {
+                base_.erase (&(*candidate));
+              }
+          }
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        sketch_.increment (detail::count_min_sketch::get_hash (item));
+
+        iterator position = policy_container::s_iterator_to (*item);
+        switch (get_segment (item))
+          {
+          case WINDOW:
+            unlink (position);
+            link (policy_container::end (), *item, WINDOW);
+            break;
+
+          case PROBATION:
+          case PROTECTED:
+            unlink (position);
+            link (window_begin_, *item, PROTECTED);
+
+            if (max_size_ != 0 && protected_size_ > max_protected_size_)
+              {
+                // the oldest protected item goes back to probation
+                iterator demoted = protected_begin_;
+                unlink (demoted);
+                link (protected_begin_, *demoted, PROBATION);
+              }
+            break;
+          }
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        unlink (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        protected_begin_ = window_begin_ = policy_container::end ();
+        protected_size_ = window_size_ = 0;
+        sketch_.clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        max_window_size_ = std::max<size_t> (max_size_ / 100, 1);
+        max_main_size_ = (max_size_ > max_window_size_) ? max_size_ - max_window_size_ : 0;
+        max_protected_size_ = max_main_size_ * 4 / 5;
+
+        sketch_.resize (max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      /**
+       * @brief Put item before position (i.e., at the end of the segment that ends at position)
+       *
+       * Beginning of the segment and beginnings of the preceding empty segments (which are equal
+       * to position) are moved to the item
+       */
+      inline void
+      link (iterator position, Container &item, uint8_t segment)
+      {
+        get_segment (&item) = segment;
+        iterator inserted = policy_container::insert (position, item);
+
+        if (segment >= PROTECTED && protected_begin_ == position)
+          protected_begin_ = inserted;
+        if (segment >= WINDOW && window_begin_ == position)
+          window_begin_ = inserted;
+
+        if (segment == PROTECTED)
+          protected_size_ ++;
+        else if (segment == WINDOW)
+          window_size_ ++;
+      }
+
+      /**
+       * @brief Remove item from the list, moving beginnings of the segments that start at the item
+       */
+      inline void
+      unlink (iterator position)
+      {
+        iterator next = position;
+        next++;
+
+        if (protected_begin_ == position)
+          protected_begin_ = next;
+        if (window_begin_ == position)
+          window_begin_ = next;
+
+        uint8_t segment = get_segment (&(*position));
+        if (segment == PROTECTED)
+          protected_size_ --;
+        else if (segment == WINDOW)
+          window_size_ --;
+
+        policy_container::erase (position);
+      }
+
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      size_t max_window_size_;
+      size_t max_main_size_;
+      size_t max_protected_size_;
+
+      iterator protected_begin_; // first item of protected segment (window_begin_ if segment is empty)
+      iterator window_begin_;    // first item of window (end () if window is empty)
+      size_t protected_size_;
+      size_t window_size_;
+
+      detail::count_min_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // W_TINY_LFU_POLICY_H_